@@ -24,6 +24,8 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <dirent.h>
 #include <fcntl.h>
 #include <getopt.h>
 #include <stdio.h>
@@ -31,82 +33,21 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdlib.h>
-#include <stdarg.h>
-#include <time.h>
 #include <ctype.h>
-#include <math.h>
+#include <pthread.h>
 
-#define ARRAY_SIZE(x) (sizeof(x) / sizeof(*(x)))
-#define min(a, b) ((a) < (b) ? (a) : (b))
-#define max(a, b) ((a) > (b) ? (a) : (b))
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#define HAVE_AVX2
+#include <immintrin.h>
+#endif
 
-enum {
-	EDID_PAGE_SIZE = 128u
-};
+#include "libedid-decode.h"
+
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(*(x)))
 
-static int edid_minor = 0;
-static int claims_one_point_oh = 0;
-static int claims_one_point_two = 0;
-static int claims_one_point_three = 0;
-static int claims_one_point_four = 0;
-static int nonconformant_digital_display = 0;
-static int nonconformant_extension = 0;
-static int did_detailed_timing = 0;
-static int has_name_descriptor = 0;
-static int has_serial_string = 0;
-static int has_ascii_string = 0;
-static int has_range_descriptor = 0;
-static int has_preferred_timing = 0;
-static int has_valid_checksum = 1;
-static int has_valid_cta_checksum = 1;
-static int has_valid_displayid_checksum = 1;
-static int has_valid_cvt = 1;
-static int has_valid_dummy_block = 1;
-static int has_valid_serial_number = 0;
-static int has_valid_serial_string = 0;
-static int has_valid_ascii_string = 0;
-static int has_valid_name_descriptor = 0;
-static int has_valid_week = 0;
-static int has_valid_year = 0;
-static int has_valid_detailed_blocks = 0;
-static int has_valid_descriptor_ordering = 1;
-static int has_valid_descriptor_pad = 1;
-static int has_valid_range_descriptor = 1;
-static int has_valid_max_dotclock = 1;
-static int has_valid_string_termination = 1;
-static int empty_string = 0;
-static int trailing_space = 0;
-static int has_cta861 = 0;
-static int has_640x480p60_est_timing = 0;
-static int has_cta861_vic_1 = 0;
-static int manufacturer_name_well_formed = 0;
-static int seen_non_detailed_descriptor = 0;
-
-static int warning_excessive_dotclock_correction = 0;
-static int warning_zero_preferred_refresh = 0;
-static int nonconformant_hf_vsdb_position = 0;
-static int duplicate_scdb = 0;
-static int nonconformant_srgb_chromaticity = 0;
-static int nonconformant_cta861_640x480 = 0;
-static int nonconformant_hdmi_vsdb_tmds_rate = 0;
-static int nonconformant_hf_vsdb_tmds_rate = 0;
-static int nonconformant_hf_eeodb = 0;
-
-static int min_hor_freq_hz = 0xfffffff;
-static int max_hor_freq_hz = 0;
-static int min_vert_freq_hz = 0xfffffff;
-static int max_vert_freq_hz = 0;
-static int max_pixclk_khz = 0;
-static int mon_min_hor_freq_hz = 0;
-static int mon_max_hor_freq_hz = 0;
-static int mon_min_vert_freq_hz = 0;
-static int mon_max_vert_freq_hz = 0;
-static int mon_max_pixclk_khz = 0;
-static unsigned supported_hdmi_vic_codes = 0;
-static unsigned supported_hdmi_vic_vsb_codes = 0;
-
-static int conformant = 1;
-static unsigned warnings;
 
 enum output_format {
 	OUT_FMT_DEFAULT,
@@ -121,10 +62,20 @@ enum output_format {
  * That makes it easier to see which options are still free.
  */
 enum Option {
+	OptCheckRules = 'C',
+	OptFailFast = 'F',
+	OptOutput = 'O',
+	OptSupports = 'S',
+	OptBatch = 'b',
 	OptCheck = 'c',
 	OptExtract = 'e',
 	OptHelp = 'h',
+	OptJobs = 'j',
+	OptLog = 'l',
 	OptOutputFormat = 'o',
+	OptQuiet = 'q',
+	OptSummary = 's',
+	OptCarve = 'x',
 	OptLast = 256
 };
 
@@ -135,12 +86,42 @@ static struct option long_options[] = {
 	{ "output-format", required_argument, 0, OptOutputFormat },
 	{ "extract", no_argument, 0, OptExtract },
 	{ "check", no_argument, 0, OptCheck },
+	{ "check-rules", required_argument, 0, OptCheckRules },
+	{ "fail-fast", no_argument, 0, OptFailFast },
+	{ "batch", no_argument, 0, OptBatch },
+	{ "jobs", required_argument, 0, OptJobs },
+	{ "output", required_argument, 0, OptOutput },
+	{ "quiet", no_argument, 0, OptQuiet },
+	{ "summary", no_argument, 0, OptSummary },
+	{ "supports", required_argument, 0, OptSupports },
+	{ "carve", no_argument, 0, OptCarve },
+	{ "log", no_argument, 0, OptLog },
 	{ 0, 0, 0, 0 }
 };
 
+/* formats selected with --output, in the order given */
+static int output_text = 1;
+static enum edid_output outputs[16];
+static unsigned num_outputs;
+
+/* conformance rules selected with --check-rules */
+static uint16_t check_codes[64];
+static unsigned num_check_codes;
+
+/* modes asked about with --supports */
+struct supports_query {
+	const char *arg;
+	unsigned width, height, refresh;
+	unsigned flags;		/* EDID_SUPPORTS_* */
+};
+static struct supports_query queries[16];
+static unsigned num_queries;
+
 static void usage(void)
 {
 	printf("Usage: edid-decode <options> [in [out]]\n"
+	       "       edid-decode --batch <options> [in ...]\n"
+	       "       edid-decode --jobs=<n> <options> [in ...]\n"
 	       "  [in]                  EDID file to parse. Read from standard input if none given\n"
 	       "                        or if the input filename is '-'.\n"
 	       "  [out]                 Output the read EDID to this file. Write to standard output\n"
@@ -152,3488 +133,1776 @@ static void usage(void)
 	       "                        hex:    hex numbers in ascii text (default for stdout)\n"
 	       "                        raw:    binary data (default unless writing to stdout)\n"
 	       "                        carray: c-program struct\n"
+	       "  -O, --output=<fmt>[,<fmt>...]\n"
+	       "                        write the decoded EDID in these formats (default text).\n"
+	       "                        The text output, if selected, always comes first.\n"
+	       "                        <fmt> is one of:\n"
+	       "                        text:     the full decoded EDID\n"
+	       "                        timings:  a modeline per detailed timing\n"
+	       "                        findings: a line per conformance issue (implies --check)\n"
+	       "                        json:     a JSON document per EDID. With --batch and\n"
+	       "                        only json output, the result is NDJSON\n"
+	       "                        codes:    a line per EDID with its source, pass or fail\n"
+	       "                                  and the codes of its findings (implies --check)\n"
+	       "  -b, --batch           decode every [in] file or directory, or every file listed\n"
+	       "                        on standard input if none are given, framing each decode\n"
+	       "                        with its file name and exit status\n"
 	       "  -c, --check           check if the EDID conforms to the standards\n"
+	       "  -C, --check-rules=<code>[,<code>...]\n"
+	       "                        only check the conformance rules with these finding\n"
+	       "                        codes (see enum edid_finding_code); implies --check\n"
+	       "  -F, --fail-fast       stop checking at the first issue that makes the EDID\n"
+	       "                        nonconformant; implies --check\n"
 	       "  -e, --extract         extract the contents of the first block in hex values\n"
-	       "  -h, --help            display this help message\n");
+	       "  -h, --help            display this help message\n"
+	       "  -j, --jobs=<n>        like --batch, but decode with <n> threads in parallel.\n"
+	       "                        The output is identical to that of --batch\n"
+	       "  -l, --log             read [in] as an Xorg or kernel log of any size and decode\n"
+	       "                        every EDID dump in it as it is found, named after the\n"
+	       "                        line it starts at\n"
+	       "  -q, --quiet           check the EDID without writing the decoded EDID; the exit\n"
+	       "                        status tells if it conforms. Add -O codes for a line\n"
+	       "                        with the finding codes\n"
+	       "  -s, --summary         only write the manufacturer, product, serial number,\n"
+	       "                        date, monitor name and preferred timing, without\n"
+	       "                        decoding the rest of the EDID\n"
+	       "  -S, --supports=<w>x<h>@<hz>[,i][,420]\n"
+	       "                        only tell if the display supports this mode,\n"
+	       "                        interlaced (i) or in YCbCr 4:2:0 (420), as one of\n"
+	       "                        its modes or within its range limits. May be given\n"
+	       "                        several times; the exit status is 1 if any mode is\n"
+	       "                        not supported\n"
+	       "  -x, --carve           scan [in], e.g. a firmware image or a memory dump, for\n"
+	       "                        EDIDs with a valid checksum and decode each one found,\n"
+	       "                        named after its offset. If [out] is specified, all\n"
+	       "                        EDIDs found are written to it\n");
 }
 
-struct value {
-	int value;
-	const char *description;
+/* An EDID found in the input */
+struct edid_entry {
+	const unsigned char *edid;
+	unsigned size;
+	const char *name;	/* e.g. the xrandr output, not NUL terminated */
+	int name_len;
+	unsigned long line;	/* where a log has it, if there is no name */
 };
 
-struct field {
-	const char *name;
-	int start, end;
-	struct value *values;
-	int n_values;
+/*
+ * An input file and the EDIDs extracted from it. Regular files are mapped
+ * rather than read, and a raw binary EDID is then decoded in place.
+ */
+struct edid_input {
+	char *data;		/* the input, followed by a NUL byte */
+	size_t len;
+	size_t map_len;		/* size of the mapping, 0 if data was read */
+	unsigned char *alloc;	/* EDIDs converted from text */
+	unsigned num_edids;
+	struct edid_entry *edids;
+	struct edid_entry one;	/* edids[0] if there is only one */
 };
 
-static const char *cur_block;
-static char *s_warn;
-static unsigned int s_warn_len = 1;
-
-static void warn(const char *fmt, ...)
+/*
+ * Map a regular file. The text parsers below need a NUL terminated
+ * input, and only the part of the last page past the end of the file
+ * is guaranteed to read as zeroes: files that end on a page boundary,
+ * as well as pipes and empty files, are read instead.
+ */
+static int map_input(int fd, struct edid_input *in)
 {
-	unsigned int length;
-	char buf[256];
-	va_list ap;
-
-	va_start(ap, fmt);
-	vsprintf(buf, fmt, ap);
-	va_end(ap);
-	warnings++;
-	length = strlen(buf);
-	s_warn = realloc(s_warn, s_warn_len + length + strlen(cur_block) + 2);
-	strcpy(s_warn + s_warn_len - 1, cur_block);
-	s_warn_len += strlen(cur_block);
-	strcpy(s_warn + s_warn_len - 1, ": ");
-	s_warn_len += 2;
-	strcpy(s_warn + s_warn_len - 1, buf);
-	s_warn_len += length;
-}
+	long page = sysconf(_SC_PAGESIZE);
+	struct stat st;
+	void *p;
 
-#define DEFINE_FIELD(n, var, s, e, ...)				\
-static struct value var##_values[] =  {				\
-	__VA_ARGS__						\
-};								\
-static struct field var = {					\
-	.name = n,						\
-	.start = s,		        			\
-	.end = e,						\
-	.values = var##_values,	        			\
-	.n_values = ARRAY_SIZE(var##_values),			\
+	if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0 ||
+	    st.st_size % page == 0 || st.st_size >= 1 << 30)
+		return -1;
+	p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (p == MAP_FAILED)
+		return -1;
+	in->data = p;
+	in->len = st.st_size;
+	in->map_len = st.st_size;
+	return 0;
 }
 
-static void decode_value(struct field *field, int val, const char *prefix)
+static int read_input(int fd, struct edid_input *in)
 {
-	struct value *v;
+	char *ret;
+	int len, size;
 	int i;
 
-	for (i = 0; i < field->n_values; i++) {
-		v = &field->values[i];
+	size = 1 << 10;
+	ret = malloc(size);
+	len = 0;
 
-		if (v->value == val)
-			break;
-	}
+	if (ret == NULL)
+		return -1;
 
-	if (i == field->n_values) {
-		printf("%s%s: %d\n", prefix, field->name, val);
-		return;
+	for (;;) {
+		i = read(fd, ret + len, size - len);
+		if (i < 0) {
+			free(ret);
+			return -1;
+		}
+		if (i == 0)
+			break;
+		len += i;
+		if (len == size) {
+			char *t;
+			size <<= 1;
+			t = realloc(ret, size);
+			if (t == NULL) {
+				free(ret);
+				return -1;
+			}
+			ret = t;
+		}
 	}
-
-	printf("%s%s: %s (%d)\n", prefix, field->name, v->description, val);
+	ret[len] = 0;
+	in->data = ret;
+	in->len = len;
+	return 0;
 }
 
-static void _decode(struct field **fields, int n_fields, int data, const char *prefix)
+/*
+ * Hex to binary conversion for the text input formats. hex_decode()
+ * converts pairs of hex digits at in into up to n bytes at out, never
+ * reading at or past end, and returns the number of bytes converted: it
+ * stops at the first pair that is not two hex digits. Up to n bytes at
+ * out may be written even if fewer are returned. On x86 the digits are
+ * converted 16 or 32 at a time with SSE2 or AVX2, chosen at run time by
+ * simd_init().
+ */
+static int hex_nibble(unsigned char c)
 {
-	int i;
+	if ((unsigned)(c - '0') < 10)
+		return c - '0';
+	c |= 0x20;
+	if ((unsigned)(c - 'a') < 6)
+		return c - 'a' + 10;
+	return -1;
+}
 
-	for (i = 0; i < n_fields; i++) {
-		struct field *f = fields[i];
-		int field_length = f->end - f->start + 1;
-		int val;
+static unsigned hex_decode_scalar(unsigned char *out, const char *in,
+				  const char *end, unsigned n)
+{
+	unsigned i;
 
-		if (field_length == 32)
-			val = data;
-		else
-			val = (data >> f->start) & ((1 << field_length) - 1);
+	for (i = 0; i < n && end - in >= 2; i++, in += 2) {
+		int hi = hex_nibble(in[0]);
+		int lo = hex_nibble(in[1]);
 
-		decode_value(f, val, prefix);
+		if (hi < 0 || lo < 0)
+			break;
+		out[i] = hi << 4 | lo;
 	}
+	return i;
 }
 
-#define decode(fields, data, prefix)    \
-	_decode(fields, ARRAY_SIZE(fields), data, prefix)
-
-static char *manufacturer_name(const unsigned char *x)
+#ifdef __SSE2__
+/* 16 digits to 8 bytes; returns the mask of the bytes that were hex digits */
+static inline unsigned hex_decode_16(unsigned char *out, const char *in)
 {
-	static char name[4];
-
-	name[0] = ((x[0] & 0x7C) >> 2) + '@';
-	name[1] = ((x[0] & 0x03) << 3) + ((x[1] & 0xE0) >> 5) + '@';
-	name[2] = (x[1] & 0x1F) + '@';
-	name[3] = 0;
-
-	if (isupper(name[0]) && isupper(name[1]) && isupper(name[2]))
-		manufacturer_name_well_formed = 1;
-
-	return name;
+	__m128i c = _mm_loadu_si128((const __m128i *)in);
+	__m128i l = _mm_or_si128(c, _mm_set1_epi8(0x20));
+	__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+				      _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+	__m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8('a' - 1)),
+				      _mm_cmplt_epi8(l, _mm_set1_epi8('f' + 1)));
+	__m128i v = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+				 _mm_and_si128(alpha, _mm_sub_epi8(l, _mm_set1_epi8('a' - 10))));
+
+	/* the first digit of each pair is the low byte of a 16 bit lane */
+	v = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0xff)), 4),
+			 _mm_srli_epi16(v, 8));
+	_mm_storel_epi64((__m128i *)out, _mm_packus_epi16(v, v));
+	return _mm_movemask_epi8(_mm_or_si128(digit, alpha));
 }
 
-/*
- * Copied from xserver/hw/xfree86/modes/xf86cvt.c
- */
-static void edid_cvt_mode(int HDisplay, int VDisplay,
-			  int VRefresh, int Reduced,
-			  unsigned *MinHFreq, unsigned *MaxHFreq,
-			  unsigned *MaxClock)
+static unsigned hex_decode_sse2(unsigned char *out, const char *in,
+				const char *end, unsigned n)
 {
-	/* 1) top/bottom margin size (% of height) - default: 1.8 */
-#define CVT_MARGIN_PERCENTAGE 1.8
-
-	/* 2) character cell horizontal granularity (pixels) - default 8 */
-#define CVT_H_GRANULARITY 8
+	unsigned i, valid;
 
-	/* 4) Minimum vertical porch (lines) - default 3 */
-#define CVT_MIN_V_PORCH 3
-
-	/* 4) Minimum number of vertical back porch lines - default 6 */
-#define CVT_MIN_V_BPORCH 6
-
-	/* Pixel Clock step (kHz) */
-#define CVT_CLOCK_STEP 250
-
-	float HPeriod;
-	unsigned HTotal, Clock, HorFreq;
-	int VSync;
-
-	/* 2. Horizontal pixels */
-	HDisplay = HDisplay - (HDisplay % CVT_H_GRANULARITY);
-
-	/* Determine VSync Width from aspect ratio */
-	if (!(VDisplay % 3) && ((VDisplay * 4 / 3) == HDisplay))
-		VSync = 4;
-	else if (!(VDisplay % 9) && ((VDisplay * 16 / 9) == HDisplay))
-		VSync = 5;
-	else if (!(VDisplay % 10) && ((VDisplay * 16 / 10) == HDisplay))
-		VSync = 6;
-	else if (!(VDisplay % 4) && ((VDisplay * 5 / 4) == HDisplay))
-		VSync = 7;
-	else if (!(VDisplay % 9) && ((VDisplay * 15 / 9) == HDisplay))
-		VSync = 7;
-	else                        /* Custom */
-		VSync = 10;
-
-	if (!Reduced) {             /* simplified GTF calculation */
-
-		/* 4) Minimum time of vertical sync + back porch interval (µs)
-		 * default 550.0 */
-#define CVT_MIN_VSYNC_BP 550.0
-
-		/* 3) Nominal HSync width (% of line period) - default 8 */
-#define CVT_HSYNC_PERCENTAGE 8
-
-		float HBlankPercentage;
-		int HBlank;
-
-		/* 8. Estimated Horizontal period */
-		HPeriod = ((float) (1000000.0 / VRefresh - CVT_MIN_VSYNC_BP)) /
-			(VDisplay + CVT_MIN_V_PORCH);
-
-		/* 5) Definition of Horizontal blanking time limitation */
-		/* Gradient (%/kHz) - default 600 */
-#define CVT_M_FACTOR 600
-
-		/* Offset (%) - default 40 */
-#define CVT_C_FACTOR 40
-
-		/* Blanking time scaling factor - default 128 */
-#define CVT_K_FACTOR 128
-
-		/* Scaling factor weighting - default 20 */
-#define CVT_J_FACTOR 20
-
-#define CVT_M_PRIME (CVT_M_FACTOR * CVT_K_FACTOR / 256)
-#define CVT_C_PRIME ((CVT_C_FACTOR - CVT_J_FACTOR) * CVT_K_FACTOR / 256 + CVT_J_FACTOR)
-
-		/* 12. Find ideal blanking duty cycle from formula */
-		HBlankPercentage = CVT_C_PRIME - CVT_M_PRIME * HPeriod / 1000.0;
-
-		/* 13. Blanking time */
-		if (HBlankPercentage < 20)
-			HBlankPercentage = 20;
-
-		HBlank = HDisplay * HBlankPercentage / (100.0 - HBlankPercentage);
-		HBlank -= HBlank % (2 * CVT_H_GRANULARITY);
-
-		/* 14. Find total number of pixels in a line. */
-		HTotal = HDisplay + HBlank;
+	for (i = 0; n - i >= 8 && end - in >= 16; i += 8, in += 16) {
+		valid = hex_decode_16(out + i, in);
+		if (valid != 0xffff)
+			return i + __builtin_ctz(~valid) / 2;
 	}
-	else {                      /* Reduced blanking */
-		/* Minimum vertical blanking interval time (µs) - default 460 */
-#define CVT_RB_MIN_VBLANK 460.0
-
-		/* Fixed number of clocks for horizontal sync */
-#define CVT_RB_H_SYNC 32.0
-
-		/* Fixed number of clocks for horizontal blanking */
-#define CVT_RB_H_BLANK 160.0
-
-		/* Fixed number of lines for vertical front porch - default 3 */
-#define CVT_RB_VFPORCH 3
+	return i + hex_decode_scalar(out + i, in, end, n - i);
+}
+#endif
 
-		int VBILines;
+#ifdef HAVE_AVX2
+__attribute__((target("avx2")))
+static unsigned hex_decode_avx2(unsigned char *out, const char *in,
+				const char *end, unsigned n)
+{
+	unsigned i, valid;
+
+	for (i = 0; n - i >= 16 && end - in >= 32; i += 16, in += 32) {
+		__m256i c = _mm256_loadu_si256((const __m256i *)in);
+		__m256i l = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+						 _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+		__m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(l, _mm256_set1_epi8('a' - 1)),
+						 _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), l));
+		__m256i v = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+					    _mm256_and_si256(alpha, _mm256_sub_epi8(l, _mm256_set1_epi8('a' - 10))));
+
+		v = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0xff)), 4),
+				    _mm256_srli_epi16(v, 8));
+		/* packus works per 128 bit lane: gather qwords 0 and 2 */
+		v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+		_mm_storeu_si128((__m128i *)(out + i), _mm256_castsi256_si128(v));
+		valid = _mm256_movemask_epi8(_mm256_or_si256(digit, alpha));
+		if (valid != 0xffffffff)
+			return i + __builtin_ctz(~valid) / 2;
+	}
+	return i + hex_decode_sse2(out + i, in, end, n - i);
+}
+#endif
 
-		/* 8. Estimate Horizontal period. */
-		HPeriod = ((float) (1000000.0 / VRefresh - CVT_RB_MIN_VBLANK)) / VDisplay;
+#ifdef __SSE2__
+static unsigned (*hex_decode)(unsigned char *out, const char *in,
+			      const char *end, unsigned n) = hex_decode_sse2;
+#else
+static unsigned (*hex_decode)(unsigned char *out, const char *in,
+			      const char *end, unsigned n) = hex_decode_scalar;
+#endif
 
-		/* 9. Find number of lines in vertical blanking */
-		VBILines = ((float) CVT_RB_MIN_VBLANK) / HPeriod + 1;
+/*
+ * Search a binary for the EDID header with --carve. find_header() returns
+ * the offset in buf of the first header that starts at or after pos and
+ * before end, or end if there is none; the 7 bytes past end must be
+ * readable. The SSE2 and AVX2 versions test 16 or 32 offsets at a time
+ * against the first two and last two bytes of the header, and only
+ * compare the few candidates left in full.
+ */
+static const unsigned char edid_header[8] = {
+	0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00
+};
 
-		/* 10. Check if vertical blanking is sufficient */
-		if (VBILines < (CVT_RB_VFPORCH + VSync + CVT_MIN_V_BPORCH))
-			VBILines = CVT_RB_VFPORCH + VSync + CVT_MIN_V_BPORCH;
+static size_t find_header_scalar(const unsigned char *buf, size_t pos,
+				 size_t end)
+{
+	for (; pos < end; pos++)
+		if (buf[pos] == 0x00 && buf[pos + 1] == 0xff &&
+		    !memcmp(buf + pos, edid_header, sizeof(edid_header)))
+			return pos;
+	return end;
+}
 
-		/* 12. Find total number of pixels in a line */
-		HTotal = HDisplay + CVT_RB_H_BLANK;
+#ifdef __SSE2__
+static size_t find_header_sse2(const unsigned char *buf, size_t pos,
+			       size_t end)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ff = _mm_set1_epi8(-1);
+
+	for (; pos + 16 <= end; pos += 16) {
+		const unsigned char *p = buf + pos;
+		__m128i m = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), zero),
+					  _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + 1)), ff));
+		unsigned mask;
+
+		m = _mm_and_si128(m, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + 6)), ff));
+		m = _mm_and_si128(m, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + 7)), zero));
+		for (mask = _mm_movemask_epi8(m); mask; mask &= mask - 1) {
+			unsigned i = __builtin_ctz(mask);
+
+			if (!memcmp(p + i, edid_header, sizeof(edid_header)))
+				return pos + i;
+		}
 	}
-
-	/* 15/13. Find pixel clock frequency (kHz for xf86) */
-	Clock = HTotal * 1000.0 / HPeriod;
-	Clock -= Clock % CVT_CLOCK_STEP;
-	HorFreq = (Clock * 1000) / HTotal;
-
-	*MinHFreq = min(*MinHFreq, HorFreq);
-	*MaxHFreq = max(*MaxHFreq, HorFreq);
-	*MaxClock = max(*MaxClock, Clock);
-	min_hor_freq_hz = min(min_hor_freq_hz, HorFreq);
-	max_hor_freq_hz = max(max_hor_freq_hz, HorFreq);
-	max_pixclk_khz = max(max_pixclk_khz, Clock);
+	return find_header_scalar(buf, pos, end);
 }
+#endif
 
-static int detailed_cvt_descriptor(const unsigned char *x, int first)
+#ifdef HAVE_AVX2
+__attribute__((target("avx2")))
+static size_t find_header_avx2(const unsigned char *buf, size_t pos,
+			       size_t end)
 {
-	const unsigned char empty[3] = { 0, 0, 0 };
-	const char *ratio;
-	char *names[] = { "50", "60", "75", "85" };
-	int width, height;
-	int valid = 1;
-	int fifty = 0, sixty = 0, seventyfive = 0, eightyfive = 0, reduced = 0;
-	int min_refresh = 0xfffffff, max_refresh = 0;
-
-	if (!first && !memcmp(x, empty, 3))
-		return valid;
-
-	height = x[0];
-	height |= (x[1] & 0xf0) << 4;
-	height++;
-	height *= 2;
-
-	switch (x[1] & 0x0c) {
-	case 0x00:
-		width = 8 * (((height * 4) / 3) / 8);
-		ratio = "4:3";
-		break;
-	case 0x04:
-		width = 8 * (((height * 16) / 9) / 8);
-		ratio = "16:9";
-		break;
-	case 0x08:
-		width = 8 * (((height * 16) / 10) / 8);
-		ratio = "16:10";
-		break;
-	case 0x0c:
-		width = 8 * (((height * 15) / 9) / 8);
-		ratio = "15:9";
-		break;
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ff = _mm256_set1_epi8(-1);
+
+	for (; pos + 32 <= end; pos += 32) {
+		const unsigned char *p = buf + pos;
+		__m256i m = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), zero),
+					     _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 1)), ff));
+		unsigned mask;
+
+		m = _mm256_and_si256(m, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 6)), ff));
+		m = _mm256_and_si256(m, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 7)), zero));
+		for (mask = _mm256_movemask_epi8(m); mask; mask &= mask - 1) {
+			unsigned i = __builtin_ctz(mask);
+
+			if (!memcmp(p + i, edid_header, sizeof(edid_header)))
+				return pos + i;
+		}
 	}
+	return find_header_sse2(buf, pos, end);
+}
+#endif
 
-	if (x[1] & 0x03)
-		valid = 0;
-	if (x[2] & 0x80)
-		valid = 0;
-	if (!(x[2] & 0x1f))
-		valid = 0;
-
-	fifty	= (x[2] & 0x10);
-	sixty	= (x[2] & 0x08);
-	seventyfive = (x[2] & 0x04);
-	eightyfive  = (x[2] & 0x02);
-	reduced	= (x[2] & 0x01);
-
-	min_refresh = (fifty ? 50 : (sixty ? 60 : (seventyfive ? 75 : (eightyfive ? 85 : min_refresh))));
-	max_refresh = (eightyfive ? 85 : (seventyfive ? 75 : (sixty ? 60 : (fifty ? 50 : max_refresh))));
+#ifdef __SSE2__
+static size_t (*find_header)(const unsigned char *buf, size_t pos,
+			     size_t end) = find_header_sse2;
+#else
+static size_t (*find_header)(const unsigned char *buf, size_t pos,
+			     size_t end) = find_header_scalar;
+#endif
 
-	if (!valid) {
-		printf("    (broken)\n");
-	} else {
-		unsigned min_hfreq = ~0;
-		unsigned max_hfreq = 0;
-		unsigned max_clock = 0;
-
-		min_vert_freq_hz = min(min_vert_freq_hz, min_refresh);
-		max_vert_freq_hz = max(max_vert_freq_hz, max_refresh);
-
-		if (fifty)
-			edid_cvt_mode(width, height, 50, 0,
-				      &min_hfreq, &max_hfreq, &max_clock);
-		if (sixty)
-			edid_cvt_mode(width, height, 60, 0,
-				      &min_hfreq, &max_hfreq, &max_clock);
-		if (seventyfive)
-			edid_cvt_mode(width, height, 75, 0,
-				      &min_hfreq, &max_hfreq, &max_clock);
-		if (eightyfive)
-			edid_cvt_mode(width, height, 75, 0,
-				      &min_hfreq, &max_hfreq, &max_clock);
-		if (reduced)
-			edid_cvt_mode(width, height, 60, 1,
-				      &min_hfreq, &max_hfreq, &max_clock);
-
-		printf("    %dx%d @ ( %s%s%s%s%s) Hz %s (%s%s preferred) HorFreq: %d-%d Hz MaxClock: %.3f MHz\n",
-		       width, height,
-		       fifty ? "50 " : "",
-		       sixty ? "60 " : "",
-		       seventyfive ? "75 " : "",
-		       eightyfive ? "85 " : "",
-		       reduced ? "60RB " : "",
-		       ratio,
-		       names[(x[2] & 0x60) >> 5],
-		       (((x[2] & 0x60) == 0x20) && reduced) ? "RB" : "",
-		       min_hfreq, max_hfreq, max_clock / 1000000.0);
+/* must be called before any threads are started */
+static void simd_init(void)
+{
+#ifdef HAVE_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		hex_decode = hex_decode_avx2;
+		find_header = find_header_avx2;
 	}
-
-	return valid;
+#endif
 }
 
-/* extract a string from a detailed subblock, checking for termination */
-static char *extract_string(const char *name, const unsigned char *x, int *valid, int len)
+enum input_format {
+	INPUT_UNKNOWN,
+	INPUT_RAW,		/* binary EDID */
+	INPUT_HEX,		/* plain hex dump */
+	INPUT_XRANDR,		/* xrandr --verbose */
+	INPUT_QUANTUMDATA,	/* QuantumData 980 XML */
+	INPUT_LOG,		/* Xorg or kernel log */
+};
+
+/*
+ * Classify the input in a single forward scan and set *start to where its
+ * parser should begin. The EDID property of xrandr takes precedence over
+ * QuantumData blocks, which take precedence over the hex and binary
+ * checks of the first bytes; Xorg and kernel logs come last. Like the
+ * parsers, the scan stops at the first NUL byte, so a binary EDID ends it
+ * at once.
+ */
+static enum input_format detect_input(const char *buf, const char **start)
 {
-	static char ret[EDID_PAGE_SIZE];
-	int i, seen_newline = 0;
-
-	memset(ret, 0, sizeof(ret));
-	*valid = 1;
-
-	for (i = 0; i < len; i++) {
-		if (isgraph(x[i])) {
-			ret[i] = x[i];
-		} else if (!seen_newline) {
-			if (x[i] == 0x0a) {
-				seen_newline = 1;
-				if (!i) {
-					empty_string = 1;
-					warn("%s: empty string\n", name);
-					*valid = 0;
-				} else if (ret[i - 1] == 0x20) {
-					warn("%s: one or more trailing spaces\n", name);
-					trailing_space = 1;
-					*valid = 0;
-				}
-			} else if (x[i] == 0x20) {
-				ret[i] = x[i];
-			} else {
-				has_valid_string_termination = 0;
-				warn("%s: non-printable character\n", name);
-				*valid = 0;
-				return ret;
+	const char *xrandr = NULL, *block = NULL, *log = NULL;
+	const char *p;
+	int i;
+
+	for (p = buf; *p; p++) {
+		if (*p == 'E' && !strncmp(p, "EDID", 4)) {
+			if (!strncmp(p + 4, "_DATA:", 6)) {
+				xrandr = p;
+				break;
+			}
+			if (p - buf >= 4 && !strncmp(p - 4, "Raw ", 4)) {
+				if (!log)
+					log = p - 4;
+			} else if (!xrandr && p[4] == ':') {
+				xrandr = p;
+			} else if (!log && !strncmp(p + 4, " (in hex):", 10)) {
+				log = p;
 			}
-		} else if (x[i] != 0x20) {
-			has_valid_string_termination = 0;
-			warn("%s: non-space after newline\n", name);
-			*valid = 0;
-			return ret;
+		} else if (*p == '<' && !block && !strncmp(p, "<BLOCK", 6)) {
+			block = p;
 		}
 	}
-	/* Does the string end with a space? */
-	if (!seen_newline && ret[len - 1] == 0x20) {
-		trailing_space = 1;
-		warn("%s: one or more trailing spaces\n", name);
-		*valid = 0;
+
+	if (xrandr) {
+		*start = xrandr;
+		return INPUT_XRANDR;
+	}
+	if (block) {
+		*start = block;
+		return INPUT_QUANTUMDATA;
 	}
 
-	return ret;
-}
+	*start = buf;
+	/* Is the EDID provided in hex? */
+	for (i = 0; i < 32 && (isspace(buf[i]) || buf[i] == ',' ||
+			       tolower(buf[i]) == 'x' || isxdigit(buf[i])); i++);
+	if (i == 32)
+		return INPUT_HEX;
 
-static const struct {
-	int x, y, refresh, ratio_w, ratio_h;
-	int hor_freq_hz, pixclk_khz, interlaced;
-} established_timings[] = {
-	/* 0x23 bit 7 - 0 */
-	{720, 400, 70, 9, 5, 31469, 28320},
-	{720, 400, 88, 9, 5, 39500, 35500},
-	{640, 480, 60, 4, 3, 31469, 25175},
-	{640, 480, 67, 4, 3, 35000, 30240},
-	{640, 480, 72, 4, 3, 37900, 31500},
-	{640, 480, 75, 4, 3, 37500, 31500},
-	{800, 600, 56, 4, 3, 35200, 36000},
-	{800, 600, 60, 4, 3, 37900, 40000},
-	/* 0x24 bit 7 - 0 */
-	{800, 600, 72, 4, 3, 48100, 50000},
-	{800, 600, 75, 4, 3, 46900, 49500},
-	{832, 624, 75, 4, 3, 49726, 57284},
-	{1280, 768, 87, 5, 3, 35522, 44900, 1},
-	{1024, 768, 60, 4, 3, 48400, 65000},
-	{1024, 768, 70, 4, 3, 56500, 75000},
-	{1024, 768, 75, 4, 3, 60000, 78750},
-	{1280, 1024, 75, 5, 4, 80000, 135000},
-	/* 0x25 bit 7*/
-	{1152, 870, 75, 192, 145, 67500, 108000},
-};
+	for (i = 0; i < 8; i++)
+		if (!isascii(buf[i]))
+			return INPUT_RAW;
 
-static const struct {
-	int x, y, refresh, ratio_w, ratio_h;
-	int hor_freq_hz, pixclk_khz, rb;
-} established_timings3[] = {
-	/* 0x06 bit 7 - 0 */
-	{640, 350, 85, 64, 35, 37900, 31500},
-	{640, 400, 85, 16, 10, 37900, 31500},
-	{720, 400, 85, 9, 5, 37900, 35500},
-	{640, 480, 85, 4, 3, 43300, 36000},
-	{848, 480, 60, 53, 30, 31000, 33750},
-	{800, 600, 85, 4, 3, 53700, 56250},
-	{1024, 768, 85, 4, 3, 68700, 94500},
-	{1152, 864, 75, 4, 3, 67500, 108000},
-	/* 0x07 bit 7 - 0 */
-	{1280, 768, 60, 5, 3, 47400, 68250, 1},
-	{1280, 768, 60, 5, 3, 47800, 79500},
-	{1280, 768, 75, 5, 3, 60300, 102250},
-	{1280, 768, 85, 5, 3, 68600, 117500},
-	{1280, 960, 60, 4, 3, 60000, 108000},
-	{1280, 960, 85, 4, 3, 85900, 148500},
-	{1280, 1024, 60, 5, 4, 64000, 108000},
-	{1280, 1024, 85, 5, 4, 91100, 157500},
-	/* 0x08 bit 7 - 0 */
-	{1360, 768, 60, 85, 48, 47700, 85500},
-	{1440, 900, 60, 16, 10, 55500, 88750, 1},
-	{1440, 900, 60, 16, 10, 65300, 121750},
-	{1440, 900, 75, 16, 10, 82300, 156000},
-	{1440, 900, 85, 16, 10, 93900, 179500},
-	{1400, 1050, 60, 4, 3, 64700, 101000, 1},
-	{1400, 1050, 60, 4, 3, 65300, 121750},
-	{1400, 1050, 75, 4, 3, 82300, 156000},
-	/* 0x09 bit 7 - 0 */
-	{1400, 1050, 85, 4, 3, 93900, 179500},
-	{1680, 1050, 60, 16, 10, 64700, 119000, 1},
-	{1680, 1050, 60, 16, 10, 65300, 146250},
-	{1680, 1050, 75, 16, 10, 82300, 187000},
-	{1680, 1050, 85, 16, 10, 93900, 214750},
-	{1600, 1200, 60, 4, 3, 75000, 162000},
-	{1600, 1200, 65, 4, 3, 81300, 175500},
-	{1600, 1200, 70, 4, 3, 87500, 189000},
-	/* 0x0a bit 7 - 0 */
-	{1600, 1200, 75, 4, 3, 93800, 202500},
-	{1600, 1200, 85, 4, 3, 106300, 229500},
-	{1792, 1344, 60, 4, 3, 83600, 204750},
-	{1792, 1344, 75, 4, 3, 106300, 261000},
-	{1856, 1392, 60, 4, 3, 86300, 218250},
-	{1856, 1392, 75, 4, 3, 112500, 288000},
-	{1920, 1200, 60, 16, 10, 74000, 154000, 1},
-	{1920, 1200, 60, 16, 10, 74600, 193250},
-	/* 0x0b bit 7 - 4 */
-	{1920, 1200, 75, 16, 10, 94000, 245250},
-	{1920, 1200, 85, 16, 10, 107200, 281250},
-	{1920, 1440, 60, 4, 3, 90000, 234000},
-	{1920, 1440, 75, 4, 3, 112500, 297000},
-};
+	if (log) {
+		*start = log;
+		return INPUT_LOG;
+	}
+	return INPUT_UNKNOWN;
+}
 
-static void print_standard_timing(uint8_t b1, uint8_t b2)
+/* Return the length of the indentation at line, or -1 if it is mixed */
+static int xrandr_indent(const char *line)
 {
-	int ratio_w, ratio_h;
-	unsigned int x, y, refresh;
-	int pixclk_khz = 0, hor_freq_hz = 0;
-	int i;
-
-	if (b1 == 0x01 && b2 == 0x01)
-		return;
+	const char *p = line;
 
-	if (b1 == 0) {
-		printf("non-conformant standard timing (0 horiz)\n");
-		return;
-	}
-	x = (b1 + 31) * 8;
-	switch ((b2 >> 6) & 0x3) {
-	case 0x00:
-		if (claims_one_point_three) {
-			y = x * 10 / 16;
-			ratio_w = 16;
-			ratio_h = 10;
-		} else {
-			y = x;
-			ratio_w = 1;
-			ratio_h = 1;
-		}
-		break;
-	case 0x01:
-		y = x * 3 / 4;
-		ratio_w = 4;
-		ratio_h = 3;
-		break;
-	case 0x02:
-		y = x * 4 / 5;
-		ratio_w = 5;
-		ratio_h = 4;
-		break;
-	case 0x03:
-		y = x * 9 / 16;
-		ratio_w = 16;
-		ratio_h = 9;
-		break;
-	}
-	refresh = 60 + (b2 & 0x3f);
-
-	min_vert_freq_hz = min(min_vert_freq_hz, refresh);
-	max_vert_freq_hz = max(max_vert_freq_hz, refresh);
-	for (i = 0; i < ARRAY_SIZE(established_timings); i++) {
-		if (established_timings[i].x == x &&
-		    established_timings[i].y == y &&
-		    established_timings[i].refresh == refresh &&
-		    established_timings[i].ratio_w == ratio_w &&
-		    established_timings[i].ratio_h == ratio_h) {
-			pixclk_khz = established_timings[i].pixclk_khz;
-			hor_freq_hz = established_timings[i].hor_freq_hz;
-			break;
-		}
-	}
-	if (pixclk_khz == 0) {
-		for (i = 0; i < ARRAY_SIZE(established_timings3); i++) {
-			if (established_timings3[i].x == x &&
-			    established_timings3[i].y == y &&
-			    established_timings3[i].refresh == refresh &&
-			    established_timings3[i].ratio_w == ratio_w &&
-			    established_timings3[i].ratio_h == ratio_h) {
-				pixclk_khz = established_timings3[i].pixclk_khz;
-				hor_freq_hz = established_timings3[i].hor_freq_hz;
-				break;
-			}
-		}
-	}
-	/* TODO: this should also check DMT timings and GTF/CVT */
-	if (pixclk_khz) {
-		min_hor_freq_hz = min(min_hor_freq_hz, hor_freq_hz);
-		max_hor_freq_hz = max(max_hor_freq_hz, hor_freq_hz);
-		max_pixclk_khz = max(max_pixclk_khz, pixclk_khz);
-		printf("  %dx%d@%dHz %d:%d HorFreq: %d Hz Clock: %.3f MHz\n",
-		       x, y, refresh, ratio_w, ratio_h,
-		       hor_freq_hz, pixclk_khz / 1000.0);
-	} else {
-		printf("  %dx%d@%dHz %d:%d\n",
-		       x, y, refresh, ratio_w, ratio_h);
+	if (*p == '\t') {
+		while (*p == '\t')
+			p++;
+		return (p - line) * 8;
 	}
+	while (*p == ' ')
+		p++;
+	return *p == '\t' ? -1 : p - line;
 }
 
-/* 1 means valid data */
-static int detailed_block(const unsigned char *x, int in_extension)
+/* Is there nothing but trailing white space from p to the end of the line? */
+static int xrandr_line_end(const char *p)
 {
-	int ha, hbl, hso, hspw, hborder, va, vbl, vso, vspw, vborder;
-	int refresh, pixclk_khz;
-	int i;
-	char phsync, pvsync, *syncmethod, *stereo;
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+		p++;
+	return *p == '\n' || !*p;
+}
 
-#if 0
-	printf("Hex of detail: ");
-	for (i = 0; i < 18; i++)
-		printf("%02x", x[i]);
-	printf("\n");
-#endif
+/*
+ * Parse xrandr --verbose output line by line, collecting the EDID property
+ * of every output. Outputs start in the first column, their properties are
+ * indented by one level and property values by two, where a level is a tab
+ * or eight spaces. An EDID value is lines of 16 bytes in hex. The whole
+ * input is parsed, so that the outputs before the first EDID are seen.
+ */
+static int parse_xrandr(struct edid_input *in)
+{
+	const char *output = NULL, *line, *next;
+	unsigned char *out, *p;
+	unsigned max = 0;
+	int in_edid = 0;
+	unsigned n;
+
+	/* an upper bound: two hex digits per byte */
+	out = malloc(in->len / 2 + 1);
+	if (!out)
+		return -1;
+	p = out;
 
-	if (x[0] == 0 && x[1] == 0) {
-		/* Monitor descriptor block, not detailed timing descriptor. */
-		if (x[2] != 0) {
-			/* 1.3, 3.10.3 */
-			printf("Monitor descriptor block has byte 2 nonzero (0x%02x)\n",
-			       x[2]);
-			has_valid_descriptor_pad = 0;
-		}
-		if (x[3] != 0xfd && x[4] != 0x00) {
-			/* 1.3, 3.10.3 */
-			printf("Monitor descriptor block has byte 4 nonzero (0x%02x)\n",
-			       x[4]);
-			has_valid_descriptor_pad = 0;
-		}
+	for (line = in->data; *line; line = next) {
+		int indent = xrandr_indent(line);
+		const char *text = line + (indent < 0 ? 0 : strspn(line, " \t"));
 
-		seen_non_detailed_descriptor = 1;
-		if (x[3] <= 0xF) {
-			/*
-			 * in principle we can decode these, if we know what they are.
-			 * 0x0f seems to be common in laptop panels.
-			 * 0x0e is used by EPI: http://www.epi-standard.org/
-			 */
-			printf("Manufacturer-specified data, tag %d\n", x[3]);
-			return 1;
+		next = strchr(line, '\n');
+		next = next ? next + 1 : line + strlen(line);
+
+		if (in_edid && indent == 16 && hex_decode(p, text, next, 16) == 16 &&
+		    xrandr_line_end(text + 32)) {
+			p += 16;
+			in->edids[in->num_edids - 1].size += 16;
+			continue;
 		}
-		switch (x[3]) {
-		case 0x10:
-			printf("Dummy block\n");
-			for (i = 5; i < 18; i++)
-				if (x[i] != 0x00)
-					has_valid_dummy_block = 0;
-			return 1;
-		case 0xF7:
-			printf("Established timings III:\n");
-			for (i = 0; i < 44; i++) {
-				if (x[6 + i / 8] & (1 << (7 - i % 8))) {
-					printf("  %dx%d@%dHz %s%u:%u HorFreq: %d Hz Clock: %.3f MHz\n",
-					       established_timings3[i].x,
-					       established_timings3[i].y, established_timings3[i].refresh,
-					       established_timings3[i].rb ? "RB " : "",
-					       established_timings3[i].ratio_w, established_timings3[i].ratio_h,
-					       established_timings3[i].hor_freq_hz,
-					       established_timings3[i].pixclk_khz / 1000.0);
-					min_vert_freq_hz = min(min_vert_freq_hz, established_timings3[i].refresh);
-					max_vert_freq_hz = max(max_vert_freq_hz, established_timings3[i].refresh);
-					min_hor_freq_hz = min(min_hor_freq_hz, established_timings3[i].hor_freq_hz);
-					max_hor_freq_hz = max(max_hor_freq_hz, established_timings3[i].hor_freq_hz);
-					max_pixclk_khz = max(max_pixclk_khz, established_timings3[i].pixclk_khz);
-				}
-			}
-			return 1;
-		case 0xF8: {
-			int valid_cvt = 1; /* just this block */
-			printf("CVT 3-byte code descriptor:\n");
-			if (x[5] != 0x01) {
-				has_valid_cvt = 0;
-				return 0;
+		in_edid = 0;
+		if (indent == 0 && !isspace(*line) && *line) {
+			output = line;
+		} else if (indent == 8 && (!strncmp(text, "EDID:", 5) ||
+					   !strncmp(text, "EDID_DATA:", 10))) {
+			struct edid_entry *e;
+
+			if (in->num_edids == max) {
+				max = max ? 2 * max : 4;
+				e = realloc(in->edids, max * sizeof(*e));
+				if (!e)
+					goto err;
+				in->edids = e;
 			}
-			for (i = 0; i < 4; i++)
-				valid_cvt &= detailed_cvt_descriptor(x + 6 + (i * 3), (i == 0));
-			has_valid_cvt &= valid_cvt;
-			return valid_cvt;
+			e = &in->edids[in->num_edids++];
+			e->edid = p;
+			e->size = 0;
+			e->name = output;
+			e->name_len = output ? strcspn(output, " \t\r\n") : 0;
+			in_edid = 1;
 		}
-		case 0xF9:
-			printf("Color management data:\n");
-			printf("  Version:  %d\n", x[5]);
-			printf("  Red a3:   %.2f\n", (short)(x[6] | (x[7] << 8)) / 100.0);
-			printf("  Red a2:   %.2f\n", (short)(x[8] | (x[9] << 8)) / 100.0);
-			printf("  Green a3: %.2f\n", (short)(x[10] | (x[11] << 8)) / 100.0);
-			printf("  Green a2: %.2f\n", (short)(x[12] | (x[13] << 8)) / 100.0);
-			printf("  Blue a3:  %.2f\n", (short)(x[14] | (x[15] << 8)) / 100.0);
-			printf("  Blue a2:  %.2f\n", (short)(x[16] | (x[17] << 8)) / 100.0);
-			return 1;
-		case 0xFA:
-			printf("More standard timings:\n");
-			for (i = 0; i < 6; i++)
-				print_standard_timing(x[5 + i * 2], x[5 + i * 2 + 1]);
-			return 1;
-		case 0xFB: {
-			unsigned w_x, w_y;
-			unsigned gamma;
-
-			printf("Color point:\n");
-			w_x = (x[7] << 2) | ((x[6] >> 2) & 3);
-			w_y = (x[8] << 2) | (x[6] & 3);
-			gamma = x[9];
-			printf("  Index: %u White: 0.%04u, 0.%04u", x[5],
-			       (w_x * 10000) / 1024, (w_y * 10000) / 1024);
-			if (gamma == 0xff)
-				printf(" Gamma: is defined in an extension block");
-			else
-				printf(" Gamma: %.2f", ((gamma + 100.0) / 100.0));
-			printf("\n");
-			if (x[10] == 0)
-				return 1;
-			w_x = (x[12] << 2) | ((x[11] >> 2) & 3);
-			w_y = (x[13] << 2) | (x[11] & 3);
-			gamma = x[14];
-			printf("  Index: %u White: 0.%04u, 0.%04u", x[10],
-			       (w_x * 10000) / 1024, (w_y * 10000) / 1024);
-			if (gamma == 0xff)
-				printf(" Gamma: is defined in an extension block");
-			else
-				printf(" Gamma: %.2f", ((gamma + 100.0) / 100.0));
-			printf("\n");
-			return 1;
+	}
+
+	/* drop properties without a value */
+	for (n = 0; n < in->num_edids; ) {
+		if (in->edids[n].size) {
+			n++;
+			continue;
 		}
-		case 0xFC:
-			has_name_descriptor = 1;
-			printf("Monitor name: %s\n",
-			       extract_string("Display Product Name", x + 5, &has_valid_name_descriptor, 13));
-			return 1;
-		case 0xFD: {
-			int h_max_offset = 0, h_min_offset = 0;
-			int v_max_offset = 0, v_min_offset = 0;
-			int is_cvt = 0;
-			has_range_descriptor = 1;
-			char *range_class = "";
-			/* 
-			 * XXX todo: implement feature flags, vtd blocks
-			 * XXX check: ranges are well-formed; block termination if no vtd
-			 */
-			if (claims_one_point_four) {
-				if (x[4] & 0x02) {
-					v_max_offset = 255;
-					if (x[4] & 0x01) {
-						v_min_offset = 255;
-					}
-				}
-				if (x[4] & 0x04) {
-					h_max_offset = 255;
-					if (x[4] & 0x03) {
-						h_min_offset = 255;
-					}
-				}
-			} else if (x[4]) {
-				has_valid_range_descriptor = 0;
-			}
+		memmove(&in->edids[n], &in->edids[n + 1],
+			(--in->num_edids - n) * sizeof(*in->edids));
+	}
+	if (!in->num_edids)
+		goto err;
+	in->alloc = out;
+	return 0;
 
-			/*
-			 * despite the values, this is not a bitfield.
-			 */
-			switch (x[10]) {
-			case 0x00: /* default gtf */
-				range_class = "GTF";
-				break;
-			case 0x01: /* range limits only */
-				range_class = "bare limits";
-				if (!claims_one_point_four)
-					has_valid_range_descriptor = 0;
-				break;
-			case 0x02: /* secondary gtf curve */
-				range_class = "GTF with icing";
-				break;
-			case 0x04: /* cvt */
-				range_class = "CVT";
-				is_cvt = 1;
-				if (!claims_one_point_four)
-					has_valid_range_descriptor = 0;
-				break;
-			default: /* invalid */
-				has_valid_range_descriptor = 0;
-				range_class = "invalid";
-				break;
-			}
+err:
+	free(in->edids);
+	in->edids = NULL;
+	in->num_edids = 0;
+	free(out);
+	return -1;
+}
 
-			if (x[5] + v_min_offset > x[6] + v_max_offset)
-				has_valid_range_descriptor = 0;
-			mon_min_vert_freq_hz = x[5] + v_min_offset;
-			mon_max_vert_freq_hz = x[6] + v_max_offset;
-			if (x[7] + h_min_offset > x[8] + h_max_offset)
-				has_valid_range_descriptor = 0;
-			mon_min_hor_freq_hz = (x[7] + h_min_offset) * 1000;
-			mon_max_hor_freq_hz = (x[8] + h_max_offset) * 1000;
-			printf("Monitor ranges (%s): %d-%dHz V, %d-%dkHz H",
-			       range_class,
-			       x[5] + v_min_offset, x[6] + v_max_offset,
-			       x[7] + h_min_offset, x[8] + h_max_offset);
-			if (x[9]) {
-				mon_max_pixclk_khz = x[9] * 10000;
-				printf(", max dotclock %dMHz\n", x[9] * 10);
-			} else {
-				if (claims_one_point_four)
-					has_valid_max_dotclock = 0;
-				printf("\n");
-			}
+/* Parse QuantumData 980 EDID files */
+static unsigned char *parse_quantumdata(const char *start, const char *end,
+					unsigned *edid_size)
+{
+	unsigned char *out = NULL;
+	int out_index = 0;
+	unsigned n;
+
+	do {
+		start = strstr(start, ">");
+		if (start)
+			out = realloc(out, out_index + 128);
+		if (!start || !out) {
+			free(out);
+			return NULL;
+		}
+		start++;
+		/* a short block is padded with zeroes */
+		n = hex_decode(out + out_index, start, end, 128);
+		memset(out + out_index + n, 0, 128 - n);
+		out_index += 128;
+		start = strstr(start, "<BLOCK");
+	} while (start);
+	*edid_size = out_index & ~15;
+	return out;
+}
 
-			if (is_cvt) {
-				int max_h_pixels = 0;
-
-				printf("CVT version %d.%d\n", (x[11] & 0xf0) >> 4, x[11] & 0x0f);
-
-				if (x[12] & 0xfc) {
-					int raw_offset = (x[12] & 0xfc) >> 2;
-					printf("Real max dotclock: %.2fMHz\n",
-					       (x[9] * 10) - (raw_offset * 0.25));
-					if (raw_offset >= 40)
-						warning_excessive_dotclock_correction = 1;
-				}
-
-				max_h_pixels = x[12] & 0x03;
-				max_h_pixels <<= 8;
-				max_h_pixels |= x[13];
-				max_h_pixels *= 8;
-				if (max_h_pixels)
-					printf("Max active pixels per line: %d\n", max_h_pixels);
-
-				printf("Supported aspect ratios: %s %s %s %s %s\n",
-				       x[14] & 0x80 ? "4:3" : "",
-				       x[14] & 0x40 ? "16:9" : "",
-				       x[14] & 0x20 ? "16:10" : "",
-				       x[14] & 0x10 ? "5:4" : "",
-				       x[14] & 0x08 ? "15:9" : "");
-				if (x[14] & 0x07)
-					has_valid_range_descriptor = 0;
-
-				printf("Preferred aspect ratio: ");
-				switch((x[15] & 0xe0) >> 5) {
-				case 0x00: printf("4:3"); break;
-				case 0x01: printf("16:9"); break;
-				case 0x02: printf("16:10"); break;
-				case 0x03: printf("5:4"); break;
-				case 0x04: printf("15:9"); break;
-				default: printf("(broken)"); break;
-				}
-				printf("\n");
-
-				if (x[15] & 0x08)
-					printf("Supports CVT standard blanking\n");
-				if (x[15] & 0x10)
-					printf("Supports CVT reduced blanking\n");
-
-				if (x[15] & 0x07)
-					has_valid_range_descriptor = 0;
-
-				if (x[16] & 0xf0) {
-					printf("Supported display scaling:\n");
-					if (x[16] & 0x80)
-						printf("    Horizontal shrink\n");
-					if (x[16] & 0x40)
-						printf("    Horizontal stretch\n");
-					if (x[16] & 0x20)
-						printf("    Vertical shrink\n");
-					if (x[16] & 0x10)
-						printf("    Vertical stretch\n");
-				}
-
-				if (x[16] & 0x0f)
-					has_valid_range_descriptor = 0;
-
-				if (x[17])
-					printf("Preferred vertical refresh: %d Hz\n", x[17]);
-				else
-					warning_zero_preferred_refresh = 1;
-			}
+static unsigned char *parse_hex(const char *start, const char *end,
+				unsigned *edid_size)
+{
+	unsigned char *out;
+	int out_index = 0;
+	const char *c;
+	unsigned n;
+
+	out = malloc((end - start + 1) >> 1);
+	if (out == NULL)
+		return NULL;
 
-			/*
-			 * Slightly weird to return a global, but I've never seen any
-			 * EDID block wth two range descriptors, so it's harmless.
-			 */
-			return has_valid_range_descriptor;
+	for (c = start; *c; ) {
+		if (!isxdigit(*c) || (*c == '0' && tolower(c[1]) == 'x')) {
+			c++;
+			continue;
 		}
-		case 0xFE:
-			/*
-			 * TODO: Two of these in a row, in the third and fourth slots,
-			 * seems to be specified by SPWG: http://www.spwg.org/
-			 */
-			has_ascii_string = 1;
-			printf("ASCII string: %s\n",
-			       extract_string("Alphanumeric Data String", x + 5, &has_valid_ascii_string, 13));
-			return 1;
-		case 0xFF:
-			has_serial_string = 1;
-			printf("Serial number: %s\n",
-			       extract_string("Display Product Serial Number", x + 5, &has_valid_serial_string, 13));
-			return 1;
-		default:
-			printf("Unknown monitor description type %d\n", x[3]);
-			return 0;
+
+		/* Read a run of %02x from the log */
+		n = hex_decode(out + out_index, c, end, (end - c) / 2);
+		out_index += n;
+		c += 2 * n;
+		if (isxdigit(*c) && !(*c == '0' && tolower(c[1]) == 'x')) {
+			free(out);
+			return NULL;
 		}
 	}
 
-	if (seen_non_detailed_descriptor && !in_extension) {
-		has_valid_descriptor_ordering = 0;
-	}
+	*edid_size = out_index & ~15;
+	return out;
+}
 
-	did_detailed_timing = 1;
-	ha = (x[2] + ((x[4] & 0xF0) << 4));
-	hbl = (x[3] + ((x[4] & 0x0F) << 8));
-	hso = (x[8] + ((x[11] & 0xC0) << 2));
-	hspw = (x[9] + ((x[11] & 0x30) << 4));
-	hborder = x[15];
-	va = (x[5] + ((x[7] & 0xF0) << 4));
-	vbl = (x[6] + ((x[7] & 0x0F) << 8));
-	vso = ((x[10] >> 4) + ((x[11] & 0x0C) << 2));
-	vspw = ((x[10] & 0x0F) + ((x[11] & 0x03) << 4));
-	vborder = x[16];
-	switch ((x[17] & 0x18) >> 3) {
-	case 0x00:
-		syncmethod = " analog composite";
-		break;
-	case 0x01:
-		syncmethod = " bipolar analog composite";
-		break;
-	case 0x02:
-		syncmethod = " digital composite";
-		break;
-	case 0x03:
-		syncmethod = "";
-		break;
-	}
-	pvsync = (x[17] & (1 << 2)) ? '+' : '-';
-	phsync = (x[17] & (1 << 1)) ? '+' : '-';
-	switch (x[17] & 0x61) {
-	case 0x20:
-		stereo = "field sequential L/R";
-		break;
-	case 0x40:
-		stereo = "field sequential R/L";
-		break;
-	case 0x21:
-		stereo = "interleaved right even";
-		break;
-	case 0x41:
-		stereo = "interleaved left even";
-		break;
-	case 0x60:
-		stereo = "four way interleaved";
-		break;
-	case 0x61:
-		stereo = "side by side interleaved";
-		break;
-	default:
-		stereo = "";
-		break;
-	}
+/*
+ * Xorg and kernel logs, such as dmesg or journalctl output, are parsed
+ * line by line. A line that ends in "EDID (in hex):" (Xorg) or in
+ * "Raw EDID:" (the DRM core, for a block it rejects) starts an EDID, and
+ * the lines that follow it with 16 bytes in hex at their end, after the
+ * log prefix, are its contents. Any other line ends it. Each EDID found
+ * is passed to log->found(), with the number of its first line.
+ */
+struct edid_log {
+	unsigned char *edid;	/* where the EDID being read is stored */
+	unsigned size;
+	unsigned max_size;
+	unsigned long line;	/* the number of the current line */
+	unsigned long start;	/* the line that started the EDID */
+	int in_edid;
+	void (*found)(struct edid_log *log, void *priv);
+	void *priv;
+};
 
-	if (!ha || !hbl || !va || !vbl) {
-		printf("Invalid Detailed Timings:\n"
-		       "  Horizontal Active/Blanking %d/%d\n"
-		       "  Vertical Active/Blanking %d/%d\n",
-		       ha, hbl, va, vbl);
-		return 0;
+static int log_edid_start(const char *line, const char *end)
+{
+	static const char * const markers[] = {
+		"EDID (in hex):",
+		"Raw EDID:",
+	};
+	unsigned i;
+
+	while (end > line && isspace((unsigned char)end[-1]))
+		end--;
+	for (i = 0; i < ARRAY_SIZE(markers); i++) {
+		size_t len = strlen(markers[i]);
+
+		if ((size_t)(end - line) >= len &&
+		    !memcmp(end - len, markers[i], len))
+			return 1;
 	}
-
-	pixclk_khz = (x[0] + (x[1] << 8)) * 10;
-	refresh = (pixclk_khz * 1000) / ((ha + hbl) * (va + vbl));
-	printf("Detailed mode: Clock %.3f MHz, %d mm x %d mm\n"
-	       "               %4d %4d %4d %4d hborder %d\n"
-	       "               %4d %4d %4d %4d vborder %d\n"
-	       "               %chsync %cvsync%s%s %s\n"
-	       "               VertFreq: %d Hz, HorFreq: %d Hz\n",
-	       pixclk_khz / 1000.0,
-	       (x[12] + ((x[14] & 0xF0) << 4)),
-	       (x[13] + ((x[14] & 0x0F) << 8)),
-	       ha, ha + hso, ha + hso + hspw, ha + hbl, hborder,
-	       va, va + vso, va + vso + vspw, va + vbl, vborder,
-	       phsync, pvsync, syncmethod, x[17] & 0x80 ? " interlaced" : "",
-	       stereo, refresh, (pixclk_khz * 1000) / (ha + hbl)
-	      );
-	min_vert_freq_hz = min(min_vert_freq_hz, refresh);
-	max_vert_freq_hz = max(max_vert_freq_hz, refresh);
-	min_hor_freq_hz = min(min_hor_freq_hz, (pixclk_khz * 1000) / (ha + hbl));
-	max_hor_freq_hz = max(max_hor_freq_hz, (pixclk_khz * 1000) / (ha + hbl));
-	max_pixclk_khz = max(max_pixclk_khz, pixclk_khz);
-	/* XXX flag decode */
-
-	return 1;
+	return 0;
 }
 
-static int do_checksum(const unsigned char *x, size_t len)
+/*
+ * Convert the 16 bytes at the end of a line of an EDID in a log: 32 hex
+ * digits as written by Xorg, or 16 pairs of them separated by spaces as
+ * written by print_hex_dump(). Returns 0 if the line does not end so.
+ */
+static int log_edid_line(unsigned char *out, const char *line, const char *end)
 {
-	unsigned char check = x[len - 1];
-	unsigned char sum = 0;
-	int i;
-
-	printf("Checksum: 0x%hx", check);
-
-	for (i = 0; i < len-1; i++)
-		sum += x[i];
-
-	if ((unsigned char)(check + sum) != 0) {
-		printf(" (should be 0x%hx)\n", -sum & 0xff);
+	const char *p;
+	unsigned i;
+
+	while (end > line && isspace((unsigned char)end[-1]))
+		end--;
+	if (end - line > 32 && isspace((unsigned char)end[-33]) &&
+	    hex_decode(out, end - 32, end, 16) == 16)
+		return 1;
+	if (end - line <= 47 || !isspace((unsigned char)end[-48]))
 		return 0;
-	}
-
-	printf(" (valid)\n");
+	for (i = 0, p = end - 47; i < 16; i++, p += 3)
+		if ((i && p[-1] != ' ') || hex_decode(out + i, p, p + 2, 1) != 1)
+			return 0;
 	return 1;
 }
 
-/* CTA extension */
-
-static const char *audio_ext_format(unsigned char x)
+/* Feed the line from line up to end, without its newline, to the parser */
+static void log_line(struct edid_log *log, const char *line, const char *end)
 {
-	switch (x) {
-	case 4: return "MPEG-4 HE AAC";
-	case 5: return "MPEG-4 HE AAC v2";
-	case 6: return "MPEG-4 AAC LC";
-	case 7: return "DRA";
-	case 8: return "MPEG-4 HE AAC + MPEG Surround";
-	case 10: return "MPEG-4 AAC LC + MPEG Surround";
-	case 11: return "MPEG-H 3D Audio";
-	case 12: return "AC-4";
-	case 13: return "L-PCM 3D Audio";
-	default: return "RESERVED";
+	log->line++;
+	if (log->in_edid) {
+		if (log->size + 16 <= log->max_size &&
+		    log_edid_line(log->edid + log->size, line, end)) {
+			log->size += 16;
+			return;
+		}
+		log->in_edid = 0;
+		if (log->size)
+			log->found(log, log->priv);
+	}
+	if (log_edid_start(line, end)) {
+		log->in_edid = 1;
+		log->size = 0;
+		log->start = log->line;
 	}
-	return "BROKEN"; /* can't happen */
 }
 
-static const char *audio_format(unsigned char x)
+/* At the end of the log, pass on the EDID that was still being read */
+static void log_end(struct edid_log *log)
 {
-	switch (x) {
-	case 0: return "RESERVED";
-	case 1: return "Linear PCM";
-	case 2: return "AC-3";
-	case 3: return "MPEG 1 (Layers 1 & 2)";
-	case 4: return "MPEG 1 Layer 3 (MP3)";
-	case 5: return "MPEG2 (multichannel)";
-	case 6: return "AAC";
-	case 7: return "DTS";
-	case 8: return "ATRAC";
-	case 9: return "One Bit Audio";
-	case 10: return "Dolby Digital+";
-	case 11: return "DTS-HD";
-	case 12: return "MAT (MLP)";
-	case 13: return "DST";
-	case 14: return "WMA Pro";
-	case 15: return "RESERVED";
-	}
-	return "BROKEN"; /* can't happen */
+	if (log->in_edid && log->size)
+		log->found(log, log->priv);
+	log->in_edid = 0;
 }
 
-static const char *mpeg_h_3d_audio_level(unsigned char x)
+static void log_add_edid(struct edid_log *log, void *priv)
 {
-	switch (x) {
-	case 0: return "Unspecified";
-	case 1: return "Level 1";
-	case 2: return "Level 2";
-	case 3: return "Level 3";
-	case 4: return "Level 4";
-	case 5: return "Level 5";
-	case 6: return "Reserved";
-	case 7: return "Reserved";
-	}
-	return "BROKEN"; /* can't happen */
+	struct edid_input *in = priv;
+	struct edid_entry *e;
+
+	e = realloc(in->edids, (in->num_edids + 1) * sizeof(*e));
+	if (!e) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	in->edids = e;
+	e = &in->edids[in->num_edids++];
+	memset(e, 0, sizeof(*e));
+	e->edid = log->edid;
+	e->size = log->size;
+	e->line = log->start;
+	log->edid += log->size;
+	log->max_size -= log->size;
 }
 
-static void cta_audio_block(const unsigned char *x, unsigned int length)
+/* Collect every EDID of an Xorg or kernel log read into memory */
+static int parse_log(struct edid_input *in)
 {
-	int i, format, ext_format = 0;
+	struct edid_log log;
+	const char *line, *next;
+	unsigned char *out;
 
-	if (length % 3) {
-		printf("Broken CTA audio block length %d\n", length);
-		/* XXX non-conformant */
-		return;
+	/* an upper bound: two hex digits per byte */
+	out = malloc(in->len / 2 + 1);
+	if (!out)
+		return -1;
+	memset(&log, 0, sizeof(log));
+	log.edid = out;
+	log.max_size = in->len / 2 + 1;
+	log.found = log_add_edid;
+	log.priv = in;
+
+	for (line = in->data; *line; line = next) {
+		const char *nl = strchr(line, '\n');
+
+		next = nl ? nl + 1 : line + strlen(line);
+		log_line(&log, line, nl ? nl : next);
 	}
+	log_end(&log);
 
-	for (i = 0; i < length; i += 3) {
-		format = (x[i] & 0x78) >> 3;
-		ext_format = (x[i + 2] & 0xf8) >> 3;
-		if (format != 15)
-			printf("    %s, max channels %d\n", audio_format(format),
-			       (x[i] & 0x07)+1);
-		else if (ext_format == 11)
-			printf("    %s, MPEG-H 3D Audio Level: %s\n", audio_ext_format(ext_format),
-			       mpeg_h_3d_audio_level(x[i] & 0x07));
-		else if (ext_format == 13)
-			printf("    %s, max channels %d\n", audio_ext_format(ext_format),
-			       (((x[i + 1] & 0x80) >> 3) | ((x[i] & 0x80) >> 4) |
-				(x[i] & 0x07))+1);
-		else
-			printf("    %s, max channels %d\n", audio_ext_format(ext_format),
-			       (x[i] & 0x07)+1);
-		printf("      Supported sample rates (kHz):%s%s%s%s%s%s%s\n",
-		       (x[i+1] & 0x40) ? " 192" : "",
-		       (x[i+1] & 0x20) ? " 176.4" : "",
-		       (x[i+1] & 0x10) ? " 96" : "",
-		       (x[i+1] & 0x08) ? " 88.2" : "",
-		       (x[i+1] & 0x04) ? " 48" : "",
-		       (x[i+1] & 0x02) ? " 44.1" : "",
-		       (x[i+1] & 0x01) ? " 32" : "");
-		if (format == 1 || ext_format == 13) {
-			printf("      Supported sample sizes (bits):%s%s%s\n",
-			       (x[i+2] & 0x04) ? " 24" : "",
-			       (x[i+2] & 0x02) ? " 20" : "",
-			       (x[i+2] & 0x01) ? " 16" : "");
-		} else if (format <= 8) {
-			printf("      Maximum bit rate: %d kb/s\n", x[i+2] * 8);
-		} else if (format == 10) {
-			// As specified by the "Dolby Audio and Dolby Atmos over HDMI"
-			// specification (v1.0).
-			if(x[i+2] & 1)
-				printf("      Supports Joint Object Coding\n");
-			if(x[i+2] & 2)
-				printf("      Supports Joint Object Coding with ACMOD28\n");
-		} else if (format == 14) {
-			printf("      Profile: %d\n", x[i+2] & 7);
-		} else if (ext_format == 11 && (x[i+2] & 1)) {
-			printf("      Supports MPEG-H 3D Audio Low Complexity Profile\n");
-		} else if ((ext_format >= 4 && ext_format <= 6) ||
-			   ext_format == 8 || ext_format == 10) {
-			printf("      AAC audio frame lengths:%s%s\n",
-			       (x[i+2] & 4) ? " 1024_TL" : "",
-			       (x[i+2] & 2) ? " 960_TL" : "");
-			if (ext_format >= 8 && (x[i+2] & 1))
-				printf("      Supports %s signaled MPEG Surround data\n",
-				       (x[i+2] & 1) ? "implicitly and explicitly" : "only implicitly");
-			if (ext_format == 6 && (x[i+2] & 1))
-				printf("      Supports 22.2ch System H\n");
-		}
+	if (!in->num_edids) {
+		free(in->edids);
+		in->edids = NULL;
+		free(out);
+		return -1;
 	}
-}
-
-struct edid_cta_mode {
-	const char *name;
-	int refresh, hor_freq_hz, pixclk_khz;
-};
-
-static struct edid_cta_mode edid_cta_modes1[] = {
-	/* VIC 1 */
-	{"640x480@60Hz 4:3", 60, 31469, 25175},
-	{"720x480@60Hz 4:3", 60, 31469, 27000},
-	{"720x480@60Hz 16:9", 60, 31469, 27000},
-	{"1280x720@60Hz 16:9", 60, 45000, 74250},
-	{"1920x1080i@60Hz 16:9", 60, 33750, 74250},
-	{"1440x480i@60Hz 4:3", 60, 15734, 27000},
-	{"1440x480i@60Hz 16:9", 60, 15734, 27000},
-	{"1440x240@60Hz 4:3", 60, 15734, 27000},
-	{"1440x240@60Hz 16:9", 60, 15734, 27000},
-	{"2880x480i@60Hz 4:3", 60, 15734, 54000},
-	/* VIC 11 */
-	{"2880x480i@60Hz 16:9", 60, 15734, 54000},
-	{"2880x240@60Hz 4:3", 60, 15734, 54000},
-	{"2880x240@60Hz 16:9", 60, 15734, 54000},
-	{"1440x480@60Hz 4:3", 60, 31469, 54000},
-	{"1440x480@60Hz 16:9", 60, 31469, 54000},
-	{"1920x1080@60Hz 16:9", 60, 67500, 148500},
-	{"720x576@50Hz 4:3", 50, 31250, 27000},
-	{"720x576@50Hz 16:9", 50, 31250, 27000},
-	{"1280x720@50Hz 16:9", 50, 37500, 74250},
-	{"1920x1080i@50Hz 16:9", 50, 28125, 74250},
-	/* VIC 21 */
-	{"1440x576i@50Hz 4:3", 50, 15625, 27000},
-	{"1440x576i@50Hz 16:9", 50, 15625, 27000},
-	{"1440x288@50Hz 4:3", 50, 15625, 27000},
-	{"1440x288@50Hz 16:9", 50, 15625, 27000},
-	{"2880x576i@50Hz 4:3", 50, 15625, 54000},
-	{"2880x576i@50Hz 16:9", 50, 15625, 54000},
-	{"2880x288@50Hz 4:3", 50, 15625, 54000},
-	{"2880x288@50Hz 16:9", 50, 15625, 54000},
-	{"1440x576@50Hz 4:3", 50, 31250, 54000},
-	{"1440x576@50Hz 16:9", 50, 31250, 54000},
-	/* VIC 31 */
-	{"1920x1080@50Hz 16:9", 50, 56250, 148500},
-	{"1920x1080@24Hz 16:9", 24, 27000, 74250},
-	{"1920x1080@25Hz 16:9", 25, 28125, 74250},
-	{"1920x1080@30Hz 16:9", 30, 33750, 74250},
-	{"2880x480@60Hz 4:3", 60, 31469, 108000},
-	{"2880x480@60Hz 16:9", 60, 31469, 108000},
-	{"2880x576@50Hz 4:3", 50, 31250, 108000},
-	{"2880x576@50Hz 16:9", 50, 31250, 108000},
-	{"1920x1080i@50Hz 16:9", 50, 31250, 72000},
-	{"1920x1080i@100Hz 16:9", 100, 56250, 148500},
-	/* VIC 41 */
-	{"1280x720@100Hz 16:9", 100, 75000, 148500},
-	{"720x576@100Hz 4:3", 100, 62500, 54000},
-	{"720x576@100Hz 16:9", 100, 62500, 54000},
-	{"1440x576@100Hz 4:3", 100, 31250, 54000},
-	{"1440x576@100Hz 16:9", 100, 31250, 54000},
-	{"1920x1080i@120Hz 16:9", 120, 67500, 148500},
-	{"1280x720@120Hz 16:9", 120, 90000, 148500},
-	{"720x480@120Hz 4:3", 120, 62937, 54000},
-	{"720x480@120Hz 16:9", 120, 62937, 54000},
-	{"1440x480i@120Hz 4:3", 120, 31469, 54000},
-	/* VIC 51 */
-	{"1440x480i@120Hz 16:9", 120, 31469, 54000},
-	{"720x576@200Hz 4:3", 200, 125000, 108000},
-	{"720x576@200Hz 16:9", 200, 125000, 108000},
-	{"1440x576i@200Hz 4:3", 200, 62500, 108000},
-	{"1440x576i@200Hz 16:9", 200, 62500, 108000},
-	{"720x480@240Hz 4:3", 240, 125874, 108000},
-	{"720x480@240Hz 16:9", 240, 125874, 108000},
-	{"1440x480i@240Hz 4:3", 240, 62937, 108000},
-	{"1440x480i@240Hz 16:9", 240, 62937, 108000},
-	{"1280x720@24Hz 16:9", 24, 18000, 59400},
-	/* VIC 61 */
-	{"1280x720@25Hz 16:9", 25, 18750, 74250},
-	{"1280x720@30Hz 16:9", 30, 22500, 74250},
-	{"1920x1080@120Hz 16:9", 120, 135000, 297000},
-	{"1920x1080@100Hz 16:9", 100, 112500, 297000},
-	{"1280x720@24Hz 64:27", 24, 18000, 59400},
-	{"1280x720@25Hz 64:27", 25, 18750, 74250},
-	{"1280x720@30Hz 64:27", 30, 22500, 74250},
-	{"1280x720@50Hz 64:27", 50, 37500, 74250},
-	{"1280x720@60Hz 64:27", 60, 45000, 74250},
-	{"1280x720@100Hz 64:27", 100, 75000, 148500},
-	/* VIC 71 */
-	{"1280x720@120Hz 64:27", 120, 91000, 148500},
-	{"1920x1080@24Hz 64:27", 24, 27000, 74250},
-	{"1920x1080@25Hz 64:27", 25, 28125, 74250},
-	{"1920x1080@30Hz 64:27", 30, 33750, 74250},
-	{"1920x1080@50Hz 64:27", 50, 56250, 148500},
-	{"1920x1080@60Hz 64:27", 60, 67500, 148500},
-	{"1920x1080@100Hz 64:27", 100, 112500, 297000},
-	{"1920x1080@120Hz 64:27", 120, 135000, 297000},
-	{"1680x720@24Hz 64:27", 24, 18000, 59400},
-	{"1680x720@25Hz 64:27", 25, 18750, 59400},
-	/* VIC 81 */
-	{"1680x720@30Hz 64:27", 30, 22500, 59400},
-	{"1680x720@50Hz 64:27", 50, 37500, 82500},
-	{"1680x720@60Hz 64:27", 60, 45000, 99000},
-	{"1680x720@100Hz 64:27", 100, 82500, 165000},
-	{"1680x720@120Hz 64:27", 120, 99000, 198000},
-	{"2560x1080@24Hz 64:27", 24, 26400, 99000},
-	{"2560x1080@25Hz 64:27", 25, 28125, 90000},
-	{"2560x1080@30Hz 64:27", 30, 33750, 118800},
-	{"2560x1080@50Hz 64:27", 50, 56250, 185625},
-	{"2560x1080@60Hz 64:27", 60, 66000, 198000},
-	/* VIC 91 */
-	{"2560x1080@100Hz 64:27", 100, 125000, 371250},
-	{"2560x1080@120Hz 64:27", 120, 150000, 495000},
-	{"3840x2160@24Hz 16:9", 24, 54000, 297000},
-	{"3840x2160@25Hz 16:9", 25, 56250, 297000},
-	{"3840x2160@30Hz 16:9", 30, 67500, 297000},
-	{"3840x2160@50Hz 16:9", 50, 112500, 594000},
-	{"3840x2160@60Hz 16:9", 60, 135000, 594000},
-	{"4096x2160@24Hz 256:135", 24, 54000, 297000},
-	{"4096x2160@25Hz 256:135", 25, 56250, 297000},
-	{"4096x2160@30Hz 256:135", 30, 67500, 297000},
-	/* VIC 101 */
-	{"4096x2160@50Hz 256:135", 50, 112500, 594000},
-	{"4096x2160@60Hz 256:135", 60, 135000, 594000},
-	{"3840x2160@24Hz 64:27", 24, 54000, 297000},
-	{"3840x2160@25Hz 64:27", 25, 56250, 297000},
-	{"3840x2160@30Hz 64:27", 30, 67500, 297000},
-	{"3840x2160@50Hz 64:27", 50, 112500, 594000},
-	{"3840x2160@60Hz 64:27", 60, 135000, 594000},
-	{"1280x720@48Hz 16:9", 48, 36000, 90000},
-	{"1280x720@48Hz 64:27", 48, 36000, 90000},
-	{"1680x720@48Hz 64:27", 48, 36000, 99000},
-	/* VIC 111 */
-	{"1920x1080@48Hz 16:9", 48, 54000, 148500},
-	{"1920x1080@48Hz 64:27", 48, 54000, 148500},
-	{"2560x1080@48Hz 64:27", 48, 52800, 198000},
-	{"3840x2160@48Hz 16:9", 48, 108000, 594000},
-	{"4096x2160@48Hz 256:135", 48, 108000, 594000},
-	{"3840x2160@48Hz 64:27", 48, 108000, 594000},
-	{"3840x2160@100Hz 16:9", 100, 225000, 1188000},
-	{"3840x2160@120Hz 16:9", 120, 270000, 1188000},
-	{"3840x2160@100Hz 64:27", 100, 225000, 1188000},
-	{"3840x2160@120Hz 64:27", 120, 270000, 1188000},
-	/* VIC 121 */
-	{"5120x2160@24Hz 64:27", 24, 52800, 396000},
-	{"5120x2160@25Hz 64:27", 25, 55000, 396000},
-	{"5120x2160@30Hz 64:27", 30, 66000, 396000},
-	{"5120x2160@48Hz 64:27", 48, 118800, 742500},
-	{"5120x2160@50Hz 64:27", 50, 112500, 742500},
-	{"5120x2160@60Hz 64:27", 60, 135000, 742500},
-	{"5120x2160@100Hz 64:27", 100, 225000, 1485000},
-};
-
-static struct edid_cta_mode edid_cta_modes2[] = {
-	/* VIC 193 */
-	{"5120x2160@120Hz 64:27", 120, 270000, 1485000},
-	{"7680x4320@24Hz 16:9", 24, 108000, 1188000},
-	{"7680x4320@25Hz 16:9", 25, 110000, 1188000},
-	{"7680x4320@30Hz 16:9", 30, 132000, 1188000},
-	{"7680x4320@48Hz 16:9", 48, 216000, 2376000},
-	{"7680x4320@50Hz 16:9", 50, 220000, 2376000},
-	{"7680x4320@60Hz 16:9", 60, 264000, 2376000},
-	{"7680x4320@100Hz 16:9", 100, 450000, 4752000},
-	/* VIC 201 */
-	{"7680x4320@120Hz 16:9", 120, 540000, 4752000},
-	{"7680x4320@24Hz 64:27", 24, 108000, 1188000},
-	{"7680x4320@25Hz 64:27", 25, 110000, 1188000},
-	{"7680x4320@30Hz 64:27", 30, 132000, 1188000},
-	{"7680x4320@48Hz 64:27", 48, 216000, 2376000},
-	{"7680x4320@50Hz 64:27", 50, 220000, 2376000},
-	{"7680x4320@60Hz 64:27", 60, 264000, 2376000},
-	{"7680x4320@100Hz 64:27", 100, 450000, 4752000},
-	{"7680x4320@120Hz 64:27", 120, 540000, 4752000},
-	{"10240x4320@24Hz 64:27", 24, 118800, 1485000},
-	/* VIC 211 */
-	{"10240x4320@25Hz 64:27", 25, 110000, 1485000},
-	{"10240x4320@30Hz 64:27", 30, 135000, 1485000},
-	{"10240x4320@48Hz 64:27", 48, 237600, 2970000},
-	{"10240x4320@50Hz 64:27", 50, 220000, 2970000},
-	{"10240x4320@60Hz 64:27", 60, 270000, 2970000},
-	{"10240x4320@100Hz 64:27", 100, 450000, 5940000},
-	{"10240x4320@120Hz 64:27", 120, 540000, 5940000},
-	{"4096x2160@100Hz 256:135", 100, 225000, 1188000},
-	{"4096x2160@120Hz 256:135", 120, 270000, 1188000},
-};
-
-static const struct edid_cta_mode *vic_to_mode(unsigned char vic)
-{
-	if (vic > 0 && vic <= ARRAY_SIZE(edid_cta_modes1))
-		return edid_cta_modes1 + vic - 1;
-	if (vic >= 193 && vic <= ARRAY_SIZE(edid_cta_modes2) + 193)
-		return edid_cta_modes2 + vic - 193;
-	return NULL;
-}
-
-static void cta_svd(const unsigned char *x, int n, int for_ycbcr420)
-{
-	int i;
-
-	for (i = 0; i < n; i++)  {
-		const struct edid_cta_mode *vicmode = NULL;
-		unsigned char svd = x[i];
-		unsigned char native;
-		unsigned char vic;
-		const char *mode;
-		unsigned hfreq = 0;
-		unsigned clock_khz = 0;
-
-		if ((svd & 0x7f) == 0)
-			continue;
-
-		if ((svd - 1) & 0x40) {
-			vic = svd;
-			native = 0;
-		} else {
-			vic = svd & 0x7f;
-			native = svd & 0x80;
-		}
-
-		vicmode = vic_to_mode(vic);
-		if (vicmode) {
-			switch (vic) {
-			case 95:
-				supported_hdmi_vic_vsb_codes |= 1 << 0;
-				break;
-			case 94:
-				supported_hdmi_vic_vsb_codes |= 1 << 1;
-				break;
-			case 93:
-				supported_hdmi_vic_vsb_codes |= 1 << 2;
-				break;
-			case 98:
-				supported_hdmi_vic_vsb_codes |= 1 << 3;
-				break;
-			}
-			mode = vicmode->name;
-			min_vert_freq_hz = min(min_vert_freq_hz, vicmode->refresh);
-			max_vert_freq_hz = max(max_vert_freq_hz, vicmode->refresh);
-			hfreq = vicmode->hor_freq_hz;
-			min_hor_freq_hz = min(min_hor_freq_hz, hfreq);
-			max_hor_freq_hz = max(max_hor_freq_hz, hfreq);
-			clock_khz = vicmode->pixclk_khz / (for_ycbcr420 ? 2 : 1);
-			max_pixclk_khz = max(max_pixclk_khz, clock_khz);
-		} else {
-			mode = "Unknown mode";
-		}
-
-		printf("    VIC %3d %s %s HorFreq: %d Hz Clock: %.3f MHz\n",
-		       vic, mode, native ? "(native)" : "", hfreq, clock_khz / 1000.0);
-		if (vic == 1)
-			has_cta861_vic_1 = 1;
+	in->alloc = out;
+	if (in->num_edids == 1) {
+		in->one = in->edids[0];
+		free(in->edids);
+		in->edids = &in->one;
 	}
+	return 0;
 }
 
-static void cta_video_block(const unsigned char *x, unsigned int length)
-{
-	cta_svd(x, length, 0);
-}
-
-static void cta_y420vdb(const unsigned char *x, unsigned int length)
+/*
+ * Find the EDIDs in the input. A raw binary EDID is used in place, text
+ * is converted into in->alloc. Returns -1 if the text could not be parsed.
+ */
+static int extract_edid(struct edid_input *in)
 {
-	cta_svd(x, length, 1);
+	const char *ret = in->data;
+	const char *end = ret + in->len;
+	unsigned char *out = (unsigned char *)ret;
+	const char *start;
+	unsigned size = 0;
+
+	switch (detect_input(ret, &start)) {
+	case INPUT_XRANDR:
+		return parse_xrandr(in);
+	case INPUT_QUANTUMDATA:
+		out = parse_quantumdata(start, end, &size);
+		break;
+	case INPUT_HEX:
+		out = parse_hex(start, end, &size);
+		break;
+	case INPUT_RAW:
+		size = in->len & ~15;
+		break;
+	case INPUT_LOG:
+		return parse_log(in);
+	default:
+		break;
+	}
+	if (!out)
+		return -1;
+	if (out != (unsigned char *)ret)
+		in->alloc = out;
+	in->one.edid = out;
+	in->one.size = size;
+	in->edids = &in->one;
+	in->num_edids = 1;
+	return 0;
 }
 
-static void cta_y420cmdb(const unsigned char *x, unsigned int length)
+static unsigned char crc_calc(const unsigned char *b)
 {
+	unsigned char sum = 0;
 	int i;
 
-	for (i = 0; i < length; i++) {
-		uint8_t v = x[0 + i];
-		int j;
-
-		for (j = 0; j < 8; j++)
-			if (v & (1 << j))
-				printf("    VSD Index %d\n", i * 8 + j);
-	}
+	for (i = 0; i < 127; i++)
+		sum += b[i];
+	return 256 - sum;
 }
 
-static void cta_vfpdb(const unsigned char *x, unsigned int length)
+static int crc_ok(const unsigned char *b)
 {
-	int i;
-
-	for (i = 0; i < length; i++)  {
-		unsigned char svr = x[i];
-
-		if ((svr > 0 && svr < 128) || (svr > 192 && svr < 254)) {
-			const struct edid_cta_mode *vicmode;
-			unsigned char vic;
-			const char *mode;
-
-			vic = svr;
-
-			vicmode = vic_to_mode(vic);
-			if (vicmode)
-				mode = vicmode->name;
-			else
-				mode = "Unknown mode";
-
-			printf("    VIC %02d %s\n", vic, mode);
-
-		} else if (svr > 128 && svr < 145) {
-			printf("    DTD number %02d\n", svr - 128);
-		}
-	}
+	return crc_calc(b) == b[127];
 }
 
-static struct {
-	const char *name;
-	int refresh, hor_freq_hz, pixclk_khz;
-} edid_hdmi_modes[] = {
-	{"3840x2160@30Hz 16:9", 30, 67500, 297000},
-	{"3840x2160@25Hz 16:9", 25, 56250, 297000},
-	{"3840x2160@24Hz 16:9", 24, 54000, 297000},
-	{"4096x2160@24Hz 256:135", 24, 54000, 297000},
-};
-
-static void cta_hdmi_block(const unsigned char *x, unsigned int length)
+static void hexdumpedid(FILE *f, const unsigned char *edid, unsigned size)
 {
-	int mask = 0, formats = 0;
-	int len_vic, len_3d;
-	int b = 0;
-
-	printf(" (HDMI)\n");
-	printf("    Source physical address %d.%d.%d.%d\n", x[3] >> 4, x[3] & 0x0f,
-	       x[4] >> 4, x[4] & 0x0f);
+	static const char hex[] = "0123456789abcdef";
+	/* 8 lines of 48 characters and a checksum error line per block */
+	char *buf = malloc(size / 128 * (8 * 48 + 64) + 1);
+	char *p = buf;
+	unsigned b, i;
 
-	if (length < 6)
+	if (!buf)
 		return;
+	for (b = 0; b < size / 128; b++) {
+		const unsigned char *x = edid + 128 * b;
 
-	if (x[5] & 0x80)
-		printf("    Supports_AI\n");
-	if (x[5] & 0x40)
-		printf("    DC_48bit\n");
-	if (x[5] & 0x20)
-		printf("    DC_36bit\n");
-	if (x[5] & 0x10)
-		printf("    DC_30bit\n");
-	if (x[5] & 0x08)
-		printf("    DC_Y444\n");
-	/* two reserved */
-	if (x[5] & 0x01)
-		printf("    DVI_Dual\n");
-
-	if (length < 7)
-		return;
-
-	printf("    Maximum TMDS clock: %dMHz\n", x[6] * 5);
-	if (x[6] * 5 > 340)
-		nonconformant_hdmi_vsdb_tmds_rate = 1;
-
-	/* XXX the walk here is really ugly, and needs to be length-checked */
-	if (length < 8)
-		return;
-
-	if (x[7] & 0x0f) {
-		printf("    Supported Content Types:\n");
-		if (x[7] & 0x01)
-			printf("      Graphics\n");
-		if (x[7] & 0x02)
-			printf("      Photo\n");
-		if (x[7] & 0x04)
-			printf("      Cinema\n");
-		if (x[7] & 0x08)
-			printf("      Game\n");
-	}
-
-	if (x[7] & 0x80) {
-		printf("    Video latency: %d\n", x[8 + b]);
-		printf("    Audio latency: %d\n", x[9 + b]);
-		b += 2;
-
-		if (x[7] & 0x40) {
-			printf("    Interlaced video latency: %d\n", x[8 + b]);
-			printf("    Interlaced audio latency: %d\n", x[9 + b]);
-			b += 2;
-		}
-	}
-
-	if (!(x[7] & 0x20))
-		return;
-
-	printf("    Extended HDMI video details:\n");
-	if (x[8 + b] & 0x80)
-		printf("      3D present\n");
-	if ((x[8 + b] & 0x60) == 0x20) {
-		printf("      All advertised VICs are 3D-capable\n");
-		formats = 1;
-	}
-	if ((x[8 + b] & 0x60) == 0x40) {
-		printf("      3D-capable-VIC mask present\n");
-		formats = 1;
-		mask = 1;
-	}
-	switch (x[8 + b] & 0x18) {
-	case 0x00: break;
-	case 0x08:
-		   printf("      Base EDID image size is aspect ratio\n");
-		   break;
-	case 0x10:
-		   printf("      Base EDID image size is in units of 1cm\n");
-		   break;
-	case 0x18:
-		   printf("      Base EDID image size is in units of 5cm\n");
-		   break;
-	}
-	len_vic = (x[9 + b] & 0xe0) >> 5;
-	len_3d = (x[9 + b] & 0x1f) >> 0;
-	b += 2;
-
-	if (len_vic) {
-		unsigned hfreq = 0;
-		unsigned clock_khz = 0;
-		int i;
-
-		for (i = 0; i < len_vic; i++) {
-			unsigned char vic = x[8 + b + i];
-			const char *mode;
-
-			if (vic && vic <= ARRAY_SIZE(edid_hdmi_modes)) {
-				supported_hdmi_vic_codes |= 1 << (vic - 1);
-				mode = edid_hdmi_modes[vic - 1].name;
-				min_vert_freq_hz = min(min_vert_freq_hz, edid_hdmi_modes[vic - 1].refresh);
-				max_vert_freq_hz = max(max_vert_freq_hz, edid_hdmi_modes[vic - 1].refresh);
-				hfreq = edid_hdmi_modes[vic - 1].hor_freq_hz;
-				min_hor_freq_hz = min(min_hor_freq_hz, hfreq);
-				max_hor_freq_hz = max(max_hor_freq_hz, hfreq);
-				clock_khz = edid_hdmi_modes[vic - 1].pixclk_khz;
-				max_pixclk_khz = max(max_pixclk_khz, clock_khz);
-			} else {
-				mode = "Unknown mode";
-			}
-
-			printf("      HDMI VIC %d %s HorFreq: %d Hz Clock: %.3f MHz\n",
-			       vic, mode, hfreq, clock_khz / 1000.0);
-		}
-
-		b += len_vic;
-	}
-
-	if (len_3d) {
-		if (formats) {
-			/* 3D_Structure_ALL_15..8 */
-			if (x[8 + b] & 0x80)
-				printf("      3D: Side-by-side (half, quincunx)\n");
-			if (x[8 + b] & 0x01)
-				printf("      3D: Side-by-side (half, horizontal)\n");
-			/* 3D_Structure_ALL_7..0 */
-			if (x[9 + b] & 0x40)
-				printf("      3D: Top-and-bottom\n");
-			if (x[9 + b] & 0x20)
-				printf("      3D: L + depth + gfx + gfx-depth\n");
-			if (x[9 + b] & 0x10)
-				printf("      3D: L + depth\n");
-			if (x[9 + b] & 0x08)
-				printf("      3D: Side-by-side (full)\n");
-			if (x[9 + b] & 0x04)
-				printf("      3D: Line-alternative\n");
-			if (x[9 + b] & 0x02)
-				printf("      3D: Field-alternative\n");
-			if (x[9 + b] & 0x01)
-				printf("      3D: Frame-packing\n");
-			b += 2;
-			len_3d -= 2;
-		}
-		if (mask) {
-			int i;
-			printf("      3D VIC indices:");
-			/* worst bit ordering ever */
-			for (i = 0; i < 8; i++)
-				if (x[9 + b] & (1 << i))
-					printf(" %d", i);
-			for (i = 0; i < 8; i++)
-				if (x[8 + b] & (1 << i))
-					printf(" %d", i + 8);
-			printf("\n");
-			b += 2;
-			len_3d -= 2;
-		}
-
-		/*
-		 * list of nibbles:
-		 * 2D_VIC_Order_X
-		 * 3D_Structure_X
-		 * (optionally: 3D_Detail_X and reserved)
-		 */
-		if (len_3d > 0) {
-			int end = b + len_3d;
-
-			while (b < end) {
-				printf("      VIC index %d supports ", x[8 + b] >> 4);
-				switch (x[8 + b] & 0x0f) {
-				case 0: printf("frame packing"); break;
-				case 6: printf("top-and-bottom"); break;
-				case 8:
-					if ((x[9 + b] >> 4) == 1) {
-						printf("side-by-side (half, horizontal)");
-						break;
-					}
-				default: printf("unknown");
-				}
-				printf("\n");
-
-				if ((x[8 + b] & 0x0f) > 7) {
-					/* Optional 3D_Detail_X and reserved */
-					b++;
-				}
-				b++;
-			}
+		if (b)
+			*p++ = '\n';
+		for (i = 0; i < 128; i++) {
+			*p++ = hex[x[i] >> 4];
+			*p++ = hex[x[i] & 0xf];
+			*p++ = (i & 0xf) == 0xf ? '\n' : ' ';
 		}
+		if (!crc_ok(x))
+			p += sprintf(p, "Block %u has a checksum error (should be 0x%02x)\n",
+				     b, crc_calc(x));
 	}
+	fwrite(buf, 1, p - buf, f);
+	free(buf);
 }
 
-static const char *max_frl_rates[] = {
-	"Not Supported",
-	"3 Gbps per lane on 3 lanes",
-	"3 and 6 Gbps per lane on 3 lanes",
-	"3 and 6 Gbps per lane on 3 lanes, 6 Gbps on 4 lanes",
-	"3 and 6 Gbps per lane on 3 lanes, 6 and 8 Gbps on 4 lanes",
-	"3 and 6 Gbps per lane on 3 lanes, 6, 8 and 10 Gbps on 4 lanes",
-	"3 and 6 Gbps per lane on 3 lanes, 6, 8, 10 and 12 Gbps on 4 lanes",
-};
-
-static const char *dsc_max_slices[] = {
-	"Not Supported",
-	"up to 1 slice and up to (340 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 2 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 4 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 8 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 8 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 12 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
-	"up to 16 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
-};
-
-static void cta_hf_eeodb(const unsigned char *x, unsigned int length)
+static void carraydumpedid(FILE *f, const unsigned char *edid, unsigned size,
+			   unsigned index)
 {
-	printf("    EDID Extension Block Count: %u\n", x[0]);
-	if (length != 1 || x[0] == 0)
-		nonconformant_hf_eeodb = 1;
-}
-
-static void cta_hf_scdb(const unsigned char *x, unsigned int length)
-{
-	unsigned rate = x[1] * 5;
-
-	printf("    Version: %u\n", x[0]);
-	if (rate) {
-		printf("    Maximum TMDS Character Rate: %uMHz\n", rate);
-		if ((rate && rate <= 340) || rate > 600)
-			nonconformant_hf_vsdb_tmds_rate = 1;
-	}
-	if (x[2] & 0x80)
-		printf("    SCDC Present\n");
-	if (x[2] & 0x40)
-		printf("    SCDC Read Request Capable\n");
-	if (x[2] & 0x10)
-		printf("    Supports Color Content Bits Per Component Indication\n");
-	if (x[2] & 0x08)
-		printf("    Supports scrambling for <= 340 Mcsc\n");
-	if (x[2] & 0x04)
-		printf("    Supports 3D Independent View signaling\n");
-	if (x[2] & 0x02)
-		printf("    Supports 3D Dual View signaling\n");
-	if (x[2] & 0x01)
-		printf("    Supports 3D OSD Disparity signaling\n");
-	if (x[3] & 0xf0) {
-		unsigned max_frl_rate = x[3] >> 4;
-
-		printf("    Max Fixed Rate Link: ");
-		if (max_frl_rate >= ARRAY_SIZE(max_frl_rates))
-			printf("Reserved\n");
-		else
-			printf("%s\n", max_frl_rates[max_frl_rate]);
-		if (max_frl_rate == 1 && rate < 300)
-			nonconformant_hf_vsdb_tmds_rate = 1;
-		else if (max_frl_rate >= 2 && rate < 600)
-			nonconformant_hf_vsdb_tmds_rate = 1;
-	}
-	if (x[3] & 0x08)
-		printf("    Supports UHD VIC\n");
-	if (x[3] & 0x04)
-		printf("    Supports 16-bits/component Deep Color 4:2:0 Pixel Encoding\n");
-	if (x[3] & 0x02)
-		printf("    Supports 12-bits/component Deep Color 4:2:0 Pixel Encoding\n");
-	if (x[3] & 0x01)
-		printf("    Supports 10-bits/component Deep Color 4:2:0 Pixel Encoding\n");
-
-	if (length <= 7)
-		return;
-
-	if (x[4] & 0x20)
-		printf("    Supports Mdelta\n");
-	if (x[4] & 0x10)
-		printf("    Supports media rates below VRRmin (CinemaVRR)\n");
-	if (x[4] & 0x08)
-		printf("    Supports negative Mvrr values\n");
-	if (x[4] & 0x04)
-		printf("    Supports Fast Vactive\n");
-	if (x[4] & 0x02)
-		printf("    Supports Auto Low-Latency Mode\n");
-	if (x[4] & 0x01)
-		printf("    Supports a FAPA in blanking after first active video line\n");
-
-	if (length <= 8)
-		return;
-
-	printf("    VRRmin: %d Hz\n", x[8] & 0x3f);
-	printf("    VRRmax: %d Hz\n", (x[8] & 0xc0) << 2 | x[9]);
-
-	if (length <= 10)
-		return;
+	unsigned b, i, j;
 
-	if (x[7] & 0x80)
-		printf("    Supports VESA DSC 1.2a compression\n");
-	if (x[7] & 0x40)
-		printf("    Supports Compressed Video Transport for 4:2:0 Pixel Encoding\n");
-	if (x[7] & 0x08)
-		printf("    Supports Compressed Video Transport at any valid 1/16th bit bpp\n");
-	if (x[7] & 0x04)
-		printf("    Supports 16 bpc Compressed Video Transport\n");
-	if (x[7] & 0x02)
-		printf("    Supports 12 bpc Compressed Video Transport\n");
-	if (x[7] & 0x01)
-		printf("    Supports 10 bpc Compressed Video Transport\n");
-	if (x[8] & 0xf) {
-		unsigned max_slices = x[8] & 0xf;
-
-		if (max_slices < ARRAY_SIZE(dsc_max_slices))
-			printf("    Supports %s\n", dsc_max_slices[max_slices]);
-	}
-	if (x[8] & 0xf0) {
-		unsigned max_frl_rate = x[8] >> 4;
+	if (index)
+		fprintf(f, "unsigned char edid_%u[] = {\n", index + 1);
+	else
+		fprintf(f, "unsigned char edid[] = {\n");
+	for (b = 0; b < size / 128; b++) {
+		const unsigned char *buf = edid + 128 * b;
 
-		printf("    DSC Max Fixed Rate Link: ");
-		if (max_frl_rate >= ARRAY_SIZE(max_frl_rates))
-			printf("Reserved\n");
-		else
-			printf("%s\n", max_frl_rates[max_frl_rate]);
+		if (b)
+			fprintf(f, "\n");
+		for (i = 0; i < 128; i += 8) {
+			fprintf(f, "\t0x%02x,", buf[i]);
+			for (j = 1; j < 8; j++) {
+				fprintf(f, " 0x%02x,", buf[i + j]);
+			}
+			fprintf(f, "\n");
+		}
+		if (!crc_ok(buf))
+			fprintf(f, "\t/* Block %u has a checksum error (should be 0x%02x) */\n",
+					b, crc_calc(buf));
 	}
-	if (x[9] & 0x3f)
-		printf("    Maximum number of bytes in a line of chunks: %u\n",
-		       1024 * (1 + (x[9] & 0x3f)));
-}
-
-static void cta_hdr10plus(const unsigned char *x, unsigned int length)
-{
-	printf("    Application Version: %u\n", x[0]);
+	fprintf(f, "};\n");
 }
 
-DEFINE_FIELD("YCbCr quantization", YCbCr_quantization, 7, 7,
-	     { 0, "No Data" },
-	     { 1, "Selectable (via AVI YQ)" });
-DEFINE_FIELD("RGB quantization", RGB_quantization, 6, 6,
-	     { 0, "No Data" },
-	     { 1, "Selectable (via AVI Q)" });
-DEFINE_FIELD("PT scan behaviour", PT_scan, 4, 5,
-	     { 0, "No Data" },
-	     { 1, "Always Overscannned" },
-	     { 2, "Always Underscanned" },
-	     { 3, "Support both over- and underscan" });
-DEFINE_FIELD("IT scan behaviour", IT_scan, 2, 3,
-	     { 0, "IT video formats not supported" },
-	     { 1, "Always Overscannned" },
-	     { 2, "Always Underscanned" },
-	     { 3, "Support both over- and underscan" });
-DEFINE_FIELD("CE scan behaviour", CE_scan, 0, 1,
-	     { 0, "CE video formats not supported" },
-	     { 1, "Always Overscannned" },
-	     { 2, "Always Underscanned" },
-	     { 3, "Support both over- and underscan" });
-
-static struct field *vcdb_fields[] = {
-	&YCbCr_quantization,
-	&RGB_quantization,
-	&PT_scan,
-	&IT_scan,
-	&CE_scan,
-};
-
-static const char *speaker_map[] = {
-	"FL/FR - Front Left/Right",
-	"LFE1 - Low Frequency Effects 1",
-	"FC - Front Center",
-	"BL/BR - Back Left/Right",
-	"BC - Back Center",
-	"FLc/FRc - Front Left/Right of Center",
-	"RLC/RRC - Rear Left/Right of Center (Deprecated)",
-	"FLw/FRw - Front Left/Right Wide",
-	"TpFL/TpFR - Top Front Left/Right",
-	"TpC - Top Center",
-	"TpFC - Top Front Center",
-	"LS/RS - Left/Right Surround",
-	"LFE2 - Low Frequency Effects 2",
-	"TpBC - Top Back Center",
-	"SiL/SiR - Side Left/Right",
-	"TpSiL/TpSiR - Top Side Left/Right",
-	"TpBL/TpBR - Top Back Left/Right",
-	"BtFC - Bottom Front Center",
-	"BtFL/BtFR - Bottom Front Left/Right",
-	"TpLS/TpRS - Top Left/Right Surround (Deprecated for CTA-861)",
-	"LSd/RSd - Left/Right Surround Direct (HDMI only)",
-};
-
-static void cta_sadb(const unsigned char *x, unsigned int length)
+/*
+ * Write the EDID in the given format. Several EDIDs are written one after
+ * the other: index counts them, and the text formats separate them with
+ * an empty line.
+ */
+static void write_edid(FILE *f, const unsigned char *edid, unsigned size,
+		       enum output_format out_fmt, unsigned index)
 {
-	uint32_t sad;
-	int i;
-
-	if (length < 3)
-		return;
-
-	sad = ((x[2] << 16) | (x[1] << 8) | x[0]);
-
-	printf("    Speaker map:\n");
-
-	for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
-		if ((sad >> i) & 1)
-			printf("      %s\n", speaker_map[i]);
+	if (index && out_fmt != OUT_FMT_RAW)
+		fprintf(f, "\n");
+	switch (out_fmt) {
+	default:
+	case OUT_FMT_HEX:
+		hexdumpedid(f, edid, size);
+		break;
+	case OUT_FMT_RAW:
+		fwrite(edid, size, 1, f);
+		break;
+	case OUT_FMT_CARRAY:
+		carraydumpedid(f, edid, size, index);
+		break;
 	}
 }
 
-static float decode_uchar_as_float(unsigned char x)
+static void edid_input_free(struct edid_input *in)
 {
-	signed char s = (signed char)x;
-
-	return s / 64.0;
+	if (in->edids != &in->one)
+		free(in->edids);
+	free(in->alloc);
+	if (in->map_len)
+		munmap(in->data, in->map_len);
+	else
+		free(in->data);
 }
 
-static void cta_rcdb(const unsigned char *x, unsigned int length)
+/* Returns 0 if in->edids was set, even if they are not valid EDIDs */
+static int edid_read_file(const char *from_file, struct edid_input *in)
 {
-	uint32_t spm = ((x[3] << 16) | (x[2] << 8) | x[1]);
-	int i;
-
-	if (length < 4)
-		return;
-
-	if (x[0] & 0x40)
-		printf("    Speaker count: %d\n", (x[0] & 0x1f) + 1);
+	int ret = -1;
+	int fd;
 
-	printf("    Speaker Presence Mask:\n");
-	for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
-		if ((spm >> i) & 1)
-			printf("      %s\n", speaker_map[i]);
-	}
-	if ((x[0] & 0x20) && length >= 7) {
-		printf("    Xmax: %d dm\n", x[4]);
-		printf("    Ymax: %d dm\n", x[5]);
-		printf("    Zmax: %d dm\n", x[6]);
-	}
-	if ((x[0] & 0x80) && length >= 10) {
-		printf("    DisplayX: %.3f * Xmax\n", decode_uchar_as_float(x[7]));
-		printf("    DisplayY: %.3f * Ymax\n", decode_uchar_as_float(x[8]));
-		printf("    DisplayZ: %.3f * Zmax\n", decode_uchar_as_float(x[9]));
+	memset(in, 0, sizeof(*in));
+	if (!from_file || !strcmp(from_file, "-")) {
+		fd = 0;
+	} else if ((fd = open(from_file, O_RDONLY)) == -1) {
+		perror(from_file);
+		return -1;
 	}
-}
-
-static const char *speaker_location[] = {
-	"FL - Front Left",
-	"FR - Front Right",
-	"FC - Front Center",
-	"LFE1 - Low Frequency Effects 1",
-	"BL - Back Left",
-	"BR - Back Right",
-	"FLC - Front Left of Center",
-	"FRC - Front Right of Center",
-	"BC - Back Center",
-	"LFE2 - Low Frequency Effects 2",
-	"SiL - Side Left",
-	"SiR - Side Right",
-	"TpFL - Top Front Left",
-	"TpFR - Top Front Right",
-	"TpFC - Top Front Center",
-	"TpC - Top Center",
-	"TpBL - Top Back Left",
-	"TpBR - Top Back Right",
-	"TpSiL - Top Side Left",
-	"TpSiR - Top Side Right",
-	"TpBC - Top Back Center",
-	"BtFC - Bottom Front Center",
-	"BtFL - Bottom Front Left",
-	"BtFR - Bottom Front Right",
-	"FLW - Front Left Wide",
-	"FRW - Front Right Wide",
-	"LS - Left Surround",
-	"RS - Right Surround",
-};
-
-static void cta_sldb(const unsigned char *x, unsigned int length)
-{
-	while (length >= 2) {
-		printf("    Channel: %d (%sactive)\n", x[0] & 0x1f,
-		       (x[0] & 0x20) ? "" : "not ");
-		if ((x[1] & 0x1f) < ARRAY_SIZE(speaker_location))
-			printf("      Speaker: %s\n", speaker_location[x[1] & 0x1f]);
-		if (length >= 5 && (x[0] & 0x40)) {
-			printf("      X: %.3f * Xmax\n", decode_uchar_as_float(x[2]));
-			printf("      Y: %.3f * Ymax\n", decode_uchar_as_float(x[3]));
-			printf("      Z: %.3f * Zmax\n", decode_uchar_as_float(x[4]));
-			length -= 3;
-			x += 3;
-		}
 
-		length -= 2;
-		x += 2;
+	if (!map_input(fd, in) || !read_input(fd, in))
+		ret = extract_edid(in);
+	if (fd != 0)
+		close(fd);
+	if (ret) {
+		fprintf(stderr, "edid extract failed\n");
+		edid_input_free(in);
+		memset(in, 0, sizeof(*in));
 	}
+	return ret;
 }
 
-static void cta_vcdb(const unsigned char *x, unsigned int length)
-{
-	unsigned char d = x[0];
-
-	decode(vcdb_fields, d, "    ");
-}
-
-static const char *colorimetry_map[] = {
-	"xvYCC601",
-	"xvYCC709",
-	"sYCC601",
-	"opYCC601",
-	"opRGB",
-	"BT2020cYCC",
-	"BT2020YCC",
-	"BT2020RGB",
-};
-
-static void cta_colorimetry_block(const unsigned char *x, unsigned int length)
+/* do the selected outputs need the messages of the findings? */
+static int need_messages(void)
 {
-	int i;
+	unsigned i;
 
-	if (length >= 2) {
-		for (i = 0; i < ARRAY_SIZE(colorimetry_map); i++) {
-			if (x[0] & (1 << i))
-				printf("    %s\n", colorimetry_map[i]);
-		}
-		if (x[1] & 0x80)
-			printf("    DCI-P3\n");
-		if (x[1] & 0x40)
-			printf("    ICtCp\n");
-	}
+	if (output_text)
+		return 1;
+	for (i = 0; i < num_outputs; i++)
+		if (outputs[i] == EDID_OUTPUT_JSON ||
+		    outputs[i] == EDID_OUTPUT_FINDINGS)
+			return 1;
+	return 0;
 }
 
-static const char *eotf_map[] = {
-	"Traditional gamma - SDR luminance range",
-	"Traditional gamma - HDR luminance range",
-	"SMPTE ST2084",
-	"Hybrid Log-Gamma",
-};
-
-static void cta_hdr_static_metadata_block(const unsigned char *x, unsigned int length)
+/* Write the identity and preferred timing of the EDID with --summary */
+static int summarize_edid(FILE *output, const unsigned char *edid,
+			  unsigned size)
 {
-	int i;
+	struct edid_summary sum;
+	const struct edid_timing *t = &sum.preferred;
 
-	if (length >= 2) {
-		printf("    Electro optical transfer functions:\n");
-		for (i = 0; i < 6; i++) {
-			if (x[0] & (1 << i)) {
-				printf("      %s\n", i < ARRAY_SIZE(eotf_map) ?
-				       eotf_map[i] : "Unknown");
-			}
-		}
-		printf("    Supported static metadata descriptors:\n");
-		for (i = 0; i < 8; i++) {
-			if (x[1] & (1 << i))
-				printf("      Static metadata type %d\n", i + 1);
-		}
+	if (edid_summary(edid, size, &sum)) {
+		if (edid)
+			fprintf(stderr, "No header found\n");
+		return -1;
 	}
-
-	if (length >= 3)
-		printf("    Desired content max luminance: %d (%.3f cd/m^2)\n",
-		       x[2], 50.0 * pow(2, x[2] / 32.0));
-
-	if (length >= 4)
-		printf("    Desired content max frame-average luminance: %d (%.3f cd/m^2)\n",
-		       x[3], 50.0 * pow(2, x[3] / 32.0));
-
-	if (length >= 5)
-		printf("    Desired content min luminance: %d (%.3f cd/m^2)\n",
-		       x[4], (50.0 * pow(2, x[2] / 32.0)) * pow(x[4] / 255.0, 2) / 100.0);
-}
-
-static void cta_hdr_dyn_metadata_block(const unsigned char *x, unsigned int length)
-{
-	while (length >= 3) {
-		int type_len = x[0];
-		int type = x[1] | (x[2] << 8);
-
-		if (length < type_len + 1)
-			return;
-		printf("    HDR Dynamic Metadata Type %d\n", type);
-		switch (type) {
-		case 1:
-		case 2:
-		case 4:
-			if (type_len > 2)
-				printf("      Version: %d\n", x[3] & 0xf);
-			break;
-		default:
-			break;
-		}
-		length -= type_len + 1;
-		x += type_len + 1;
-	}
-}
-
-static void cta_ifdb(const unsigned char *x, unsigned int length)
-{
-	int len_hdr = x[0] >> 5;
-
-	if (length < 2)
-		return;
-	printf("    VSIFs: %d\n", x[1]);
-	if (length < len_hdr + 2)
-		return;
-	length -= len_hdr + 2;
-	x += len_hdr + 2;
-	while (length > 0) {
-		int payload_len = x[0] >> 5;
-
-		if ((x[0] & 0x1f) == 1 && length >= 4) {
-			printf("    InfoFrame Type Code %d IEEE OUI: %02x%02x%02x\n",
-			       x[0] & 0x1f, x[3], x[2], x[1]);
-			x += 4;
-			length -= 4;
-		} else {
-			printf("    InfoFrame Type Code %d\n", x[0] & 0x1f);
-			x++;
-			length--;
-		}
-		x += payload_len;
-		length -= payload_len;
+	fprintf(output, "Manufacturer: %s Model %x Serial Number %u\n",
+		sum.manufacturer, sum.product, sum.serial);
+	if (sum.week == 0xff)
+		fprintf(output, "Model year %u\n", sum.year);
+	else if (sum.week)
+		fprintf(output, "Made in week %u of %u\n", sum.week, sum.year);
+	else
+		fprintf(output, "Made in year %u\n", sum.year);
+	if (sum.name[0])
+		fprintf(output, "Monitor name: %s\n", sum.name);
+	if (sum.serial_string[0])
+		fprintf(output, "Serial number: %s\n", sum.serial_string);
+	if (t->pixclk_khz) {
+		unsigned htotal = t->hact + t->hfp + t->hsync + t->hbp;
+		unsigned vtotal = t->vact + t->vfp + t->vsync + t->vbp;
+
+		fprintf(output, "%s: %ux%u%s %.3f Hz, %.3f MHz\n",
+			(t->flags & EDID_TIMING_PREFERRED) ?
+			"Preferred timing" : "First detailed timing",
+			t->hact, t->vact,
+			(t->flags & EDID_TIMING_INTERLACED) ? "i" : "",
+			htotal && vtotal ?
+			t->pixclk_khz * 1000.0 / (htotal * vtotal) : 0.0,
+			t->pixclk_khz / 1000.0);
 	}
+	return 0;
 }
 
-static void cta_hdmi_audio_block(const unsigned char *x, unsigned int length)
+/* Answer the --supports queries for the EDID */
+static int supports_edid(FILE *output, const unsigned char *edid,
+			 unsigned size)
 {
-	int num_descs;
-
-	if (length < 2)
-		return;
-	if (x[0] & 3)
-		printf("    Max Stream Count: %d\n", (x[0] & 3) + 1);
-	if (x[0] & 4)
-		printf("    Supports MS NonMixed\n");
-
-	num_descs = x[1] & 7;
-	if (num_descs == 0)
-		return;
-	length -= 2;
-	x += 2;
-	while (length >= 4) {
-		if (length > 4) {
-			int format = x[0] & 0xf;
-
-			printf("    %s, max channels %d\n", audio_format(format),
-			       (x[1] & 0x1f)+1);
-			printf("      Supported sample rates (kHz):%s%s%s%s%s%s%s\n",
-			       (x[2] & 0x40) ? " 192" : "",
-			       (x[2] & 0x20) ? " 176.4" : "",
-			       (x[2] & 0x10) ? " 96" : "",
-			       (x[2] & 0x08) ? " 88.2" : "",
-			       (x[2] & 0x04) ? " 48" : "",
-			       (x[2] & 0x02) ? " 44.1" : "",
-			       (x[2] & 0x01) ? " 32" : "");
-			if (format == 1)
-				printf("      Supported sample sizes (bits):%s%s%s\n",
-				       (x[3] & 0x04) ? " 24" : "",
-				       (x[3] & 0x02) ? " 20" : "",
-				       (x[3] & 0x01) ? " 16" : "");
-		} else {
-			uint32_t sad = ((x[2] << 16) | (x[1] << 8) | x[0]);
-			int i;
-
-			switch (x[3] >> 4) {
-			case 1:
-				printf("    Speaker Allocation for 10.2 channels:\n");
-				break;
-			case 2:
-				printf("    Speaker Allocation for 22.2 channels:\n");
-				break;
-			case 3:
-				printf("    Speaker Allocation for 30.2 channels:\n");
-				break;
-			default:
-				printf("    Unknown Speaker Allocation (%d)\n", x[3] >> 4);
-				return;
-			}
+	struct edid_info info;
+	struct edid_mode_index idx;
+	unsigned i;
+	int ret = 0;
 
-			for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
-				if ((sad >> i) & 1)
-					printf("      %s\n", speaker_map[i]);
-			}
-		}
-		length -= 4;
-		x += 4;
+	if (edid_decode_text(edid, size, &info, EDID_DECODE_QUIET, NULL) ||
+	    edid_mode_index(&info, &idx)) {
+		if (edid)
+			fprintf(stderr, "No header found\n");
+		return -1;
 	}
-}
+	for (i = 0; i < num_queries; i++) {
+		const struct supports_query *q = &queries[i];
+		struct edid_timing t;
 
-static void cta_block(const unsigned char *x)
-{
-	static int last_block_was_hdmi_vsdb;
-	static int have_hf_vsdb, have_hf_scdb;
-	static int first_block = 1;
-	unsigned int length = x[0] & 0x1f;
-	unsigned int oui;
-
-	switch ((x[0] & 0xe0) >> 5) {
-	case 0x01:
-		cur_block = "Audio Data Block";
-		printf("  Audio Data Block\n");
-		cta_audio_block(x + 1, length);
-		break;
-	case 0x02:
-		cur_block = "Video Data Block";
-		printf("  Video Data Block\n");
-		cta_video_block(x + 1, length);
-		break;
-	case 0x03:
-		oui = (x[3] << 16) + (x[2] << 8) + x[1];
-		printf("  Vendor-Specific Data Block, OUI %06x", oui);
-		if (oui == 0x000c03) {
-			cur_block = "Vendor-Specific Data Block (HDMI)";
-			cta_hdmi_block(x + 1, length);
-			last_block_was_hdmi_vsdb = 1;
-			first_block = 0;
-			return;
-		}
-		if (oui == 0xc45dd8) {
-			cur_block = "Vendor-Specific Data Block (HDMI Forum)";
-			if (!last_block_was_hdmi_vsdb)
-				nonconformant_hf_vsdb_position = 1;
-			if (have_hf_scdb || have_hf_vsdb)
-				duplicate_scdb = 1;
-			printf(" (HDMI Forum)\n");
-			cta_hf_scdb(x + 4, length - 3);
-			have_hf_vsdb = 1;
-		} else {
-			printf("\n");
-		}
-		break;
-	case 0x04:
-		cur_block = "Speaker Allocation Data Block";
-		printf("  Speaker Allocation Data Block\n");
-		cta_sadb(x + 1, length);
-		break;
-	case 0x05:
-		printf("  VESA DTC Data Block\n");
-		break;
-	case 0x07:
-		printf("  Extended tag: ");
-		switch (x[1]) {
-		case 0x00:
-			cur_block = "Video Capability Data Block";
-			printf("Video Capability Data Block\n");
-			cta_vcdb(x + 2, length - 1);
-			break;
-		case 0x01:
-			oui = (x[4] << 16) + (x[3] << 8) + x[2];
-			printf("Vendor-Specific Video Data Block, OUI %06x", oui);
-			if (oui == 0x90848b) {
-				cur_block = "Vendor-Specific Video Data Block (HDR10+)";
-				printf(" (HDR10+)\n");
-				cta_hdr10plus(x + 5, length - 4);
-			} else {
-				printf("\n");
-			}
-			break;
-		case 0x02:
-			printf("VESA Video Display Device Data Block\n");
-			break;
-		case 0x03:
-			printf("VESA Video Timing Block Extension\n");
-			break;
-		case 0x04:
-			printf("Reserved for HDMI Video Data Block\n");
-			break;
-		case 0x05:
-			cur_block = "Colorimetry Data Block";
-			printf("Colorimetry Data Block\n");
-			cta_colorimetry_block(x + 2, length - 1);
-			break;
-		case 0x06:
-			cur_block = "HDR Static Metadata Data Block";
-			printf("HDR Static Metadata Data Block\n");
-			cta_hdr_static_metadata_block(x + 2, length - 1);
-			break;
-		case 0x07:
-			cur_block = "HDR Dynamic Metadata Data Block";
-			printf("HDR Dynamic Metadata Data Block\n");
-			cta_hdr_dyn_metadata_block(x + 2, length - 1);
-			break;
-		case 0x0d:
-			cur_block = "Video Format Preference Data Block";
-			printf("Video Format Preference Data Block\n");
-			cta_vfpdb(x + 2, length - 1);
-			break;
-		case 0x0e:
-			cur_block = "YCbCr 4:2:0 Video Data Block";
-			printf("YCbCr 4:2:0 Video Data Block\n");
-			cta_y420vdb(x + 2, length - 1);
-			break;
-		case 0x0f:
-			cur_block = "YCbCr 4:2:0 Capability Map Data Block";
-			printf("YCbCr 4:2:0 Capability Map Data Block\n");
-			cta_y420cmdb(x + 2, length - 1);
+		switch (edid_supports(&idx, q->width, q->height, q->refresh,
+				      q->flags, &t)) {
+		case EDID_SUPPORTS_MODE:
+			fprintf(output, "%s: supported, %.3f MHz\n",
+				q->arg, t.pixclk_khz / 1000.0);
 			break;
-		case 0x10:
-			printf("Reserved for CTA Miscellaneous Audio Fields\n");
-			break;
-		case 0x11:
-			printf("Vendor-Specific Audio Data Block\n");
-			break;
-		case 0x12:
-			cur_block = "HDMI Audio Data Block";
-			printf("HDMI Audio Data Block\n");
-			cta_hdmi_audio_block(x + 2, length - 1);
-			break;
-		case 0x13:
-			cur_block = "Room Configuration Data Block";
-			printf("Room Configuration Data Block\n");
-			cta_rcdb(x + 2, length - 1);
-			break;
-		case 0x14:
-			cur_block = "Speaker Location Data Block";
-			printf("Speaker Location Data Block\n");
-			cta_sldb(x + 2, length - 1);
-			break;
-		case 0x20:
-			printf("InfoFrame Data Block\n");
-			cta_ifdb(x + 2, length - 1);
-			break;
-		case 0x78:
-			cur_block = "HDMI Forum EDID Extension Override Data Block";
-			printf("HDMI Forum EDID Extension Override Data Block\n");
-			cta_hf_eeodb(x + 2, length - 1);
-			// This must be the first CTA block
-			if (!first_block)
-				nonconformant_hf_eeodb = 1;
-			break;
-		case 0x79:
-			cur_block = "HDMI Forum Sink Capability Data Block";
-			printf("HDMI Forum Sink Capability Data Block\n");
-			if (!last_block_was_hdmi_vsdb)
-				nonconformant_hf_vsdb_position = 1;
-			if (have_hf_scdb || have_hf_vsdb)
-				duplicate_scdb = 1;
-			if (x[2] || x[3])
-				printf("  Non-zero SCDB reserved fields!\n");
-			cta_hf_scdb(x + 4, length - 3);
-			have_hf_scdb = 1;
+		case EDID_SUPPORTS_RANGE:
+			fprintf(output, "%s: supported within the range limits (%s), %.3f MHz\n",
+				q->arg, t.source == EDID_SRC_GTF ? "GTF" : "CVT",
+				t.pixclk_khz / 1000.0);
 			break;
 		default:
-			if (x[1] >= 6 && x[1] <= 12)
-				printf("Reserved for video-related blocks (%02x)\n", x[1]);
-			else if (x[1] >= 19 && x[1] <= 31)
-				printf("Reserved for audio-related blocks (%02x)\n", x[1]);
-			else
-				printf("Reserved (%02x)\n", x[1]);
+			fprintf(output, "%s: not supported\n", q->arg);
+			ret = 1;
 			break;
 		}
-		break;
-	default: {
-		int tag = (*x & 0xe0) >> 5;
-		int length = *x & 0x1f;
-		printf("  Unknown tag %d, length %d (raw %02x)\n", tag, length, *x);
-		break;
 	}
-	}
-	first_block = 0;
-	last_block_was_hdmi_vsdb = 0;
+	return ret;
 }
 
-static int parse_cta(const unsigned char *x)
+/*
+ * Decode and write the EDID in all selected formats. A NULL edid, for an
+ * input that could not be read, still produces an error document in the
+ * JSON format.
+ */
+static int decode_edid(FILE *output, const unsigned char *edid, unsigned size,
+		       const char *source)
 {
-	int ret = 0;
-	int version = x[1];
-	int offset = x[2];
-	const unsigned char *detailed;
-
-	cur_block = "CTA-861";
-
-	if (version >= 1) do {
-		if (version == 1 && x[3] != 0)
-			ret = 1;
-
-		if (offset < 4)
-			break;
-
-		if (version < 3) {
-			printf("%d 8-byte timing descriptors\n\n", (offset - 4) / 8);
-			if (offset - 4 > 0)
-				/* do stuff */ ;
-		}
-
-		if (version >= 2) {    
-			if (x[3] & 0x80)
-				printf("Underscans PC formats by default\n");
-			if (x[3] & 0x40)
-				printf("Basic audio support\n");
-			if (x[3] & 0x20)
-				printf("Supports YCbCr 4:4:4\n");
-			if (x[3] & 0x10)
-				printf("Supports YCbCr 4:2:2\n");
-			printf("%d native detailed modes\n\n", x[3] & 0x0f);
-		}
-		if (version == 3) {
-			int i;
-
-			printf("%d bytes of CTA data\n", offset - 4);
-			for (i = 4; i < offset; i += (x[i] & 0x1f) + 1) {
-				cta_block(x + i);
-			}
-			printf("\n");
-		}
-
-		for (detailed = x + offset; detailed + 18 < x + 127; detailed += 18)
-			if (detailed[0])
-				detailed_block(detailed, 1);
-	} while (0);
-
-	has_valid_cta_checksum = do_checksum(x, EDID_PAGE_SIZE);
-	has_cta861 = 1;
-	nonconformant_cta861_640x480 = !has_cta861_vic_1 && !has_640x480p60_est_timing;
-
+	struct edid_info info;
+	unsigned flags = 0;
+	unsigned i;
+	int ret;
+
+	if (options[OptSummary])
+		return summarize_edid(output, edid, size);
+	if (num_queries)
+		return supports_edid(output, edid, size);
+	if (options[OptCheck])
+		flags |= EDID_DECODE_CHECK;
+	if (options[OptFailFast])
+		flags |= EDID_DECODE_CHECK_FIRST;
+	if (options[OptExtract])
+		flags |= EDID_DECODE_EXTRACT;
+	if (!need_messages())
+		flags |= EDID_DECODE_QUIET;
+	if (num_check_codes)
+		ret = edid_check(edid, size, &info, flags, NULL,
+				 check_codes, num_check_codes);
+	else
+		ret = edid_decode_text(edid, size, &info, flags, NULL);
+	if (output_text)
+		edid_emit(output, &info, EDID_OUTPUT_TEXT, source);
+	if (ret == -1 && edid && !options[OptQuiet])
+		fprintf(stderr, "No header found\n");
+	for (i = 0; i < num_outputs; i++)
+		edid_emit(output, &info, outputs[i], source);
 	return ret;
 }
 
-static void parse_displayid_detailed_timing(const unsigned char *x)
+/* a file that could not be decoded outranks a nonconformant one */
+static int batch_status(int ret, int status)
 {
-	int ha, hbl, hso, hspw;
-	int va, vbl, vso, vspw;
-	char phsync, pvsync, *stereo;
-	int pix_clock;
-	char *aspect;
-
-	switch (x[3] & 0xf) {
-	case 0:
-		aspect = "1:1";
-		break;
-	case 1:
-		aspect = "5:4";
-		break;
-	case 2:
-		aspect = "4:3";
-		break;
-	case 3:
-		aspect = "15:9";
-		break;
-	case 4:
-		aspect = "16:9";
-		break;
-	case 5:
-		aspect = "16:10";
-		break;
-	case 6:
-		aspect = "64:27";
-		break;
-	case 7:
-		aspect = "256:135";
-		break;
-	default:
-		aspect = "undefined";
-		break;
-	}
-	switch ((x[3] >> 5) & 0x3) {
-	case 0:
-		stereo = ", no 3D stereo";
-		break;
-	case 1:
-		stereo = ", 3D stereo";
-		break;
-	case 2:
-		stereo = ", 3D stereo depends on user action";
-		break;
-	case 3:
-		stereo = ", reserved";
-		break;
-	}
-	printf("  Aspect %s%s%s\n", aspect, x[3] & 0x80 ? ", preferred" : "", stereo);
-	pix_clock = x[0] + (x[1] << 8) + (x[2] << 16);
-	ha = x[4] | (x[5] << 8);
-	hbl = x[6] | (x[7] << 8);
-	hso = x[8] | ((x[9] & 0x7f) << 8);
-	phsync = ((x[9] >> 7) & 0x1) ? '+' : '-';
-	hspw = x[10] | (x[11] << 8);
-	va = x[12] | (x[13] << 8);
-	vbl = x[14] | (x[15] << 8);
-	vso = x[16] | ((x[17] & 0x7f) << 8);
-	vspw = x[18] | (x[19] << 8);
-	pvsync = ((x[17] >> 7) & 0x1 ) ? '+' : '-';
-
-	printf("  Detailed mode: Clock %.3f MHz, %d mm x %d mm\n"
-	       "                 %4d %4d %4d %4d\n"
-	       "                 %4d %4d %4d %4d\n"
-	       "                 %chsync %cvsync\n",
-	       (float)pix_clock/100.0, 0, 0,
-	       ha, ha + hso, ha + hso + hspw, ha + hbl,
-	       va, va + vso, va + vso + vspw, va + vbl,
-	       phsync, pvsync
-	      );
+	if (status == -1 || !ret)
+		ret = status;
+	return ret;
 }
 
-static const struct {
-	int x, y, refresh, ratio_w, ratio_h;
-	int hor_freq_hz, pixclk_khz, rb, interlaced;
-} displayid_vesa_dmt[] = {
-	/* 0x03 bit 7 - 0 */
-	{640, 350, 85, 64, 35, 37900, 31500},
-	{640, 400, 85, 16, 10, 37900, 31500},
-	{720, 400, 85, 9, 5, 37900, 35500},
-	{640, 480, 60, 4, 3, 31469, 25175},
-	{640, 480, 72, 4, 3, 37900, 31500},
-	{640, 480, 75, 4, 3, 37500, 31500},
-	{640, 480, 85, 4, 3, 43300, 36000},
-	{800, 600, 56, 4, 3, 35200, 36000},
-	/* 0x04 bit 7 - 0 */
-	{800, 600, 60, 4, 3, 37900, 40000},
-	{800, 600, 72, 4, 3, 48100, 50000},
-	{800, 600, 75, 4, 3, 46900, 49500},
-	{800, 600, 85, 4, 3, 53700, 56250},
-	{800, 600, 120, 4, 3, 76302, 73250, 1},
-	{848, 480, 60, 16, 9, 31020, 33750},
-	{1024, 768, 43, 4, 3, 35522, 44900, 0, 1},
-	{1024, 768, 60, 4, 3, 48400, 65000},
-	/* 0x05 bit 7 - 0 */
-	{1024, 768, 70, 4, 3, 56500, 75000},
-	{1024, 768, 75, 4, 3, 60000, 78750},
-	{1024, 768, 85, 4, 3, 68700, 94500},
-	{1024, 768, 120, 4, 3, 97551, 115500, 1},
-	{1152, 864, 75, 4, 3, 67500, 108000},
-	{1280, 768, 60, 5, 3, 47400, 68250, 1},
-	{1280, 768, 60, 5, 3, 47800, 79500},
-	{1280, 768, 75, 5, 3, 60300, 102250},
-	/* 0x06 bit 7 - 0 */
-	{1280, 768, 85, 5, 3, 68600, 117500},
-	{1280, 768, 120, 5, 3, 97396, 140250, 1},
-	{1280, 800, 60, 16, 10, 49306, 710000, 1},
-	{1280, 800, 60, 16, 10, 49702, 83500},
-	{1280, 800, 75, 16, 10, 62795, 106500},
-	{1280, 800, 85, 16, 10, 71554, 122500},
-	{1280, 800, 120, 16, 10, 101563, 146250, 1},
-	{1280, 960, 60, 4, 3, 60000, 108000},
-	/* 0x07 bit 7 - 0 */
-	{1280, 960, 85, 4, 3, 85900, 148500},
-	{1280, 960, 120, 4, 3, 121875, 175500, 1},
-	{1280, 1024, 60, 5, 4, 64000, 108000},
-	{1280, 1024, 75, 5, 4, 80000, 135000},
-	{1280, 1024, 85, 5, 4, 91100, 157500},
-	{1280, 1024, 120, 5, 4, 130035, 187250, 1},
-	{1360, 768, 60, 85, 48, 47700, 85500},
-	{1360, 768, 120, 85, 48, 97533, 148250, 1},
-	/* 0x08 bit 7 - 0 */
-	{1400, 1050, 60, 4, 3, 64700, 101000, 1},
-	{1400, 1050, 60, 4, 3, 65300, 121750},
-	{1400, 1050, 75, 4, 3, 82300, 156000},
-	{1400, 1050, 85, 4, 3, 93900, 179500},
-	{1400, 1050, 120, 4, 3, 133333, 208000, 1},
-	{1440, 900, 60, 16, 10, 55500, 88750, 1},
-	{1440, 900, 60, 16, 10, 65300, 121750},
-	{1440, 900, 75, 16, 10, 82300, 156000},
-	/* 0x09 bit 7 - 0 */
-	{1440, 900, 85, 16, 10, 93900, 179500},
-	{1440, 900, 120, 16, 10, 114219, 182750, 1},
-	{1600, 1200, 60, 4, 3, 75000, 162000},
-	{1600, 1200, 65, 4, 3, 81300, 175500},
-	{1600, 1200, 70, 4, 3, 87500, 189000},
-	{1600, 1200, 75, 4, 3, 93800, 202500},
-	{1600, 1200, 85, 4, 3, 106300, 229500},
-	{1600, 1200, 120, 4, 3, 152415, 268250, 1},
-	/* 0x0a bit 7 - 0 */
-	{1680, 1050, 60, 16, 10, 64700, 119000, 1},
-	{1680, 1050, 60, 16, 10, 65300, 146250},
-	{1680, 1050, 75, 16, 10, 82300, 187000},
-	{1680, 1050, 85, 16, 10, 93900, 214750},
-	{1680, 1050, 120, 16, 10, 133424, 245500, 1},
-	{1792, 1344, 60, 4, 3, 83600, 204750},
-	{1792, 1344, 75, 4, 3, 106300, 261000},
-	{1792, 1344, 120, 4, 3, 170722, 333250, 1},
-	/* 0x0b bit 7 - 4 */
-	{1856, 1392, 60, 4, 3, 86300, 218250},
-	{1856, 1392, 75, 4, 3, 112500, 288000},
-	{1856, 1392, 120, 4, 3, 176835, 356500, 1},
-	{1920, 1200, 60, 16, 10, 74000, 154000, 1},
-	{1920, 1200, 60, 16, 10, 74600, 193250},
-	{1920, 1200, 75, 16, 10, 94000, 245250},
-	{1920, 1200, 85, 16, 10, 107200, 281250},
-	{1920, 1200, 120, 16, 10, 152404, 317000, 1},
-	/* 0x0c bit 7 - 4 */
-	{1920, 1440, 60, 4, 3, 90000, 234000},
-	{1920, 1440, 75, 4, 3, 112500, 297000},
-	{1920, 1440, 120, 4, 3, 182933, 380500, 1},
-	{2560, 1600, 60, 16, 10, 98713, 268500, 1},
-	{2560, 1600, 60, 16, 10, 99458, 348500},
-	{2560, 1600, 75, 16, 10, 125354, 443250},
-	{2560, 1600, 85, 16, 10, 142887, 505250},
-	{2560, 1600, 120, 16, 10, 203217, 552750, 1},
-};
-
-static int parse_displayid(const unsigned char *x)
+/*
+ * Decode all EDIDs found in an input. If there are several, e.g. one per
+ * output in xrandr --verbose output, each is named after the input and
+ * its origin, and the text output of each is headed by that name.
+ */
+static int decode_input(FILE *output, const struct edid_input *in,
+			const char *file)
 {
-	const unsigned char *orig = x;
-	int version = x[1];
-	int length = x[2];
-	int ext_count = x[4];
-	int i;
-
-	cur_block = "DisplayID";
-
-	printf("Length %d, version %u.%u, extension count %d\n",
-	       length, version >> 4, version & 0xf, ext_count);
-
-	int offset = 5;
-	while (length > 0) {
-		int tag = x[offset];
-		int len = x[offset + 2];
-
-		if (len == 0)
-			break;
-		switch (tag) {
-		case 0:
-			printf("Product ID Block\n");
-			break;
-		case 1:
-			printf("Display Parameters Block\n");
-			break;
-		case 2:
-			printf("Color Characteristics Block\n");
-			break;
-		case 3: {
-			printf("Type 1 Detailed Timings Block\n");
-			for (i = 0; i < len / 20; i++) {
-				parse_displayid_detailed_timing(&x[offset + 3 + (i * 20)]);
-			}
-			break;
-		}
-		case 4:
-			printf("Type 2 Detailed Timings Block\n");
-			break;
-		case 5:
-			printf("Type 3 Short Timings Block\n");
-			break;
-		case 6:
-			printf("Type 4 DMT Timings Block\n");
-			break;
-		case 7:
-			printf("Type 1 VESA DMT Timings Block\n");
-			for (i = 0; i < min(len, 10) * 8; i++) {
-				if (x[offset + 3 + i / 8] & (1 << (i % 8))) {
-					printf("  %dx%d%s@%dHz %s%u:%u HorFreq: %d Hz Clock: %.3f MHz\n",
-					       displayid_vesa_dmt[i].x,
-					       displayid_vesa_dmt[i].y,
-					       displayid_vesa_dmt[i].interlaced ? "i" : "",
-					       displayid_vesa_dmt[i].refresh,
-					       displayid_vesa_dmt[i].rb ? "RB " : "",
-					       displayid_vesa_dmt[i].ratio_w, displayid_vesa_dmt[i].ratio_h,
-					       displayid_vesa_dmt[i].hor_freq_hz,
-					       displayid_vesa_dmt[i].pixclk_khz / 1000.0);
-					min_vert_freq_hz = min(min_vert_freq_hz, displayid_vesa_dmt[i].refresh);
-					max_vert_freq_hz = max(max_vert_freq_hz, displayid_vesa_dmt[i].refresh);
-					min_hor_freq_hz = min(min_hor_freq_hz, displayid_vesa_dmt[i].hor_freq_hz);
-					max_hor_freq_hz = max(max_hor_freq_hz, displayid_vesa_dmt[i].hor_freq_hz);
-					max_pixclk_khz = max(max_pixclk_khz, displayid_vesa_dmt[i].pixclk_khz);
-				}
-			}
-			break;
-		case 8:
-			printf("CTA Timings Block\n");
-			break;
-		case 9:
-			printf("Video Timing Range Block\n");
-			break;
-		case 0xa:
-			printf("Product Serial Number Block\n");
-			break;
-		case 0xb:
-			printf("GP ASCII String Block\n");
-			break;
-		case 0xc:
-			printf("Display Device Data Block\n");
-			break;
-		case 0xd:
-			printf("Interface Power Sequencing Block\n");
-			break;
-		case 0xe:
-			printf("Transfer Characteristics Block\n");
-			break;
-		case 0xf:
-			printf("Display Interface Block\n");
-			break;
-		case 0x10:
-			printf("Stereo Display Interface Block\n");
-			break;
-		case 0x12: {
-			int capabilities = x[offset + 3];
-			int num_v_tile = (x[offset + 4] & 0xf) | (x[offset + 6] & 0x30);
-			int num_h_tile = (x[offset + 4] >> 4) | ((x[offset + 6] >> 2) & 0x30);
-			int tile_v_location = (x[offset + 5] & 0xf) | ((x[offset + 6] & 0x3) << 4);
-			int tile_h_location = (x[offset + 5] >> 4) | (((x[offset + 6] >> 2) & 0x3) << 4);
-			int tile_width = x[offset + 7] | (x[offset + 8] << 8);
-			int tile_height = x[offset + 9] | (x[offset + 10] << 8);
-			int pix_mult = x[offset + 11];
-
-			printf("Tiled Display Topology Block\n");
-			printf("  Capabilities: 0x%08x\n", capabilities);
-			printf("  Num horizontal tiles: %d Num vertical tiles: %d\n", num_h_tile + 1, num_v_tile + 1);
-			printf("  Tile location: %d, %d\n", tile_h_location, tile_v_location);
-			printf("  Tile resolution: %dx%d\n", tile_width + 1, tile_height + 1);
-			if (capabilities & 0x40) {
-				if (pix_mult) {
-					printf("  Top bevel size: %d pixels\n",
-					       pix_mult * x[offset + 12] / 10);
-					printf("  Bottom bevel size: %d pixels\n",
-					       pix_mult * x[offset + 13] / 10);
-					printf("  Right bevel size: %d pixels\n",
-					       pix_mult * x[offset + 14] / 10);
-					printf("  Left bevel size: %d pixels\n",
-					       pix_mult * x[offset + 15] / 10);
-				} else {
-					warn("No bevel information, but the pixel multiplier is non-zero\n");
-				}
-				printf("  Tile resolution: %dx%d\n", tile_width + 1, tile_height + 1);
-			} else if (pix_mult) {
-				warn("No bevel information, but the pixel multiplier is non-zero\n");
-			}
-			break;
-		}
-		default:
-			printf("Unknown DisplayID Data Block 0x%x\n", tag);
-			break;
-		}
-		length -= len + 3;
-		offset += len + 3;
+	int ret = 0;
+	unsigned i;
+
+	if (!in->num_edids)
+		return decode_edid(output, NULL, 0, file);
+	if (in->num_edids == 1)
+		return decode_edid(output, in->edids[0].edid, in->edids[0].size, file);
+
+	for (i = 0; i < in->num_edids; i++) {
+		const struct edid_entry *e = &in->edids[i];
+		char source[256];
+
+		if (e->name)
+			snprintf(source, sizeof(source), "%s (%.*s)", file,
+				 e->name_len, e->name);
+		else if (e->line)
+			snprintf(source, sizeof(source), "%s (line %lu)", file,
+				 e->line);
+		else
+			snprintf(source, sizeof(source), "%s (EDID %u)", file, i + 1);
+		if (output_text)
+			fprintf(output, "%s---- %s ----\n", i ? "\n" : "", source);
+		ret = batch_status(ret, decode_edid(output, e->edid, e->size, source));
 	}
-
-	/* DisplayID length field is number of following bytes
-	 * but checksum is calculated over the entire structure
-	 * (excluding DisplayID-in-EDID magic byte)
-	 */
-	has_valid_displayid_checksum = do_checksum(orig+1, orig[2] + 5);
-	return 0;
+	return ret;
 }
 
-/* generic extension code */
-
-static void extension_version(const unsigned char *x)
-{
-	printf("Extension version: %d\n", x[1]);
-}
+/*
+ * Carve mode: scan an arbitrary binary, such as a firmware image or a
+ * memory snapshot, for EDIDs and decode each one found, named after the
+ * input and its offset in it. The input is read in chunks rather than
+ * mapped, and the tail of each chunk that could hold the start of an EDID
+ * is kept for the next one. A base block is only accepted with a valid
+ * checksum; of the extension blocks that its byte 0x7e announces, those
+ * that follow it with a valid checksum are kept.
+ */
+#define CARVE_CHUNK	(1 << 20)
+#define MAX_EDID_SIZE	(256 * 128)	/* a base block and 255 extensions */
 
-static int parse_extension(const unsigned char *x)
+/* returns the size of the EDID at b, or 0 if it is not one */
+static unsigned carve_edid(const unsigned char *b, size_t avail)
 {
-	int conformant_extension = 0;
-
-	printf("\n");
+	unsigned blocks;
+	unsigned n;
 
-	switch(x[0]) {
-	case 0x02:
-		printf("CTA Extension Block\n");
-		extension_version(x);
-		conformant_extension = parse_cta(x);
-		break;
-	case 0x10: printf("VTB Extension Block\n"); break;
-	case 0x40: printf("DI Extension Block\n"); break;
-	case 0x50: printf("LS Extension Block\n"); break;
-	case 0x60: printf("DPVL Extension Block\n"); break;
-	case 0x70: printf("DisplayID Extension Block\n");
-		   conformant_extension = parse_displayid(x);
-		   break;
-	case 0xF0: printf("Block map\n"); break;
-	case 0xFF: printf("Manufacturer-specific Extension Block\n");
-	default:
-		   printf("Unknown Extension Block\n");
-		   break;
-	}
-
-	return conformant_extension;
+	if (avail < 128 || !crc_ok(b))
+		return 0;
+	blocks = 1 + b[0x7e];
+	for (n = 1; n < blocks && (n + 1) * 128 <= avail; n++)
+		if (!crc_ok(b + n * 128))
+			break;
+	return n * 128;
 }
 
-static int edid_lines = 0;
-
-static unsigned char *extract_edid(int fd)
+/* decode the EDIDs of the file, or write them to out if it is given */
+static int carve_file(FILE *output, const char *file, FILE *out,
+		      enum output_format out_fmt)
 {
-	char *ret = NULL;
-	char *start, *c;
-	unsigned char *out = NULL;
-	int state = 0;
-	int lines = 0;
-	int i;
-	int out_index = 0;
-	int len, size;
-
-	size = 1 << 10;
-	ret = malloc(size);
-	len = 0;
-
-	if (ret == NULL)
-		return NULL;
-
-	for (;;) {
-		i = read(fd, ret + len, size - len);
-		if (i < 0) {
-			free(ret);
-			return NULL;
-		}
-		if (i == 0)
-			break;
-		len += i;
-		if (len == size) {
-			char *t;
-			size <<= 1;
-			t = realloc(ret, size);
-			if (t == NULL) {
-				free(ret);
-				return NULL;
-			}
-			ret = t;
-		}
-	}
-
-	start = strstr(ret, "EDID_DATA:");
-	if (start == NULL)
-		start = strstr(ret, "EDID:");
-	/* Look for xrandr --verbose output (lines of 16 hex bytes) */
-	if (start != NULL) {
-		const char indentation1[] = "                ";
-		const char indentation2[] = "\t\t";
-		/* Used to detect that we've gone past the EDID property */
-		const char half_indentation1[] = "        ";
-		const char half_indentation2[] = "\t";
-		const char *indentation;
-		char *s;
-
-		lines = 0;
-		for (i = 0;; i++) {
-			int j;
-
-			/* Get the next start of the line of EDID hex, assuming spaces for indentation */
-			s = strstr(start, indentation = indentation1);
-			/* Did we skip the start of another property? */
-			if (s && s > strstr(start, half_indentation1))
-				break;
-
-			/* If we failed, retry assuming tabs for indentation */
-			if (!s) {
-				s = strstr(start, indentation = indentation2);
-				/* Did we skip the start of another property? */
-				if (s && s > strstr(start, half_indentation2))
-					break;
-			}
-
-			if (!s)
-				break;
-
-			lines++;
-			start = s + strlen(indentation);
-
-			s = realloc(out, lines * 16);
-			if (!s) {
-				free(ret);
-				free(out);
-				return NULL;
-			}
-			out = (unsigned char *)s;
-			c = start;
-			for (j = 0; j < 16; j++) {
-				char buf[3];
-				/* Read a %02x from the log */
-				if (!isxdigit(c[0]) || !isxdigit(c[1])) {
-					if (j != 0) {
-						lines--;
-						break;
-					}
-					free(ret);
-					free(out);
-					return NULL;
-				}
-				buf[0] = c[0];
-				buf[1] = c[1];
-				buf[2] = 0;
-				out[out_index++] = strtol(buf, NULL, 16);
-				c += 2;
-			}
-			cur_block = "CTA-861";
-		}
+	const size_t buf_size = CARVE_CHUNK + MAX_EDID_SIZE;
+	unsigned long long base = 0;
+	unsigned char *buf;
+	size_t len = 0, pos, end;
+	unsigned found = 0;
+	int eof = 0;
+	int ret = 0;
+	int fd;
 
-		free(ret);
-		edid_lines = lines;
-		return out;
+	if (!file || !strcmp(file, "-")) {
+		file = "-";
+		fd = 0;
+	} else if ((fd = open(file, O_RDONLY)) == -1) {
+		perror(file);
+		return -1;
 	}
-
-	start = strstr(ret, "<BLOCK");
-	if (start) {
-		/* Parse QuantumData 980 EDID files */
-		do {
-			start = strstr(start, ">");
-			if (start)
-				out = realloc(out, out_index + 128);
-			if (!start || !out) {
-				free(ret);
-				free(out);
-				return NULL;
-			}
-			start++;
-			for (i = 0; i < 256; i += 2) {
-				char buf[3];
-
-				buf[0] = start[i];
-				buf[1] = start[i + 1];
-				buf[2] = 0;
-				out[out_index++] = strtol(buf, NULL, 16);
-			}
-			start = strstr(start, "<BLOCK");
-		} while (start);
-		edid_lines = out_index >> 4;
-		return out;
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	buf = malloc(buf_size);
+	if (!buf) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
 	}
 
-	/* Is the EDID provided in hex? */
-	for (i = 0; i < 32 && (isspace(ret[i]) || ret[i] == ',' ||
-			       tolower(ret[i]) == 'x' || isxdigit(ret[i])); i++);
-	if (i == 32) {
-		out = malloc(size >> 1);
-		if (out == NULL) {
-			free(ret);
-			return NULL;
-		}
-
-		for (c=ret; *c; c++) {
-			char buf[3];
-
-			if (!isxdigit(*c) || (*c == '0' && tolower(c[1]) == 'x'))
-				continue;
+	for (;;) {
+		while (!eof && len < buf_size) {
+			ssize_t n = read(fd, buf + len, buf_size - len);
 
-			/* Read a %02x from the log */
-			if (!isxdigit(c[0]) || !isxdigit(c[1])) {
-				free(ret);
-				free(out);
-				return NULL;
+			if (n < 0) {
+				perror(file);
+				ret = -1;
+				goto out;
 			}
-
-			buf[0] = c[0];
-			buf[1] = c[1];
-			buf[2] = 0;
-
-			out[out_index++] = strtol(buf, NULL, 16);
-			c++;
+			eof = !n;
+			len += n;
 		}
+		/* a header needs 8 bytes, a full EDID up to MAX_EDID_SIZE */
+		if (eof)
+			end = len > 7 ? len - 7 : 0;
+		else
+			end = len - MAX_EDID_SIZE;
 
-		free(ret);
-		edid_lines = out_index >> 4;
-		return out;
-	}
-
-	/* wait, is this a log file? */
-	for (i = 0; i < 8; i++) {
-		if (!isascii(ret[i])) {
-			edid_lines = len / 16;
-			return (unsigned char *)ret;
-		}
-	}
+		for (pos = find_header(buf, 0, end); pos < end;
+		     pos = find_header(buf, pos + 1, end)) {
+			unsigned size = carve_edid(buf + pos, len - pos);
+			char source[256];
 
-	/* I think it is, let's go scanning */
-	if (!(start = strstr(ret, "EDID (in hex):")))
-		return (unsigned char *)ret;
-	if (!(start = strstr(start, "(II)")))
-		return (unsigned char *)ret;
-
-	for (c = start; *c; c++) {
-		if (state == 0) {
-			char *s;
-			/* skip ahead to the : */
-			s = strstr(c, ": \t");
-			if (!s)
-				s = strstr(c, ":     ");
-			if (!s)
-				break;
-			c = s;
-			/* and find the first number */
-			while (!isxdigit(c[1]))
-				c++;
-			state = 1;
-			lines++;
-			s = realloc(out, lines * 16);
-			if (!s) {
-				free(ret);
-				free(out);
-				return NULL;
-			}
-			out = (unsigned char *)s;
-		} else if (state == 1) {
-			char buf[3];
-			/* Read a %02x from the log */
-			if (!isxdigit(*c)) {
-				state = 0;
+			if (!size)
 				continue;
+			snprintf(source, sizeof(source), "%s @ 0x%llx", file,
+				 base + pos);
+			if (out) {
+				/* keep the dump on stdout fit to be read back */
+				if (out == stdout)
+					fprintf(stderr, "---- %s ----\n", source);
+				write_edid(out, buf + pos, size, out_fmt, found);
 			}
-			buf[0] = c[0];
-			buf[1] = c[1];
-			buf[2] = 0;
-			out[out_index++] = strtol(buf, NULL, 16);
-			c++;
+			if (out != stdout) {
+				if (output_text)
+					fprintf(output, "%s---- %s ----\n",
+						found ? "\n" : "", source);
+				ret = batch_status(ret, decode_edid(output, buf + pos,
+								    size, source));
+			}
+			found++;
 		}
+		if (eof)
+			break;
+		memmove(buf, buf + end, len - end);
+		base += end;
+		len -= end;
+	}
+	if (!found) {
+		fprintf(stderr, "%s: no EDID found\n", file);
+		ret = -1;
 	}
+out:
+	free(buf);
+	if (fd != 0)
+		close(fd);
+	return ret;
+}
 
-	edid_lines = lines;
+/*
+ * Log mode: stream an Xorg or kernel log of any size and decode each EDID
+ * in it as soon as it has been read, named after the input and the line
+ * that starts it. Memory use does not grow with the log: it is read into
+ * a fixed buffer, and a line too long for it, which cannot be part of an
+ * EDID, is cut short.
+ */
+#define LOG_BUF_SIZE	(1 << 16)
 
-	free(ret);
+struct log_decode {
+	FILE *output;
+	const char *file;
+	unsigned found;
+	int ret;
+};
 
-	return out;
+static void log_decode_edid(struct edid_log *log, void *priv)
+{
+	struct log_decode *d = priv;
+	char source[256];
+
+	snprintf(source, sizeof(source), "%s (line %lu)", d->file, log->start);
+	if (output_text)
+		fprintf(d->output, "%s---- %s ----\n", d->found ? "\n" : "",
+			source);
+	d->ret = batch_status(d->ret, decode_edid(d->output, log->edid,
+						  log->size, source));
+	d->found++;
 }
 
-static void print_subsection(char *name, const unsigned char *edid, int start,
-			     int end)
+static int log_file(FILE *output, const char *file)
 {
-	int i;
+	struct log_decode d = { output, file, 0, 0 };
+	struct edid_log log;
+	size_t len = 0;
+	int skip = 0;	/* in the rest of a line that was cut short */
+	char *buf;
+	int fd;
 
-	printf("%s:", name);
-	for (i = strlen(name); i < 15; i++)
-		printf(" ");
-	for (i = start; i <= end; i++)
-		printf(" %02x", edid[i]);
-	printf("\n");
-}
+	if (!file || !strcmp(file, "-")) {
+		d.file = "-";
+		fd = 0;
+	} else if ((fd = open(file, O_RDONLY)) == -1) {
+		perror(file);
+		return -1;
+	}
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	memset(&log, 0, sizeof(log));
+	buf = malloc(LOG_BUF_SIZE);
+	log.edid = malloc(MAX_EDID_SIZE);
+	if (!buf || !log.edid) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	log.max_size = MAX_EDID_SIZE;
+	log.found = log_decode_edid;
+	log.priv = &d;
 
-static void dump_breakdown(const unsigned char *edid)
-{
-	printf("Extracted contents:\n");
-	print_subsection("header", edid, 0, 7);
-	print_subsection("serial number", edid, 8, 17);
-	print_subsection("version", edid,18, 19);
-	print_subsection("basic params", edid, 20, 24);
-	print_subsection("chroma info", edid, 25, 34);
-	print_subsection("established", edid, 35, 37);
-	print_subsection("standard", edid, 38, 53);
-	print_subsection("descriptor 1", edid, 54, 71);
-	print_subsection("descriptor 2", edid, 72, 89);
-	print_subsection("descriptor 3", edid, 90, 107);
-	print_subsection("descriptor 4", edid, 108, 125);
-	print_subsection("extensions", edid, 126, 126);
-	print_subsection("checksum", edid, 127, 127);
-	printf("\n");
+	for (;;) {
+		ssize_t n = read(fd, buf + len, LOG_BUF_SIZE - len);
+		const char *line = buf, *end, *nl;
+
+		if (n < 0) {
+			perror(d.file);
+			d.ret = -1;
+			break;
+		}
+		if (!n) {
+			if (len && !skip)
+				log_line(&log, buf, buf + len);
+			break;
+		}
+		end = buf + len + n;
+		while ((nl = memchr(line, '\n', end - line))) {
+			if (!skip)
+				log_line(&log, line, nl);
+			skip = 0;
+			line = nl + 1;
+		}
+		len = end - line;
+		if (len == LOG_BUF_SIZE) {
+			if (!skip)
+				log_line(&log, buf, end);
+			skip = 1;
+			len = 0;
+		} else {
+			memmove(buf, line, len);
+		}
+	}
+	log_end(&log);
+
+	if (!d.found && !d.ret) {
+		fprintf(stderr, "%s: no EDID found\n", d.file);
+		d.ret = -1;
+	}
+	free(log.edid);
+	free(buf);
+	if (fd != 0)
+		close(fd);
+	return d.ret;
 }
 
-static unsigned char crc_calc(const unsigned char *b)
+/*
+ * Batch mode frames each decode, unless all outputs are single lines that
+ * name their source: with only JSON output, the result is NDJSON.
+ */
+static int unframed_output(void)
 {
-	unsigned char sum = 0;
-	int i;
+	unsigned i;
 
-	for (i = 0; i < 127; i++)
-		sum += b[i];
-	return 256 - sum;
+	if (output_text || !num_outputs)
+		return 0;
+	for (i = 0; i < num_outputs; i++)
+		if (outputs[i] != EDID_OUTPUT_JSON &&
+		    outputs[i] != EDID_OUTPUT_CODES)
+			return 0;
+	return 1;
 }
 
-static int crc_ok(const unsigned char *b)
+static int parse_outputs(char *list)
 {
-	return crc_calc(b) == b[127];
+	char *fmt;
+
+	output_text = 0;
+	num_outputs = 0;
+	for (fmt = strtok(list, ","); fmt; fmt = strtok(NULL, ",")) {
+		if (!strcmp(fmt, "text")) {
+			output_text = 1;
+			continue;
+		}
+		if (num_outputs == ARRAY_SIZE(outputs))
+			return -1;
+		if (!strcmp(fmt, "timings")) {
+			outputs[num_outputs++] = EDID_OUTPUT_TIMINGS;
+		} else if (!strcmp(fmt, "json")) {
+			outputs[num_outputs++] = EDID_OUTPUT_JSON;
+		} else if (!strcmp(fmt, "findings")) {
+			outputs[num_outputs++] = EDID_OUTPUT_FINDINGS;
+			options[OptCheck] = 1;
+		} else if (!strcmp(fmt, "codes")) {
+			outputs[num_outputs++] = EDID_OUTPUT_CODES;
+			options[OptCheck] = 1;
+		} else {
+			return -1;
+		}
+	}
+	return 0;
 }
 
-static void hexdumpedid(FILE *f, const unsigned char *edid, unsigned size)
+static int parse_check_rules(char *list)
 {
-	unsigned b, i, j;
+	char *code, *end;
 
-	for (b = 0; b < size / 128; b++) {
-		const unsigned char *buf = edid + 128 * b;
+	for (code = strtok(list, ","); code; code = strtok(NULL, ",")) {
+		unsigned long v = strtoul(code, &end, 0);
 
-		if (b)
-			fprintf(f, "\n");
-		for (i = 0; i < 128; i += 0x10) {
-			fprintf(f, "%02x", buf[i]);
-			for (j = 1; j < 0x10; j++) {
-				fprintf(f, " %02x", buf[i + j]);
-			}
-			fprintf(f, "\n");
-		}
-		if (!crc_ok(buf))
-			fprintf(f, "Block %u has a checksum error (should be 0x%02x)\n",
-					b, crc_calc(buf));
+		/* only the conformance issues have a check rule */
+		if (*end || end == code || v < EDID_FINDING_SRGB_CHROMATICITY ||
+		    v > EDID_FINDING_LAST ||
+		    num_check_codes == ARRAY_SIZE(check_codes))
+			return -1;
+		check_codes[num_check_codes++] = v;
 	}
+	return num_check_codes ? 0 : -1;
 }
 
-static void carraydumpedid(FILE *f, const unsigned char *edid, unsigned size)
+/* Parse a --supports mode: <w>x<h>@<hz>[,i][,420] */
+static int parse_supports(const char *arg)
 {
-	unsigned b, i, j;
-
-	fprintf(f, "unsigned char edid[] = {\n");
-	for (b = 0; b < size / 128; b++) {
-		const unsigned char *buf = edid + 128 * b;
+	struct supports_query *q = &queries[num_queries];
+	const char *p;
+	char *end;
+	double refresh;
+	size_t len;
 
-		if (b)
-			fprintf(f, "\n");
-		for (i = 0; i < 128; i += 8) {
-			fprintf(f, "\t0x%02x,", buf[i]);
-			for (j = 1; j < 8; j++) {
-				fprintf(f, " 0x%02x,", buf[i + j]);
-			}
-			fprintf(f, "\n");
-		}
-		if (!crc_ok(buf))
-			fprintf(f, "\t/* Block %u has a checksum error (should be 0x%02x) */\n",
-					b, crc_calc(buf));
+	if (num_queries == ARRAY_SIZE(queries))
+		return -1;
+	q->arg = arg;
+	q->width = strtoul(arg, &end, 10);
+	if (end == arg || *end != 'x')
+		return -1;
+	p = end + 1;
+	q->height = strtoul(p, &end, 10);
+	if (end == p || *end != '@')
+		return -1;
+	p = end + 1;
+	refresh = strtod(p, &end);
+	if (end == p || refresh < 1 || refresh > 1000)
+		return -1;
+	q->refresh = refresh + 0.5;
+	q->flags = 0;
+	for (p = end; *p; p += len) {
+		if (*p++ != ',')
+			return -1;
+		len = strcspn(p, ",");
+		if (len == 1 && *p == 'i')
+			q->flags |= EDID_SUPPORTS_INTERLACED;
+		else if (len == 3 && !strncmp(p, "420", 3))
+			q->flags |= EDID_SUPPORTS_YCBCR420;
+		else
+			return -1;
 	}
-	fprintf(f, "};\n");
+	num_queries++;
+	return 0;
 }
 
-static void write_edid(FILE *f, const unsigned char *edid, unsigned size,
-		       enum output_format out_fmt)
+static int edid_carve(const char *from_file, const char *to_file,
+		      enum output_format out_fmt)
 {
-	switch (out_fmt) {
-	default:
-	case OUT_FMT_HEX:
-		hexdumpedid(f, edid, size);
-		break;
-	case OUT_FMT_RAW:
-		fwrite(edid, size, 1, f);
-		break;
-	case OUT_FMT_CARRAY:
-		carraydumpedid(f, edid, size);
-		break;
+	FILE *out = NULL;
+	int ret;
+
+	if (to_file) {
+		if (!strcmp(to_file, "-")) {
+			out = stdout;
+		} else if ((out = fopen(to_file, "w")) == NULL) {
+			perror(to_file);
+			return -1;
+		}
+		if (out_fmt == OUT_FMT_DEFAULT)
+			out_fmt = out == stdout ? OUT_FMT_HEX : OUT_FMT_RAW;
 	}
+	ret = carve_file(stdout, from_file, out, out_fmt);
+	if (out && out != stdout)
+		fclose(out);
+	return ret;
 }
 
 static int edid_from_file(const char *from_file, const char *to_file,
 			  enum output_format out_fmt)
 {
-	int fd;
+	struct edid_input in;
 	FILE *out = NULL;
-	unsigned char *edid;
-	unsigned char *x;
-	time_t the_time;
-	struct tm *ptm;
-	int analog, i;
-	unsigned col_x, col_y;
+	unsigned i;
+	int ret;
+
+	if (edid_read_file(from_file, &in))
+		return decode_input(stdout, &in, from_file ? from_file : "-");
 
-	if (!from_file || !strcmp(from_file, "-")) {
-		fd = 0;
-	} else if ((fd = open(from_file, O_RDONLY)) == -1) {
-		perror(from_file);
-		return -1;
-	}
 	if (to_file) {
 		if (!strcmp(to_file, "-")) {
 			out = stdout;
 		} else if ((out = fopen(to_file, "w")) == NULL) {
 			perror(to_file);
+			edid_input_free(&in);
 			return -1;
 		}
 		if (out_fmt == OUT_FMT_DEFAULT)
 			out_fmt = out == stdout ? OUT_FMT_HEX : OUT_FMT_RAW;
-	}
-
-	edid = extract_edid(fd);
-	if (!edid) {
-		fprintf(stderr, "edid extract failed\n");
-		return -1;
-	}
-	if (fd != 0)
-		close(fd);
 
-	if (out) {
-		write_edid(out, edid, edid_lines * 16, out_fmt);
-		if (out == stdout)
+		for (i = 0; i < in.num_edids; i++)
+			write_edid(out, in.edids[i].edid, in.edids[i].size,
+				   out_fmt, i);
+		if (out == stdout) {
+			edid_input_free(&in);
 			return 0;
+		}
 		fclose(out);
 	}
 
-	if (options[OptExtract])
-		dump_breakdown(edid);
+	ret = decode_input(stdout, &in, from_file ? from_file : "-");
+	edid_input_free(&in);
+	return ret;
+}
 
-	if (!edid || memcmp(edid, "\x00\xFF\xFF\xFF\xFF\xFF\xFF\x00", 8)) {
-		fprintf(stderr, "No header found\n");
-		return -1;
+/*
+ * Batch mode: decode every file from the command line, or every file
+ * listed on standard input if none were given, each with a fresh state.
+ * Directories are expanded recursively in name order. Each decode is
+ * framed by a header and a trailer carrying the exit status a single
+ * invocation would have returned for that file.
+ */
+static int edid_batch_decode(FILE *output, const char *file)
+{
+	int framed = !unframed_output();
+	struct edid_input in;
+	int ret;
+
+	if (framed) {
+		fprintf(output, "==== %s ====\n", file);
+		fflush(output);
+	}
+	if (options[OptCarve]) {
+		ret = carve_file(output, file, NULL, OUT_FMT_DEFAULT);
+	} else if (options[OptLog]) {
+		ret = log_file(output, file);
+	} else {
+		edid_read_file(file, &in);
+		ret = decode_input(output, &in, file);
+		edid_input_free(&in);
 	}
+	if (framed)
+		fprintf(output, "==== %s: exit status %d ====\n\n", file, ret & 0xff);
+	return ret;
+}
 
-	cur_block = "EDID Structure Version & Revision";
-	printf("EDID version: %hd.%hd\n", edid[0x12], edid[0x13]);
-	if (edid[0x12] == 1) {
-		if (edid[0x13] > 4) {
-			printf("Claims > 1.4, assuming 1.4 conformance\n");
-			edid[0x13] = 4;
-		}
-		edid_minor = edid[0x13];
-		switch (edid[0x13]) {
-		case 4:
-			claims_one_point_four = 1;
-		case 3:
-			claims_one_point_three = 1;
-		case 2:
-			claims_one_point_two = 1;
-		default:
-			break;
+typedef void (*input_fn)(const char *file, void *priv);
+
+static int skip_dot_dirs(const struct dirent *d)
+{
+	return strcmp(d->d_name, ".") && strcmp(d->d_name, "..");
+}
+
+static void for_each_input_file(const char *file, input_fn fn, void *priv)
+{
+	struct dirent **names;
+	struct stat st;
+	int i, n;
+
+	if (strcmp(file, "-") && !stat(file, &st) && S_ISDIR(st.st_mode)) {
+		n = scandir(file, &names, skip_dot_dirs, alphasort);
+		if (n < 0) {
+			perror(file);
+			return;
 		}
-		claims_one_point_oh = 1;
-	}
+		for (i = 0; i < n; i++) {
+			char *path = malloc(strlen(file) + strlen(names[i]->d_name) + 2);
 
-	cur_block = "Vendor & Product Identification";
-	printf("Manufacturer: %s Model %x Serial Number %u\n",
-	       manufacturer_name(edid + 0x08),
-	       (unsigned short)(edid[0x0A] + (edid[0x0B] << 8)),
-	       (unsigned int)(edid[0x0C] + (edid[0x0D] << 8)
-			      + (edid[0x0E] << 16) + (edid[0x0F] << 24)));
-	has_valid_serial_number = edid[0x0C] || edid[0x0D] || edid[0x0E] || edid[0x0F];
-	/* XXX need manufacturer ID table */
-
-	time(&the_time);
-	ptm = localtime(&the_time);
-	if (edid[0x10] < 55 || (edid[0x10] == 0xff && claims_one_point_four)) {
-		has_valid_week = 1;
-		if (edid[0x11] > 0x0f) {
-			if (edid[0x10] == 0xff) {
-				has_valid_year = 1;
-				printf("Model year %hd\n", edid[0x11] + 1990);
-			} else if (edid[0x11] + 90 <= ptm->tm_year + 1) {
-				has_valid_year = 1;
-				if (edid[0x10])
-					printf("Made in week %hd of %hd\n", edid[0x10], edid[0x11] + 1990);
-				else
-					printf("Made in year %hd\n", edid[0x11] + 1990);
+			if (path) {
+				sprintf(path, "%s/%s", file, names[i]->d_name);
+				for_each_input_file(path, fn, priv);
+				free(path);
 			}
+			free(names[i]);
 		}
+		free(names);
+		return;
 	}
-		if (!has_valid_year)
-			warn("Invalid year\n");
-
-	/* display section */
-
-	cur_block = "Basic Display Parameters & Features";
-	if (edid[0x14] & 0x80) {
-		int conformance_mask;
-		analog = 0;
-		printf("Digital display\n");
-		if (claims_one_point_four) {
-			conformance_mask = 0;
-			if ((edid[0x14] & 0x70) == 0x00)
-				printf("Color depth is undefined\n");
-			else if ((edid[0x14] & 0x70) == 0x70)
-				nonconformant_digital_display = 1;
-			else
-				printf("%d bits per primary color channel\n",
-				       ((edid[0x14] & 0x70) >> 3) + 4);
-
-			switch (edid[0x14] & 0x0f) {
-			case 0x00: printf("Digital interface is not defined\n"); break;
-			case 0x01: printf("DVI interface\n"); break;
-			case 0x02: printf("HDMI-a interface\n"); break;
-			case 0x03: printf("HDMI-b interface\n"); break;
-			case 0x04: printf("MDDI interface\n"); break;
-			case 0x05: printf("DisplayPort interface\n"); break;
-			default:
-				   nonconformant_digital_display = 1;
-			}
-		} else if (claims_one_point_two) {
-			conformance_mask = 0x7E;
-			if (edid[0x14] & 0x01) {
-				printf("DFP 1.x compatible TMDS\n");
-			}
-		} else conformance_mask = 0x7F;
-		if (!nonconformant_digital_display)
-			nonconformant_digital_display = edid[0x14] & conformance_mask;
-	} else {
-		analog = 1;
-		int voltage = (edid[0x14] & 0x60) >> 5;
-		int sync = (edid[0x14] & 0x0F);
-		printf("Analog display, Input voltage level: %s V\n",
-		       voltage == 3 ? "0.7/0.7" :
-		       voltage == 2 ? "1.0/0.4" :
-		       voltage == 1 ? "0.714/0.286" :
-		       "0.7/0.3");
-
-		if (claims_one_point_four) {
-			if (edid[0x14] & 0x10)
-				printf("Blank-to-black setup/pedestal\n");
-			else
-				printf("Blank level equals black level\n");
-		} else if (edid[0x14] & 0x10) {
-			/*
-			 * XXX this is just the X text.  1.3 says "if set, display expects
-			 * a blank-to-black setup or pedestal per appropriate Signal
-			 * Level Standard".  Whatever _that_ means.
-			 */
-			printf("Configurable signal levels\n");
-		}
+	fn(file, priv);
+}
 
-		printf("Sync: %s%s%s%s\n", sync & 0x08 ? "Separate " : "",
-		       sync & 0x04 ? "Composite " : "",
-		       sync & 0x02 ? "SyncOnGreen " : "",
-		       sync & 0x01 ? "Serration " : "");
-	}
+static void for_each_input(int nfiles, char **files, input_fn fn, void *priv)
+{
+	char *line = NULL;
+	size_t size = 0;
+	ssize_t len;
+	int i;
 
-	if (edid[0x15] && edid[0x16])
-		printf("Maximum image size: %d cm x %d cm\n", edid[0x15], edid[0x16]);
-	else if (claims_one_point_four && (edid[0x15] || edid[0x16])) {
-		if (edid[0x15])
-			printf("Aspect ratio is %f (landscape)\n", 100.0/(edid[0x16] + 99));
-		else
-			printf("Aspect ratio is %f (portrait)\n", 100.0/(edid[0x15] + 99));
-	} else {
-		/* Either or both can be zero for 1.3 and before */
-		printf("Image size is variable\n");
-	}
+	for (i = 0; i < nfiles; i++)
+		for_each_input_file(files[i], fn, priv);
+	if (nfiles)
+		return;
 
-	if (edid[0x17] == 0xff) {
-		if (claims_one_point_four)
-			printf("Gamma is defined in an extension block\n");
-		else
-			/* XXX Technically 1.3 doesn't say this... */
-			printf("Gamma: 1.0\n");
-	} else printf("Gamma: %.2f\n", ((edid[0x17] + 100.0) / 100.0));
-
-	if (edid[0x18] & 0xE0) {
-		printf("DPMS levels:");
-		if (edid[0x18] & 0x80) printf(" Standby");
-		if (edid[0x18] & 0x40) printf(" Suspend");
-		if (edid[0x18] & 0x20) printf(" Off");
-		printf("\n");
+	while ((len = getline(&line, &size, stdin)) >= 0) {
+		while (len && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+			line[--len] = 0;
+		if (len)
+			for_each_input_file(line, fn, priv);
 	}
+	free(line);
+}
 
-	if (analog || !claims_one_point_four) {
-		switch (edid[0x18] & 0x18) {
-		case 0x00: printf("Monochrome or grayscale display\n"); break;
-		case 0x08: printf("RGB color display\n"); break;
-		case 0x10: printf("Non-RGB color display\n"); break;
-		case 0x18: printf("Undefined display color type\n");
-		}
-	} else {
-		printf("Supported color formats: RGB 4:4:4");
-		if (edid[0x18] & 0x08)
-			printf(", YCrCb 4:4:4");
-		if (edid[0x18] & 0x10)
-			printf(", YCrCb 4:2:2");
-		printf("\n");
-	}
+static void batch_one(const char *file, void *priv)
+{
+	int *ret = priv;
 
-	if (edid[0x18] & 0x04) {
-		/*
-		 * The sRGB chromaticities are (x, y):
-		 * red:   0.640,  0.330
-		 * green: 0.300,  0.600
-		 * blue:  0.150,  0.060
-		 * white: 0.3127, 0.3290
-		 */
-		static const unsigned char srgb_chromaticity[10] = {
-			0xee, 0x91, 0xa3, 0x54, 0x4c, 0x99, 0x26, 0x0f, 0x50, 0x54
-		};
-		printf("Default (sRGB) color space is primary color space\n");
-		nonconformant_srgb_chromaticity =
-			memcmp(edid + 0x19, srgb_chromaticity, sizeof(srgb_chromaticity));
-	}
-	if (edid[0x18] & 0x02) {
-		if (claims_one_point_four)
-			printf("First detailed timing includes the native pixel format and preferred refresh rate\n");
-		else
-			printf("First detailed timing is preferred timing\n");
-		has_preferred_timing = 1;
-	} else if (claims_one_point_four) {
-		/* 1.4 always has a preferred timing and this bit means something else. */
-		has_preferred_timing = 1;
-	}
+	*ret = batch_status(*ret, edid_batch_decode(stdout, file));
+}
 
-	if (edid[0x18] & 0x01) {
-		if (claims_one_point_four)
-			printf("Display is continuous frequency\n");
-		else
-			printf("Supports GTF timings within operating range\n");
-	}
+static int edid_batch(int nfiles, char **files)
+{
+	int ret = 0;
+
+	for_each_input(nfiles, files, batch_one, &ret);
+	return ret;
+}
+
+/*
+ * Parallel batch mode (--jobs).
+ *
+ * Every worker owns a deque of job indices, filled round-robin so that
+ * all workers start at the front of the list. A worker takes jobs from
+ * the head of its own deque and, once that runs dry, steals from the
+ * tail of the other deques. The main thread acts as the reorder buffer:
+ * it writes the captured output of each job strictly in job order, so
+ * the result is byte-for-byte identical to a serial --batch run. Workers
+ * do not start a job more than JOB_WINDOW jobs ahead of the output, which
+ * bounds the amount of buffered output regardless of the corpus size.
+ */
+enum {
+	JOB_WINDOW = 256
+};
+
+struct job {
+	char *file;
+	char *output;
+	size_t len;
+	int status;
+	int done;
+};
+
+struct job_deque {
+	pthread_mutex_t lock;
+	unsigned *idx;
+	unsigned head, tail;
+};
+
+struct job_pool {
+	struct job *jobs;
+	unsigned num_jobs, max_jobs;
+	struct job_deque *deques;
+	unsigned num_workers;
+	unsigned window;
+
+	pthread_mutex_t lock;
+	pthread_cond_t job_done;
+	pthread_cond_t output_done;
+	unsigned next_output;
+};
+
+struct job_worker {
+	struct job_pool *pool;
+	unsigned id;
+};
+
+static void pool_add_job(const char *file, void *priv)
+{
+	struct job_pool *pool = priv;
+
+	if (pool->num_jobs == pool->max_jobs) {
+		unsigned max = pool->max_jobs ? pool->max_jobs * 2 : 1024;
+		struct job *jobs = realloc(pool->jobs, max * sizeof(*jobs));
 
-	cur_block = "Color Characteristics";
-	printf("Display x,y Chromaticity:\n");
-	col_x = (edid[0x1b] << 2) | (edid[0x19] >> 6);
-	col_y = (edid[0x1c] << 2) | ((edid[0x19] >> 4) & 3);
-	printf("  Red:   0.%04u, 0.%04u\n",
-	       (col_x * 10000) / 1024, (col_y * 10000) / 1024);
-	col_x = (edid[0x1d] << 2) | ((edid[0x19] >> 2) & 3);
-	col_y = (edid[0x1e] << 2) | (edid[0x19] & 3);
-	printf("  Green: 0.%04u, 0.%04u\n",
-	       (col_x * 10000) / 1024, (col_y * 10000) / 1024);
-	col_x = (edid[0x1f] << 2) | (edid[0x1a] >> 6);
-	col_y = (edid[0x20] << 2) | ((edid[0x1a] >> 4) & 3);
-	printf("  Blue:  0.%04u, 0.%04u\n",
-	       (col_x * 10000) / 1024, (col_y * 10000) / 1024);
-	col_x = (edid[0x21] << 2) | ((edid[0x1a] >> 2) & 3);
-	col_y = (edid[0x22] << 2) | (edid[0x1a] & 3);
-	printf("  White: 0.%04u, 0.%04u\n",
-	       (col_x * 10000) / 1024, (col_y * 10000) / 1024);
-
-	cur_block = "Established Timings";
-	printf("Established timings supported:\n");
-	for (i = 0; i < 17; i++) {
-		if (edid[0x23 + i / 8] & (1 << (7 - i % 8))) {
-			min_vert_freq_hz = min(min_vert_freq_hz, established_timings[i].refresh);
-			max_vert_freq_hz = max(max_vert_freq_hz, established_timings[i].refresh);
-			min_hor_freq_hz = min(min_hor_freq_hz, established_timings[i].hor_freq_hz);
-			max_hor_freq_hz = max(max_hor_freq_hz, established_timings[i].hor_freq_hz);
-			max_pixclk_khz = max(max_pixclk_khz, established_timings[i].pixclk_khz);
-			printf("  %dx%d%s@%dHz %u:%u HorFreq: %d Hz Clock: %.3f MHz\n",
-			       established_timings[i].x, established_timings[i].y,
-			       established_timings[i].interlaced ? "i" : "",
-			       established_timings[i].refresh,
-			       established_timings[i].ratio_w, established_timings[i].ratio_h,
-			       established_timings[i].hor_freq_hz,
-			       established_timings[i].pixclk_khz / 1000.0);
+		if (!jobs) {
+			fprintf(stderr, "out of memory, skipping %s\n", file);
+			return;
 		}
+		pool->jobs = jobs;
+		pool->max_jobs = max;
 	}
-	has_640x480p60_est_timing = edid[0x23] & 0x20;
+	memset(&pool->jobs[pool->num_jobs], 0, sizeof(*pool->jobs));
+	pool->jobs[pool->num_jobs].file = strdup(file);
+	if (pool->jobs[pool->num_jobs].file)
+		pool->num_jobs++;
+}
 
-	cur_block = "Standard Timings";
-	printf("Standard timings supported:\n");
-	for (i = 0; i < 8; i++)
-		print_standard_timing(edid[0x26 + i * 2], edid[0x26 + i * 2 + 1]);
-
-	/* detailed timings */
-	cur_block = "Detailed Timings";
-	has_valid_detailed_blocks = detailed_block(edid + 0x36, 0);
-	if (has_preferred_timing && !did_detailed_timing)
-		has_preferred_timing = 0; /* not really accurate... */
-	has_valid_detailed_blocks &= detailed_block(edid + 0x48, 0);
-	has_valid_detailed_blocks &= detailed_block(edid + 0x5A, 0);
-	has_valid_detailed_blocks &= detailed_block(edid + 0x6C, 0);
-
-	if (edid[0x7e])
-		printf("Has %d extension blocks\n", edid[0x7e]);
-
-	has_valid_checksum = do_checksum(edid, EDID_PAGE_SIZE);
-
-	x = edid;
-	for (edid_lines /= 8; edid_lines > 1; edid_lines--) {
-		x += EDID_PAGE_SIZE;
-		printf("\n----------------\n");
-		nonconformant_extension += parse_extension(x);
+static int pool_get_job(struct job_pool *pool, unsigned id, unsigned *idx)
+{
+	struct job_deque *d = &pool->deques[id];
+	unsigned i;
+
+	pthread_mutex_lock(&d->lock);
+	if (d->head < d->tail) {
+		*idx = d->idx[d->head++];
+		pthread_mutex_unlock(&d->lock);
+		return 1;
+	}
+	pthread_mutex_unlock(&d->lock);
+
+	for (i = 1; i < pool->num_workers; i++) {
+		d = &pool->deques[(id + i) % pool->num_workers];
+		pthread_mutex_lock(&d->lock);
+		if (d->head < d->tail) {
+			*idx = d->idx[--d->tail];
+			pthread_mutex_unlock(&d->lock);
+			return 1;
+		}
+		pthread_mutex_unlock(&d->lock);
 	}
+	return 0;
+}
 
-	if (!options[OptCheck]) {
-		free(edid);
-		return 0;
-	}
+static void *pool_worker(void *arg)
+{
+	struct job_worker *w = arg;
+	struct job_pool *pool = w->pool;
+	unsigned idx;
+
+	while (pool_get_job(pool, w->id, &idx)) {
+		struct job *job = &pool->jobs[idx];
+		FILE *f;
+
+		pthread_mutex_lock(&pool->lock);
+		while (idx >= pool->next_output + pool->window)
+			pthread_cond_wait(&pool->output_done, &pool->lock);
+		pthread_mutex_unlock(&pool->lock);
+
+		f = open_memstream(&job->output, &job->len);
+		if (f) {
+			job->status = edid_batch_decode(f, job->file);
+			fclose(f);
+		} else {
+			perror(job->file);
+			job->status = -1;
+		}
 
-	printf("\n----------------\n\n");
-
-	if (claims_one_point_three) {
-		if (nonconformant_digital_display ||
-		    nonconformant_hf_vsdb_position ||
-		    duplicate_scdb ||
-		    nonconformant_hdmi_vsdb_tmds_rate ||
-		    nonconformant_hf_vsdb_tmds_rate ||
-		    nonconformant_hf_eeodb ||
-		    nonconformant_srgb_chromaticity ||
-		    nonconformant_cta861_640x480 ||
-		    !has_valid_string_termination ||
-		    !has_valid_descriptor_pad ||
-		    !has_name_descriptor ||
-		    !has_preferred_timing ||
-		    (!claims_one_point_four && !has_range_descriptor))
-			conformant = 0;
-		if (!conformant)
-			printf("EDID block does NOT conform to EDID 1.%d!\n", edid_minor);
-		if (nonconformant_srgb_chromaticity)
-			printf("\tsRGB is signaled, but the chromaticities do not match\n");
-		if (nonconformant_digital_display)
-			printf("\tDigital display field contains garbage: %x\n",
-			       nonconformant_digital_display);
-		if (nonconformant_cta861_640x480)
-			printf("\tRequired 640x480p60 timings are missing in the established timings\n"
-			       "\tand/or in the SVD list (VIC 1)\n");
-		if (nonconformant_hf_vsdb_position)
-			printf("\tHDMI Forum VSDB or SCDB did not immediately follow the HDMI VSDB\n");
-		if (duplicate_scdb)
-			printf("\tDuplicate HDMI Forum VSDB/SCDB\n");
-		if (nonconformant_hdmi_vsdb_tmds_rate)
-			printf("\tHDMI VSDB Max TMDS rate is > 340\n");
-		if (nonconformant_hf_vsdb_tmds_rate)
-			printf("\tHDMI Forum VSDB Max TMDS rate is > 0 and <= 340 or > 600\n");
-		if (nonconformant_hf_eeodb)
-			printf("\tHDMI Forum EDID Extension Override Data Block starts at a wrong offset or is too long or reports a 0 block count\n");
-		if (!has_name_descriptor)
-			printf("\tMissing name descriptor\n");
-		if (!has_preferred_timing)
-			printf("\tMissing preferred timing\n");
-		if (!has_range_descriptor)
-			printf("\tMissing monitor ranges\n");
-		if (!has_valid_descriptor_pad) /* Might be more than just 1.3 */
-			printf("\tInvalid descriptor block padding\n");
-		if (!has_valid_string_termination) /* Likewise */
-			printf("\tDetailed block string not properly terminated\n");
-	} else if (claims_one_point_two) {
-		if (nonconformant_digital_display)
-			conformant = 0;
-		if (!conformant)
-			printf("EDID block does NOT conform to EDID 1.2!\n");
-		if (nonconformant_digital_display)
-			printf("\tDigital display field contains garbage: %x\n",
-			       nonconformant_digital_display);
-	} else if (claims_one_point_oh) {
-		if (seen_non_detailed_descriptor)
-			conformant = 0;
-		if (!conformant)
-			printf("EDID block does NOT conform to EDID 1.0!\n");
-		if (seen_non_detailed_descriptor)
-			printf("\tHas descriptor blocks other than detailed timings\n");
+		pthread_mutex_lock(&pool->lock);
+		job->done = 1;
+		pthread_cond_signal(&pool->job_done);
+		pthread_mutex_unlock(&pool->lock);
 	}
+	return NULL;
+}
 
-	if (has_range_descriptor && has_valid_range_descriptor &&
-	    (min_vert_freq_hz < mon_min_vert_freq_hz ||
-	     max_vert_freq_hz > mon_max_vert_freq_hz ||
-	     min_hor_freq_hz < mon_min_hor_freq_hz ||
-	     max_hor_freq_hz > mon_max_hor_freq_hz ||
-	     max_pixclk_khz > mon_max_pixclk_khz)) {
-		/*
-		 * EDID 1.4 states (in an Errata) that explicitly defined
-		 * timings supersede the monitor range definition.
-		 */
-		if (!claims_one_point_four)
-			conformant = 0;
-		else
-			printf("Warning: ");
-		printf("One or more of the timings is out of range of the Monitor Ranges:\n");
-		printf("  Vertical Freq: %d - %d Hz (Monitor: %d - %d Hz)\n",
-		       min_vert_freq_hz, max_vert_freq_hz,
-		       mon_min_vert_freq_hz, mon_max_vert_freq_hz);
-		printf("  Horizontal Freq: %d - %d Hz (Monitor: %d - %d Hz)\n",
-		       min_hor_freq_hz, max_hor_freq_hz,
-		       mon_min_hor_freq_hz, mon_max_hor_freq_hz);
-		printf("  Maximum Clock: %.3f MHz (Monitor: %.3f MHz)\n",
-		       max_pixclk_khz / 1000.0, mon_max_pixclk_khz / 1000.0);
-	}
+static int edid_batch_jobs(int nfiles, char **files, unsigned num_workers)
+{
+	struct job_pool pool;
+	struct job_worker *workers;
+	pthread_t *threads;
+	unsigned started = 0;
+	unsigned i;
+	int ret = 0;
 
-	if (nonconformant_extension ||
-	    !has_valid_checksum ||
-	    !has_valid_cvt ||
-	    !has_valid_year ||
-	    !has_valid_week ||
-	    (has_cta861 && has_valid_serial_number && has_valid_serial_string) ||
-	    !has_valid_detailed_blocks ||
-	    !has_valid_dummy_block ||
-	    !has_valid_descriptor_ordering ||
-	    !has_valid_range_descriptor ||
-	    !manufacturer_name_well_formed ||
-	    (has_name_descriptor && !has_valid_name_descriptor) ||
-	    (has_serial_string && !has_valid_serial_string) ||
-	    (has_ascii_string && !has_valid_ascii_string) ||
-	    empty_string ||
-	    trailing_space) {
-		conformant = 0;
-		printf("EDID block does not conform:\n");
-		if (nonconformant_extension)
-			printf("\tHas %d nonconformant extension block(s)\n",
-			       nonconformant_extension);
-		if (!has_valid_checksum)
-			printf("\tBlock has broken checksum\n");
-		if (!has_valid_cvt)
-			printf("\tBroken 3-byte CVT blocks\n");
-		if (!has_valid_year)
-			printf("\tBad year of manufacture\n");
-		if (!has_valid_week)
-			printf("\tBad week of manufacture\n");
-		if (has_cta861 && has_valid_serial_number && has_valid_serial_string)
-			printf("\tBoth the serial number and the serial string are set\n");
-		if (!has_valid_detailed_blocks)
-			printf("\tDetailed blocks filled with garbage\n");
-		if (!has_valid_dummy_block)
-			printf("\tDummy block filled with garbage\n");
-		if (!manufacturer_name_well_formed)
-			printf("\tManufacturer name field contains garbage\n");
-		if (!has_valid_descriptor_ordering)
-			printf("\tInvalid detailed timing descriptor ordering\n");
-		if (!has_valid_range_descriptor)
-			printf("\tRange descriptor contains garbage\n");
-		if (!has_valid_max_dotclock)
-			printf("\tEDID 1.4 block does not set max dotclock\n");
-		if (has_name_descriptor && !has_valid_name_descriptor)
-			printf("\tInvalid Monitor Name descriptor\n");
-		if (has_ascii_string && !has_valid_ascii_string)
-			printf("\tInvalid ASCII string\n");
-		if (has_serial_string && !has_valid_serial_string)
-			printf("\tInvalid serial string\n");
-		if (trailing_space)
-			printf("\tString contains one or more trailing spaces\n");
-		if (empty_string)
-			printf("\tString is empty\n");
+	memset(&pool, 0, sizeof(pool));
+	for_each_input(nfiles, files, pool_add_job, &pool);
+	if (num_workers > pool.num_jobs)
+		num_workers = pool.num_jobs ? pool.num_jobs : 1;
+
+	pool.num_workers = num_workers;
+	pool.window = JOB_WINDOW * num_workers;
+	pool.deques = calloc(num_workers, sizeof(*pool.deques));
+	workers = calloc(num_workers, sizeof(*workers));
+	threads = calloc(num_workers, sizeof(*threads));
+	if (!pool.deques || !workers || !threads) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	pthread_mutex_init(&pool.lock, NULL);
+	pthread_cond_init(&pool.job_done, NULL);
+	pthread_cond_init(&pool.output_done, NULL);
+
+	for (i = 0; i < num_workers; i++) {
+		struct job_deque *d = &pool.deques[i];
+
+		pthread_mutex_init(&d->lock, NULL);
+		d->idx = malloc((pool.num_jobs / num_workers + 1) * sizeof(*d->idx));
+		if (!d->idx) {
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
 	}
+	for (i = 0; i < pool.num_jobs; i++) {
+		struct job_deque *d = &pool.deques[i % num_workers];
 
-	if (!has_valid_cta_checksum) {
-		printf("CTA extension block does not conform\n");
-		printf("\tBlock has broken checksum\n");
+		d->idx[d->tail++] = i;
 	}
-	if (!has_valid_displayid_checksum) {
-		printf("DisplayID extension block does not conform\n");
-		printf("\tBlock has broken checksum\n");
+
+	for (i = 0; i < num_workers; i++) {
+		workers[i].pool = &pool;
+		workers[i].id = i;
+		if (pthread_create(&threads[i], NULL, pool_worker, &workers[i]))
+			break;
+		started++;
 	}
 
-	if (warning_excessive_dotclock_correction)
-		printf("Warning: CVT block corrects dotclock by more than 9.75MHz\n");
-	if (warning_zero_preferred_refresh)
-		printf("Warning: CVT block does not set preferred refresh rate\n");
-	if ((supported_hdmi_vic_vsb_codes & supported_hdmi_vic_codes) != supported_hdmi_vic_codes)
-		printf("Warning: HDMI VIC Codes must have their CTA-861 VIC equivalents in the VSB\n");
-
-	free(edid);
-	if (s_warn)
-		printf("%s", s_warn);
-	if (conformant)
-		printf("No issues found\n");
-	return conformant ? 0 : -2;
+	for (i = 0; i < pool.num_jobs; i++) {
+		struct job *job = &pool.jobs[i];
+
+		/* with no thread at all, decode each file here as --batch does */
+		if (!started) {
+			ret = batch_status(ret, edid_batch_decode(stdout, job->file));
+			free(job->file);
+			continue;
+		}
+
+		pthread_mutex_lock(&pool.lock);
+		while (!job->done)
+			pthread_cond_wait(&pool.job_done, &pool.lock);
+		pthread_mutex_unlock(&pool.lock);
+
+		fwrite(job->output, 1, job->len, stdout);
+		ret = batch_status(ret, job->status);
+		free(job->output);
+		free(job->file);
+
+		pthread_mutex_lock(&pool.lock);
+		pool.next_output++;
+		pthread_cond_broadcast(&pool.output_done);
+		pthread_mutex_unlock(&pool.lock);
+	}
+
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i], NULL);
+	for (i = 0; i < num_workers; i++) {
+		pthread_mutex_destroy(&pool.deques[i].lock);
+		free(pool.deques[i].idx);
+	}
+	pthread_cond_destroy(&pool.output_done);
+	pthread_cond_destroy(&pool.job_done);
+	pthread_mutex_destroy(&pool.lock);
+	free(pool.deques);
+	free(pool.jobs);
+	free(workers);
+	free(threads);
+	return ret;
 }
 
 int main(int argc, char **argv)
 {
 	char short_options[26 * 2 * 2 + 1];
 	enum output_format out_fmt = OUT_FMT_DEFAULT;
+	unsigned jobs = 1;
 	int ch;
 	int i;
 
+	simd_init();
 	while (1) {
 		int option_index = 0;
 		int idx = 0;
@@ -3668,6 +1937,36 @@ int main(int argc, char **argv)
 				exit(1);
 			}
 			break;
+		case OptOutput:
+			if (parse_outputs(optarg)) {
+				usage();
+				exit(1);
+			}
+			break;
+		case OptCheckRules:
+			if (parse_check_rules(optarg)) {
+				usage();
+				exit(1);
+			}
+			options[OptCheck] = 1;
+			break;
+		case OptSupports:
+			if (parse_supports(optarg)) {
+				usage();
+				exit(1);
+			}
+			break;
+		case OptQuiet:
+		case OptFailFast:
+			options[OptCheck] = 1;
+			break;
+		case OptJobs:
+			jobs = strtoul(optarg, NULL, 0);
+			if (!jobs) {
+				usage();
+				exit(1);
+			}
+			break;
 		case ':':
 			fprintf(stderr, "Option `%s' requires a value\n",
 				argv[optind]);
@@ -3680,64 +1979,27 @@ int main(int argc, char **argv)
 			return -1;
 		}
 	}
+	if (options[OptQuiet]) {
+		output_text = 0;
+		options[OptCheck] = 1;
+	}
+	if (jobs > 1)
+		return edid_batch_jobs(argc - optind, argv + optind, jobs);
+	if (options[OptBatch] || options[OptJobs])
+		return edid_batch(argc - optind, argv + optind);
+	if (options[OptLog] && (options[OptCarve] || optind < argc - 1)) {
+		usage();
+		exit(1);
+	}
+	if (options[OptLog])
+		return log_file(stdout, optind < argc ? argv[optind] : NULL);
+	if (options[OptCarve])
+		return edid_carve(optind < argc ? argv[optind] : NULL,
+				  optind < argc - 1 ? argv[optind + 1] : NULL,
+				  out_fmt);
 	if (optind == argc)
 		return edid_from_file(NULL, NULL, out_fmt);
 	if (optind == argc - 1)
 		return edid_from_file(argv[optind], NULL, out_fmt);
 	return edid_from_file(argv[optind], argv[optind + 1], out_fmt);
 }
-
-/*
- * Notes on panel extensions: (TODO, implement me in the code)
- *
- * EPI: http://www.epi-standard.org/fileadmin/spec/EPI_Specification1.0.pdf
- * at offset 0x6c (fourth detailed block): (all other bits reserved)
- * 0x6c: 00 00 00 0e 00
- * 0x71: bit 6-5: data color mapping (00 conventional/fpdi/vesa, 01 openldi)
- *       bit 4-3: pixels per clock (00 1, 01 2, 10 4, 11 reserved)
- *       bit 2-0: bits per pixel (000 18, 001 24, 010 30, else reserved)
- * 0x72: bit 5: FPSCLK polarity (0 normal 1 inverted)
- *       bit 4: DE polarity (0 high active 1 low active)
- *       bit 3-0: interface (0000 LVDS TFT
- *                           0001 mono STN 4/8bit
- *                           0010 color STN 8/16 bit
- *                           0011 18 bit tft
- *                           0100 24 bit tft
- *                           0101 tmds
- *                           else reserved)
- * 0x73: bit 1: horizontal display mode (0 normal 1 right/left reverse)
- *       bit 0: vertical display mode (0 normal 1 up/down reverse)
- * 0x74: bit 7-4: total poweroff seq delay (0000 vga controller default
- *                                          else time in 10ms (10ms to 150ms))
- *       bit 3-0: total poweron seq delay (as above)
- * 0x75: contrast power on/off seq delay, same as 0x74
- * 0x76: bit 7: backlight control enable (1 means this field is valid)
- *       bit 6: backlight enabled at boot (0 on 1 off)
- *       bit 5-0: backlight brightness control steps (0..63)
- * 0x77: bit 7: contrast control, same bit pattern as 0x76 except bit 6 resvd
- * 0x78 - 0x7c: reserved
- * 0x7d: bit 7-4: EPI descriptor major version (1)
- *       bit 3-0: EPI descriptor minor version (0)
- *
- * ----
- *
- * SPWG: http://www.spwg.org/spwg_spec_version3.8_3-14-2007.pdf
- *
- * Since these are "dummy" blocks, terminate with 0a 20 20 20 ... as usual
- *
- * detailed descriptor 3:
- * 0x5a - 0x5e: 00 00 00 fe 00
- * 0x5f - 0x63: PC maker part number
- * 0x64: LCD supplier revision #
- * 0x65 - 0x6b: manufacturer part number
- *
- * detailed descriptor 4:
- * 0x6c - 0x70: 00 00 00 fe 00
- * 0x71 - 0x78: smbus nits values (whut)
- * 0x79: number of lvds channels (1 or 2)
- * 0x7A: panel self test (1 if present)
- * and then dummy terminator
- *
- * SPWG also says something strange about the LSB of detailed descriptor 1:
- * "LSB is set to "1" if panel is DE-timing only. H/V can be ignored."
- */
@@ -0,0 +1,6682 @@
+/*
+ * Copyright 2006-2012 Red Hat, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * on the rights to use, copy, modify, merge, publish, distribute, sub
+ * license, and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/* Author: Adam Jackson <ajax@nwnk.net> */
+/* Maintainer: Hans Verkuil <hverkuil-cisco@xs4all.nl> */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "libedid-decode.h"
+
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(*(x)))
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+enum {
+	EDID_PAGE_SIZE = 128u
+};
+
+/* Memory for the lifetime of a decode, all freed by edid_state_free() */
+struct arena_chunk {
+	struct arena_chunk *next;
+	size_t used, size;
+	char data[];
+};
+
+/* A finding; deferred ones are warnings printed at the end of the decode */
+struct diag {
+	struct diag *next;
+	uint16_t code;
+	uint8_t severity;
+	uint8_t deferred;
+	const char *block;
+	int offset;
+	int value;
+	char message[];
+};
+
+/*
+ * All state of a single EDID decode. Nothing in the decoder may live at
+ * file scope: a caller can run any number of decodes concurrently as long
+ * as each one uses its own edid_state.
+ */
+struct edid_state {
+	unsigned flags;
+	struct edid_info *info;
+
+	const unsigned char *edid;
+	unsigned num_blocks;
+
+	int edid_minor;
+	int claims_one_point_oh;
+	int claims_one_point_two;
+	int claims_one_point_three;
+	int claims_one_point_four;
+	int nonconformant_digital_display;
+	int nonconformant_extension;
+	int did_detailed_timing;
+	int has_name_descriptor;
+	int has_serial_string;
+	int has_ascii_string;
+	int has_range_descriptor;
+	int has_preferred_timing;
+	int has_valid_checksum;
+	int has_valid_cta_checksum;
+	int has_valid_displayid_checksum;
+	int has_valid_cvt;
+	int has_valid_dummy_block;
+	int has_valid_serial_number;
+	int has_valid_serial_string;
+	int has_valid_ascii_string;
+	int has_valid_name_descriptor;
+	int has_valid_week;
+	int has_valid_year;
+	int has_valid_detailed_blocks;
+	int has_valid_descriptor_ordering;
+	int has_valid_descriptor_pad;
+	int has_valid_range_descriptor;
+	int has_valid_max_dotclock;
+	int has_valid_string_termination;
+	int empty_string;
+	int trailing_space;
+	int has_cta861;
+	int has_640x480p60_est_timing;
+	int has_cta861_vic_1;
+	int manufacturer_name_well_formed;
+	int seen_non_detailed_descriptor;
+
+	int warning_excessive_dotclock_correction;
+	int warning_zero_preferred_refresh;
+	int nonconformant_hf_vsdb_position;
+	int duplicate_scdb;
+	int nonconformant_srgb_chromaticity;
+	int nonconformant_cta861_640x480;
+	int nonconformant_hdmi_vsdb_tmds_rate;
+	int nonconformant_hf_vsdb_tmds_rate;
+	int nonconformant_hf_eeodb;
+
+	/* where the issue of each check rule was first found, or -1 */
+	int check_offset[EDID_FINDING_LAST + 1];
+	int cta_checksum_offset;
+	int displayid_checksum_offset;
+
+	unsigned supported_hdmi_vic_codes;
+	unsigned supported_hdmi_vic_vsb_codes;
+
+	/* YCbCr 4:2:0 Capability Map, applied to the SVDs once all are known */
+	const unsigned char *y420cmdb;
+	unsigned y420cmdb_len;
+	int has_y420cmdb;
+
+	/* info->modes hashed on the timing: index in modes + 1, or 0 */
+	uint16_t mode_hash[2 * EDID_INFO_MAX_MODES];
+
+	/* CTA-861 data block ordering */
+	int last_block_was_hdmi_vsdb;
+	int have_hf_vsdb, have_hf_scdb;
+	int first_block;
+
+	int conformant;
+	unsigned warnings;
+	const char *cur_block;
+	/* the conformance rules to check, all if check_codes is NULL */
+	const uint16_t *check_codes;
+	unsigned num_check_codes;
+	/* all findings in the order they were found, allocated from arena */
+	struct diag *diags, **diags_tail;
+	struct arena_chunk *arena;
+
+	/* scratch buffers for returned strings */
+	char manufacturer[4];
+	char string[EDID_PAGE_SIZE];
+};
+
+static void edid_state_init(struct edid_state *state, struct edid_info *info,
+			    unsigned flags)
+{
+	unsigned i;
+
+	memset(state, 0, sizeof(*state));
+	memset(info, 0, sizeof(*info));
+	info->conformant = -1;
+	state->flags = flags;
+	state->info = info;
+	state->has_valid_checksum = 1;
+	state->has_valid_cta_checksum = 1;
+	state->has_valid_displayid_checksum = 1;
+	state->has_valid_cvt = 1;
+	state->has_valid_dummy_block = 1;
+	state->has_valid_descriptor_ordering = 1;
+	state->has_valid_descriptor_pad = 1;
+	state->has_valid_range_descriptor = 1;
+	state->has_valid_max_dotclock = 1;
+	state->has_valid_string_termination = 1;
+	info->min_hfreq_hz = 0xfffffff;
+	info->min_vfreq_hz = 0xfffffff;
+	state->first_block = 1;
+	state->conformant = 1;
+	state->diags_tail = &state->diags;
+	for (i = 0; i < ARRAY_SIZE(state->check_offset); i++)
+		state->check_offset[i] = -1;
+	state->cta_checksum_offset = -1;
+	state->displayid_checksum_offset = -1;
+}
+
+static void edid_state_free(struct edid_state *state)
+{
+	while (state->arena) {
+		struct arena_chunk *c = state->arena;
+
+		state->arena = c->next;
+		free(c);
+	}
+	state->diags = NULL;
+	state->diags_tail = &state->diags;
+}
+
+/*
+ * The text report is appended to a buffer that grows as needed and is
+ * written out in one go, rather than going through stdio for every field.
+ * out_printf() implements the subset of printf the text emitter uses;
+ * unlike printf, its %f does not depend on the locale.
+ */
+struct text_out {
+	const struct edid_info *info;
+	/* the EDID minor version, 0 if the major version is not 1 */
+	int minor;
+	char *buf;
+	size_t len, size;
+};
+
+static char *out_reserve(struct text_out *out, size_t n)
+{
+	if (out->len + n > out->size) {
+		size_t size = out->size ? out->size : 16384;
+		char *p;
+
+		while (size < out->len + n)
+			size *= 2;
+		p = realloc(out->buf, size);
+		if (!p)
+			return NULL;
+		out->buf = p;
+		out->size = size;
+	}
+	return out->buf + out->len;
+}
+
+static void out_write(struct text_out *out, const char *s, size_t n)
+{
+	char *p = out_reserve(out, n);
+
+	if (p) {
+		memcpy(p, s, n);
+		out->len += n;
+	}
+}
+
+static void out_pad(struct text_out *out, char c, int n)
+{
+	char *p;
+
+	if (n <= 0 || !(p = out_reserve(out, n)))
+		return;
+	memset(p, c, n);
+	out->len += n;
+}
+
+struct out_spec {
+	int left, zero, space, plus;
+	int width, prec;
+};
+
+/* write sign and digits as a field of spec->width */
+static void out_field(struct text_out *out, const struct out_spec *spec,
+		      char sign, const char *digits, int len)
+{
+	int pad = spec->width - len - !!sign;
+
+	if (!spec->left && !spec->zero)
+		out_pad(out, ' ', pad);
+	if (sign)
+		out_write(out, &sign, 1);
+	if (!spec->left && spec->zero)
+		out_pad(out, '0', pad);
+	out_write(out, digits, len);
+	if (spec->left)
+		out_pad(out, ' ', pad);
+}
+
+static int fmt_uint(char *end, unsigned long long v, unsigned base, int upper)
+{
+	const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	char *p = end;
+
+	do {
+		*--p = digits[v % base];
+		v /= base;
+	} while (v);
+	return end - p;
+}
+
+static void out_int(struct text_out *out, const struct out_spec *spec,
+		    long long v, int is_signed, unsigned base, int upper)
+{
+	char buf[32];
+	char sign = 0;
+	unsigned long long u = v;
+	int len;
+
+	if (is_signed) {
+		if (v < 0) {
+			sign = '-';
+			u = -(unsigned long long)v;
+		} else if (spec->plus) {
+			sign = '+';
+		} else if (spec->space) {
+			sign = ' ';
+		}
+	}
+	len = fmt_uint(buf + sizeof(buf), u, base, upper);
+	while (len < spec->prec && len < (int)sizeof(buf))
+		buf[sizeof(buf) - ++len] = '0';
+	out_field(out, spec, sign, buf + sizeof(buf) - len, len);
+}
+
+static void out_fixed(struct text_out *out, const struct out_spec *spec,
+		      double v)
+{
+	static const double pow10[] = {
+		1, 10, 100, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+	};
+	int prec = spec->prec < 0 ? 6 : spec->prec;
+	char sign = signbit(v) ? '-' : spec->plus ? '+' : spec->space ? ' ' : 0;
+	char buf[64];
+	double x, ip, frac;
+	int len, i;
+
+	x = fabs(v) * (prec < (int)ARRAY_SIZE(pow10) ? pow10[prec] : 0);
+	ip = floor(x);
+	frac = x - ip;
+	if (prec >= (int)ARRAY_SIZE(pow10) || !isfinite(x) || x >= 1e17 ||
+	    fabs(frac - 0.5) < 1e-6) {
+		/* rare or ambiguous rounding: let printf decide */
+		char tmp[400];
+		const char *p = tmp;
+
+		snprintf(tmp, sizeof(tmp), "%.*f", prec, fabs(v));
+		for (len = 0; *p && len < (int)sizeof(buf) - 1; ) {
+			if (isdigit(*p) || !isfinite(x)) {
+				buf[len++] = *p++;
+				continue;
+			}
+			/* the decimal point of the current locale */
+			buf[len++] = '.';
+			while (*p && !isdigit(*p))
+				p++;
+		}
+		out_field(out, spec, sign, buf, len);
+		return;
+	}
+	if (frac > 0.5)
+		ip++;
+
+	len = fmt_uint(buf + sizeof(buf), (unsigned long long)ip, 10, 0);
+	while (len < prec + 1)
+		buf[sizeof(buf) - ++len] = '0';
+	if (prec) {
+		/* make room for the decimal point */
+		char *p = buf + sizeof(buf) - len;
+
+		for (i = 0; i < len - prec; i++)
+			p[i - 1] = p[i];
+		p[len - prec - 1] = '.';
+		len++;
+	}
+	out_field(out, spec, sign, buf + sizeof(buf) - len, len);
+}
+
+static void out_vprintf(struct text_out *out, const char *fmt, va_list ap)
+{
+	while (*fmt) {
+		struct out_spec spec = { .prec = -1 };
+		const char *p = strchr(fmt, '%');
+		int lng = 0;
+
+		if (!p) {
+			out_write(out, fmt, strlen(fmt));
+			return;
+		}
+		out_write(out, fmt, p - fmt);
+		fmt = p + 1;
+
+		for (;; fmt++) {
+			if (*fmt == '-')
+				spec.left = 1;
+			else if (*fmt == '0')
+				spec.zero = 1;
+			else if (*fmt == ' ')
+				spec.space = 1;
+			else if (*fmt == '+')
+				spec.plus = 1;
+			else if (*fmt != '#')
+				break;
+		}
+		if (*fmt == '*') {
+			spec.width = va_arg(ap, int);
+			fmt++;
+		}
+		while (isdigit(*fmt))
+			spec.width = spec.width * 10 + *fmt++ - '0';
+		if (spec.width < 0) {
+			spec.left = 1;
+			spec.width = -spec.width;
+		}
+		if (*fmt == '.') {
+			spec.prec = 0;
+			if (*++fmt == '*') {
+				spec.prec = va_arg(ap, int);
+				fmt++;
+			}
+			while (isdigit(*fmt))
+				spec.prec = spec.prec * 10 + *fmt++ - '0';
+		}
+		/* -1 for h, -2 for hh, 1 for l, 2 and up for ll and z */
+		for (; *fmt == 'h' || *fmt == 'l' || *fmt == 'z'; fmt++)
+			lng += *fmt == 'h' ? -1 : *fmt == 'l' ? 1 : 2;
+		if (spec.left || spec.prec >= 0)
+			spec.zero = 0;
+
+		switch (*fmt) {
+		case 'd':
+		case 'i': {
+			long long v = lng >= 2 ? va_arg(ap, long long) :
+				      lng > 0 ? va_arg(ap, long) : va_arg(ap, int);
+
+			if (lng == -1)
+				v = (short)v;
+			else if (lng < -1)
+				v = (signed char)v;
+			out_int(out, &spec, v, 1, 10, 0);
+			break;
+		}
+		case 'u':
+		case 'x':
+		case 'X': {
+			unsigned long long v = lng >= 2 ? va_arg(ap, unsigned long long) :
+					       lng > 0 ? va_arg(ap, unsigned long) :
+					       va_arg(ap, unsigned);
+
+			if (lng == -1)
+				v = (unsigned short)v;
+			else if (lng < -1)
+				v = (unsigned char)v;
+			out_int(out, &spec, v, 0, *fmt == 'u' ? 10 : 16, *fmt == 'X');
+			break;
+		}
+		case 'f':
+			spec.zero = spec.zero && !spec.left;
+			out_fixed(out, &spec, va_arg(ap, double));
+			break;
+		case 'c': {
+			char c = va_arg(ap, int);
+
+			spec.zero = 0;
+			out_field(out, &spec, 0, &c, 1);
+			break;
+		}
+		case 's': {
+			const char *str = va_arg(ap, const char *);
+			int len;
+
+			if (!str)
+				str = "(null)";
+			len = spec.prec < 0 ? strlen(str) : (int)strnlen(str, spec.prec);
+			spec.zero = 0;
+			out_field(out, &spec, 0, str, len);
+			break;
+		}
+		case '%':
+			out_write(out, "%", 1);
+			break;
+		default:
+			/* not used by the text emitter */
+			out_write(out, fmt - 1, *fmt ? 2 : 1);
+			if (!*fmt)
+				return;
+			break;
+		}
+		fmt++;
+	}
+}
+
+static void out_printf(struct text_out *out, const char *fmt, ...)
+	__attribute__((format(printf, 2, 3)));
+
+static void out_printf(struct text_out *out, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	out_vprintf(out, fmt, ap);
+	va_end(ap);
+}
+
+/* offset of x in the EDID being decoded */
+static unsigned edid_offset(struct edid_state *state, const unsigned char *x)
+{
+	return x - state->edid;
+}
+
+/* Remember x as the location of the issue of the check rule with code */
+static void check_at(struct edid_state *state, enum edid_finding_code code,
+		     const unsigned char *x)
+{
+	if (state->check_offset[code] < 0)
+		state->check_offset[code] = edid_offset(state, x);
+}
+
+static struct edid_timing *info_add_timing(struct edid_state *state, const unsigned char *x,
+					   enum edid_timing_source source)
+{
+	struct edid_info *info = state->info;
+	struct edid_timing *t;
+
+	if (info->num_timings == EDID_INFO_MAX_TIMINGS) {
+		info->truncated |= EDID_INFO_TRUNC_TIMINGS;
+		return NULL;
+	}
+	t = &info->timings[info->num_timings++];
+	t->source = source;
+	t->offset = edid_offset(state, x);
+	t->block = t->offset / EDID_PAGE_SIZE;
+	return t;
+}
+
+/* the fields that make two timings the same mode */
+static int same_timing(const struct edid_timing *a, const struct edid_timing *b)
+{
+	const unsigned mask = EDID_TIMING_INTERLACED | EDID_TIMING_PHSYNC |
+			      EDID_TIMING_PVSYNC;
+
+	return a->pixclk_khz == b->pixclk_khz &&
+	       a->hact == b->hact && a->hfp == b->hfp &&
+	       a->hsync == b->hsync && a->hbp == b->hbp &&
+	       a->vact == b->vact && a->vfp == b->vfp &&
+	       a->vsync == b->vsync && a->vbp == b->vbp &&
+	       a->hborder == b->hborder && a->vborder == b->vborder &&
+	       (a->flags & mask) == (b->flags & mask);
+}
+
+static unsigned mode_key(const struct edid_timing *t)
+{
+	uint32_t h = t->pixclk_khz * 0x9e3779b1u;
+
+	h ^= ((uint32_t)t->hact << 16 | t->vact) * 0x85ebca6bu;
+	h ^= ((uint32_t)(t->hfp + t->hsync + t->hbp) << 16 |
+	      (t->vfp + t->vsync + t->vbp)) * 0xc2b2ae35u;
+	return (h ^ h >> 16) & (2 * EDID_INFO_MAX_MODES - 1);
+}
+
+static struct edid_mode *find_mode(struct edid_state *state, const struct edid_timing *t)
+{
+	unsigned h = mode_key(t);
+
+	for (; state->mode_hash[h]; h = (h + 1) & (ARRAY_SIZE(state->mode_hash) - 1)) {
+		struct edid_mode *m = &state->info->modes[state->mode_hash[h] - 1];
+
+		if (same_timing(&m->timing, t))
+			return m;
+	}
+	return NULL;
+}
+
+/*
+ * Add the mode with timing t found in source to the mode set, or merge
+ * it with the mode that has the same timing
+ */
+static struct edid_mode *info_add_mode(struct edid_state *state, const struct edid_timing *t,
+				       unsigned source, unsigned flags)
+{
+	struct edid_info *info = state->info;
+	struct edid_mode *m;
+	unsigned h, htotal, vtotal;
+
+	htotal = t->hact + t->hfp + t->hsync + t->hbp;
+	vtotal = t->vact + t->vfp + t->vsync + t->vbp;
+	if (!t->pixclk_khz || !htotal || !vtotal)
+		return NULL;
+	if (flags & EDID_MODE_YCBCR420_ONLY)
+		flags |= EDID_MODE_YCBCR420;
+
+	m = find_mode(state, t);
+	if (m) {
+		/* 4:2:0 only if every source says so */
+		if (!(flags & EDID_MODE_YCBCR420_ONLY))
+			m->flags &= ~EDID_MODE_YCBCR420_ONLY;
+		m->flags |= flags & ~EDID_MODE_YCBCR420_ONLY;
+		m->sources |= source;
+		return m;
+	}
+	if (info->num_modes == EDID_INFO_MAX_MODES) {
+		info->truncated |= EDID_INFO_TRUNC_MODES;
+		return NULL;
+	}
+	for (h = mode_key(t); state->mode_hash[h];
+	     h = (h + 1) & (ARRAY_SIZE(state->mode_hash) - 1))
+		;
+	state->mode_hash[h] = info->num_modes + 1;
+	m = &info->modes[info->num_modes++];
+	m->timing = *t;
+	m->timing.flags &= ~EDID_TIMING_PREFERRED;
+	/*
+	 * interlaced timings hold the lines of one field, plus half a line,
+	 * except for DisplayID which gives the lines of the frame
+	 */
+	if ((t->flags & EDID_TIMING_INTERLACED) && t->source == EDID_SRC_DISPLAYID)
+		m->refresh_mhz = t->pixclk_khz * 2000000ULL / (htotal * vtotal);
+	else if (t->flags & EDID_TIMING_INTERLACED)
+		m->refresh_mhz = t->pixclk_khz * 2000000ULL / (htotal * (2 * vtotal + 1));
+	else
+		m->refresh_mhz = t->pixclk_khz * 1000000ULL / (htotal * vtotal);
+	m->sources = source;
+	m->flags = flags;
+	return m;
+}
+
+static int mode_cmp(const void *a, const void *b)
+{
+	const struct edid_mode *ma = a, *mb = b;
+	const struct edid_timing *ta = &ma->timing, *tb = &mb->timing;
+
+	if (ta->pixclk_khz != tb->pixclk_khz)
+		return ta->pixclk_khz < tb->pixclk_khz ? -1 : 1;
+	if (ta->hact != tb->hact)
+		return ta->hact < tb->hact ? -1 : 1;
+	if (ta->vact != tb->vact)
+		return ta->vact < tb->vact ? -1 : 1;
+	if (ma->refresh_mhz != mb->refresh_mhz)
+		return ma->refresh_mhz < mb->refresh_mhz ? -1 : 1;
+	/* keep the order of modes that differ in porches only stable */
+	return ta->block != tb->block ? ta->block - tb->block :
+	       ta->offset - tb->offset;
+}
+
+/* Sort the mode set by pixel clock once all modes are known */
+static void info_sort_modes(struct edid_state *state)
+{
+	struct edid_info *info = state->info;
+
+	qsort(info->modes, info->num_modes, sizeof(info->modes[0]), mode_cmp);
+	/* the indices in mode_hash are stale now */
+	memset(state->mode_hash, 0, sizeof(state->mode_hash));
+}
+
+static void info_add_std_timing(struct edid_state *state, unsigned x, unsigned y,
+				unsigned refresh, unsigned ratio_w, unsigned ratio_h)
+{
+	struct edid_info *info = state->info;
+	struct edid_std_timing *t;
+
+	if (info->num_std_timings == EDID_INFO_MAX_STD_TIMINGS) {
+		info->truncated |= EDID_INFO_TRUNC_STD_TIMINGS;
+		return;
+	}
+	t = &info->std_timings[info->num_std_timings++];
+	t->hact = x;
+	t->vact = y;
+	t->refresh = refresh;
+	t->ratio_w = ratio_w;
+	t->ratio_h = ratio_h;
+}
+
+static void info_add_svd(struct edid_state *state, unsigned char vic, unsigned char flags)
+{
+	struct edid_cta_caps *cta = &state->info->cta;
+
+	if (cta->num_svds == EDID_INFO_MAX_SVDS) {
+		state->info->truncated |= EDID_INFO_TRUNC_SVDS;
+		return;
+	}
+	cta->svds[cta->num_svds].vic = vic;
+	cta->svds[cta->num_svds].flags = flags;
+	cta->num_svds++;
+}
+
+static void info_add_sad(struct edid_state *state, const unsigned char *x)
+{
+	struct edid_cta_caps *cta = &state->info->cta;
+	struct edid_sad *sad;
+
+	if (cta->num_sads == EDID_INFO_MAX_SADS) {
+		state->info->truncated |= EDID_INFO_TRUNC_SADS;
+		return;
+	}
+	sad = &cta->sads[cta->num_sads++];
+	sad->format = (x[0] & 0x78) >> 3;
+	sad->channels = (x[0] & 0x07) + 1;
+	if (sad->format == 15) {
+		sad->ext_format = (x[2] & 0xf8) >> 3;
+		if (sad->ext_format == 11)
+			sad->channels = 0;
+		else if (sad->ext_format == 13)
+			sad->channels = (((x[1] & 0x80) >> 3) | ((x[0] & 0x80) >> 4) |
+					 (x[0] & 0x07)) + 1;
+	}
+	sad->rates = x[1];
+	sad->byte3 = x[2];
+}
+
+/* mark the SVDs listed in the YCbCr 4:2:0 Capability Map */
+static void info_apply_y420cmdb(struct edid_state *state)
+{
+	struct edid_cta_caps *cta = &state->info->cta;
+	unsigned i, idx = 0;
+
+	if (!state->has_y420cmdb)
+		return;
+	for (i = 0; i < cta->num_svds; i++) {
+		struct edid_svd *svd = &cta->svds[i];
+
+		if (svd->flags & EDID_SVD_YCBCR420_ONLY)
+			continue;
+		/* an empty map means all SVDs support 4:2:0 */
+		if (!state->y420cmdb_len ||
+		    (idx / 8 < state->y420cmdb_len &&
+		     (state->y420cmdb[idx / 8] & (1 << (idx % 8))))) {
+			const struct edid_vic_mode *vicmode = edid_vic_mode(svd->vic);
+			struct edid_mode *m = vicmode ? find_mode(state, &vicmode->timing) : NULL;
+
+			svd->flags |= EDID_SVD_YCBCR420;
+			if (m)
+				m->flags |= EDID_MODE_YCBCR420;
+		}
+		idx++;
+	}
+}
+
+/* Fill b from the header of the CTA-861 data block at buf[offset] */
+static void cta_index_block(struct edid_cta_block *b, const unsigned char *buf,
+			    unsigned offset)
+{
+	const unsigned char *x = buf + offset;
+	unsigned tag = x[0] >> 5;
+
+	b->offset = offset + 1;
+	b->block = b->offset / EDID_PAGE_SIZE;
+	b->tag = tag;
+	b->ext_tag = 0;
+	b->oui = 0;
+	b->length = x[0] & 0x1f;
+	if (tag == 0x03 && b->length >= 3)
+		b->oui = (x[3] << 16) + (x[2] << 8) + x[1];
+	if (tag == 0x07 && b->length >= 1) {
+		b->ext_tag = x[1];
+		/* Vendor-Specific Video and Audio Data Blocks */
+		if ((x[1] == 0x01 || x[1] == 0x11) && b->length >= 4)
+			b->oui = (x[4] << 16) + (x[3] << 8) + x[2];
+	}
+}
+
+static void info_add_cta_block(struct edid_state *state, const unsigned char *x)
+{
+	struct edid_info *info = state->info;
+
+	if (info->num_cta_blocks == EDID_INFO_MAX_CTA_BLOCKS) {
+		info->truncated |= EDID_INFO_TRUNC_CTA_BLOCKS;
+		return;
+	}
+	cta_index_block(&info->cta_blocks[info->num_cta_blocks++], state->edid,
+			edid_offset(state, x));
+}
+
+static void info_add_displayid_block(struct edid_state *state, const unsigned char *x)
+{
+	struct edid_info *info = state->info;
+	struct edid_displayid_block *b;
+
+	if (info->num_displayid_blocks == EDID_INFO_MAX_DISPLAYID_BLOCKS) {
+		info->truncated |= EDID_INFO_TRUNC_DISPLAYID_BLOCKS;
+		return;
+	}
+	b = &info->displayid_blocks[info->num_displayid_blocks++];
+	b->offset = edid_offset(state, x + 3);
+	b->block = b->offset / EDID_PAGE_SIZE;
+	b->tag = x[0];
+	b->revision = x[1];
+	b->length = x[2];
+}
+
+/* Allocate n bytes, 8 byte aligned, that live until the end of the decode */
+static void *arena_alloc(struct edid_state *state, size_t n)
+{
+	struct arena_chunk *c = state->arena;
+
+	n = (n + 7) & ~(size_t)7;
+	if (!c || c->size - c->used < n) {
+		size_t size = max(n, 4096 - sizeof(*c));
+
+		c = malloc(sizeof(*c) + size);
+		if (!c)
+			return NULL;
+		c->next = state->arena;
+		c->used = 0;
+		c->size = size;
+		state->arena = c;
+	}
+	c->used += n;
+	return c->data + c->used - n;
+}
+
+/* Add a finding; the message is kept as is, newlines and all */
+static struct diag *add_diag(struct edid_state *state, enum edid_finding_code code,
+			     enum edid_severity severity, const unsigned char *x,
+			     const char *msg)
+{
+	size_t len = strlen(msg);
+	struct diag *d = arena_alloc(state, sizeof(*d) + len + 1);
+
+	if (severity == EDID_SEV_WARNING)
+		state->info->num_warnings++;
+	else
+		state->info->num_errors++;
+	if (!d)
+		return NULL;
+	d->next = NULL;
+	d->code = code;
+	d->severity = severity;
+	d->deferred = 0;
+	d->block = state->cur_block;
+	d->offset = x ? edid_offset(state, x) : -1;
+	d->value = 0;
+	memcpy(d->message, msg, len + 1);
+	*state->diags_tail = d;
+	state->diags_tail = &d->next;
+	return d;
+}
+
+/*
+ * Copy the findings into info. Messages are stored there as a single line:
+ * the trailing newline and the tab indentation of continuation lines are
+ * dropped.
+ */
+static void info_add_findings(struct edid_state *state)
+{
+	struct edid_info *info = state->info;
+	const struct diag *d;
+
+	for (d = state->diags; d; d = d->next) {
+		struct edid_finding *f;
+		const char *msg = d->message;
+		unsigned i = 0;
+
+		if (info->num_findings == EDID_INFO_MAX_FINDINGS) {
+			info->truncated |= EDID_INFO_TRUNC_FINDINGS;
+			return;
+		}
+		f = &info->findings[info->num_findings++];
+		f->code = d->code;
+		f->severity = d->severity;
+		f->block = d->block;
+		f->offset = d->offset;
+		f->value = d->value;
+		for (; *msg && i < sizeof(f->message) - 1; msg++) {
+			if (*msg == '\n') {
+				while (msg[1] == '\t')
+					msg++;
+				if (msg[1])
+					f->message[i++] = ' ';
+			} else {
+				f->message[i++] = *msg;
+			}
+		}
+		f->message[i] = '\0';
+	}
+}
+
+static void info_copy_string(char *dst, const char *s)
+{
+	memcpy(dst, s, 13);
+	dst[13] = '\0';
+}
+
+/*
+ * Record a warning about the byte at x, which may be NULL. Warnings are
+ * printed together at the end of the decode.
+ */
+static void warn(struct edid_state *state, enum edid_finding_code code,
+		 const unsigned char *x, const char *fmt, ...)
+	__attribute__((format(printf, 4, 5)));
+
+static void warn(struct edid_state *state, enum edid_finding_code code,
+		 const unsigned char *x, const char *fmt, ...)
+{
+	struct diag *d;
+	char buf[256];
+	va_list ap;
+
+	buf[0] = '\0';
+	if (!(state->flags & EDID_DECODE_QUIET)) {
+		va_start(ap, fmt);
+		vsnprintf(buf, sizeof(buf), fmt, ap);
+		va_end(ap);
+	}
+	state->warnings++;
+	d = add_diag(state, code, EDID_SEV_WARNING, x, buf);
+	if (d)
+		d->deferred = 1;
+}
+
+/*
+ * Record a conformance issue as a finding of the current block, at the
+ * given offset in the EDID or -1. The message is fmt given value.
+ */
+static void check_issue(struct edid_state *state, enum edid_finding_code code,
+			enum edid_severity severity, int offset,
+			const char *fmt, int value)
+{
+	struct diag *d;
+	char buf[256];
+
+	buf[0] = '\0';
+	if (!(state->flags & EDID_DECODE_QUIET))
+		snprintf(buf, sizeof(buf), fmt, value);
+	d = add_diag(state, code, severity,
+		     offset < 0 ? NULL : state->edid + offset, buf);
+	if (d)
+		d->value = value;
+}
+
+static void decode_manufacturer(char *name, const unsigned char *x)
+{
+	name[0] = ((x[0] & 0x7C) >> 2) + '@';
+	name[1] = ((x[0] & 0x03) << 3) + ((x[1] & 0xE0) >> 5) + '@';
+	name[2] = (x[1] & 0x1F) + '@';
+	name[3] = 0;
+}
+
+static char *manufacturer_name(struct edid_state *state, const unsigned char *x)
+{
+	char *name = state->manufacturer;
+
+	decode_manufacturer(name, x);
+
+	if (isupper(name[0]) && isupper(name[1]) && isupper(name[2]))
+		state->manufacturer_name_well_formed = 1;
+
+	return name;
+}
+
+/*
+ * CVT 1.2 and GTF timing generator. The formulas follow the spreadsheets
+ * of the VESA standards with their default parameters, for progressive
+ * modes without margins.
+ */
+
+/* CVT 1.2 */
+#define CVT_MIN_VSYNC_BP	550.0	/* min vsync + back porch (us) */
+#define CVT_MIN_V_PORCH		3	/* min vertical front porch (lines) */
+#define CVT_MIN_V_BPORCH	6	/* min vertical back porch (lines) */
+#define CVT_H_GRANULARITY	8	/* character cell (pixels) */
+#define CVT_HSYNC_PERCENTAGE	8	/* hsync width (% of line period) */
+#define CVT_CLOCK_STEP		250	/* pixel clock step (kHz) */
+#define CVT_RB_MIN_VBLANK	460.0	/* min vertical blanking (us) */
+#define CVT_RB_H_BLANK		160
+#define CVT_RB_H_SYNC		32
+#define CVT_RB_V_FPORCH		3
+#define CVT_RB2_H_BLANK		80
+#define CVT_RB2_H_SYNC		32
+#define CVT_RB2_H_FPORCH	8
+#define CVT_RB2_V_SYNC		8
+#define CVT_RB2_MIN_V_FPORCH	1
+
+/* Blanking formula: gradient M (%/kHz), offset C (%), K and J */
+#define GTF_M			600
+#define GTF_C			40
+#define GTF_K			128
+#define GTF_J			20
+#define GTF_M_PRIME		(GTF_M * GTF_K / 256.0)
+#define GTF_C_PRIME		((GTF_C - GTF_J) * GTF_K / 256.0 + GTF_J)
+
+/* GTF */
+#define GTF_MIN_VSYNC_BP	550.0
+#define GTF_MIN_PORCH		1
+#define GTF_V_SYNC		3
+
+/* CVT vsync width, which encodes the aspect ratio */
+static unsigned cvt_vsync(unsigned w, unsigned h)
+{
+	if (w * 3 == h * 4)
+		return 4;
+	if (w * 9 == h * 16)
+		return 5;
+	if (w * 10 == h * 16)
+		return 6;
+	if (w * 4 == h * 5 || w * 9 == h * 15)
+		return 7;
+	return 10;
+}
+
+/* Ideal horizontal blanking of the CVT and GTF formulas, in pixels */
+static unsigned ideal_hblank(unsigned w, double hperiod_us, int round)
+{
+	double duty = GTF_C_PRIME - GTF_M_PRIME * hperiod_us / 1000.0;
+	double cells;
+
+	if (duty < 20)
+		duty = 20;
+	cells = w * duty / (100.0 - duty) / (2 * CVT_H_GRANULARITY);
+	return (round ? floor(cells + 0.5) : floor(cells)) * 2 * CVT_H_GRANULARITY;
+}
+
+static void calc_cvt(unsigned w, unsigned h, unsigned refresh, struct edid_timing *t)
+{
+	unsigned vsync = cvt_vsync(w, h);
+	double hperiod = (1000000.0 / refresh - CVT_MIN_VSYNC_BP) /
+			 (h + CVT_MIN_V_PORCH);
+	unsigned vsync_bp = floor(CVT_MIN_VSYNC_BP / hperiod) + 1;
+	unsigned htotal, hblank;
+
+	w -= w % CVT_H_GRANULARITY;
+	if (vsync_bp < vsync + CVT_MIN_V_BPORCH)
+		vsync_bp = vsync + CVT_MIN_V_BPORCH;
+	hblank = ideal_hblank(w, hperiod, 0);
+	htotal = w + hblank;
+	t->pixclk_khz = htotal * 1000.0 / hperiod;
+	t->pixclk_khz -= t->pixclk_khz % CVT_CLOCK_STEP;
+	t->hact = w;
+	t->hsync = floor(CVT_HSYNC_PERCENTAGE / 100.0 * htotal / CVT_H_GRANULARITY) *
+		   CVT_H_GRANULARITY;
+	t->hbp = hblank / 2;
+	t->hfp = hblank - t->hsync - t->hbp;
+	t->vact = h;
+	t->vfp = CVT_MIN_V_PORCH;
+	t->vsync = vsync;
+	t->vbp = vsync_bp - vsync;
+	t->flags = EDID_TIMING_PVSYNC;
+}
+
+static void calc_cvt_rb(unsigned w, unsigned h, unsigned refresh, int v2,
+			struct edid_timing *t)
+{
+	unsigned vsync = v2 ? CVT_RB2_V_SYNC : cvt_vsync(w, h);
+	unsigned vfp = v2 ? CVT_RB2_MIN_V_FPORCH : CVT_RB_V_FPORCH;
+	unsigned hblank = v2 ? CVT_RB2_H_BLANK : CVT_RB_H_BLANK;
+	double hperiod = (1000000.0 / refresh - CVT_RB_MIN_VBLANK) / h;
+	unsigned vbi = floor(CVT_RB_MIN_VBLANK / hperiod) + 1;
+	double clock;
+
+	if (!v2)
+		w -= w % CVT_H_GRANULARITY;
+	if (vbi < vfp + vsync + CVT_MIN_V_BPORCH)
+		vbi = vfp + vsync + CVT_MIN_V_BPORCH;
+	/* v2 has a fixed back porch and extends the front porch instead */
+	clock = (double)refresh * (h + vbi) * (w + hblank) / 1000.0;
+	t->pixclk_khz = v2 ? floor(clock) :
+		floor(clock / CVT_CLOCK_STEP) * CVT_CLOCK_STEP;
+	t->hact = w;
+	t->hsync = v2 ? CVT_RB2_H_SYNC : CVT_RB_H_SYNC;
+	t->hfp = v2 ? CVT_RB2_H_FPORCH : hblank / 2 - t->hsync;
+	t->hbp = hblank - t->hfp - t->hsync;
+	t->vact = h;
+	t->vsync = vsync;
+	t->vfp = v2 ? vbi - vsync - CVT_MIN_V_BPORCH : vfp;
+	t->vbp = vbi - t->vfp - vsync;
+	t->flags = EDID_TIMING_PHSYNC;
+}
+
+static void calc_gtf(unsigned w, unsigned h, unsigned refresh, struct edid_timing *t)
+{
+	double hperiod_est = (1000000.0 / refresh - GTF_MIN_VSYNC_BP) /
+			     (h + GTF_MIN_PORCH);
+	unsigned vsync_bp = floor(GTF_MIN_VSYNC_BP / hperiod_est + 0.5);
+	unsigned vtotal = h + vsync_bp + GTF_MIN_PORCH;
+	double hperiod = 1000000.0 / refresh / vtotal;
+	unsigned htotal, hblank;
+
+	w = floor(w / (double)CVT_H_GRANULARITY + 0.5) * CVT_H_GRANULARITY;
+	hblank = ideal_hblank(w, hperiod, 1);
+	htotal = w + hblank;
+	t->pixclk_khz = floor(htotal * 1000.0 / hperiod / 10 + 0.5) * 10;
+	t->hact = w;
+	t->hsync = floor(CVT_HSYNC_PERCENTAGE / 100.0 * htotal / CVT_H_GRANULARITY + 0.5) *
+		   CVT_H_GRANULARITY;
+	t->hbp = hblank / 2;
+	t->hfp = hblank - t->hsync - t->hbp;
+	t->vact = h;
+	t->vfp = GTF_MIN_PORCH;
+	t->vsync = GTF_V_SYNC;
+	t->vbp = vsync_bp - GTF_V_SYNC;
+	t->flags = EDID_TIMING_PVSYNC;
+}
+
+/*
+ * The same few modes come up in EDID after EDID, so results are kept in
+ * a small direct-mapped cache. It is per thread, so no locking needed.
+ */
+#define TIMING_CACHE_SIZE	64
+
+static __thread struct {
+	uint64_t key;		/* 0 for an empty slot */
+	struct edid_timing t;
+} timing_cache[TIMING_CACHE_SIZE];
+
+int edid_calc_timing(unsigned width, unsigned height, unsigned refresh,
+		     enum edid_formula formula, struct edid_timing *t)
+{
+	uint64_t key = ((uint64_t)width << 40) | ((uint64_t)height << 24) |
+		       (refresh << 8) | (formula + 1);
+	unsigned slot = (width * 31 + height * 7 + refresh * 3 + formula) %
+			TIMING_CACHE_SIZE;
+
+	if (!width || width > 0xffff || !height || height > 0xffff ||
+	    !refresh || refresh > 1000 || formula > EDID_FORMULA_GTF)
+		return -1;
+	if (timing_cache[slot].key == key) {
+		*t = timing_cache[slot].t;
+		return 0;
+	}
+
+	memset(t, 0, sizeof(*t));
+	switch (formula) {
+	case EDID_FORMULA_CVT:
+		calc_cvt(width, height, refresh, t);
+		break;
+	case EDID_FORMULA_CVT_RB:
+	case EDID_FORMULA_CVT_RB2:
+		calc_cvt_rb(width, height, refresh,
+			    formula == EDID_FORMULA_CVT_RB2, t);
+		break;
+	case EDID_FORMULA_GTF:
+		calc_gtf(width, height, refresh, t);
+		break;
+	}
+	t->source = formula == EDID_FORMULA_GTF ? EDID_SRC_GTF : EDID_SRC_CVT;
+	timing_cache[slot].key = key;
+	timing_cache[slot].t = *t;
+	return 0;
+}
+
+/* Horizontal frequency of a timing in Hz */
+static unsigned timing_hfreq(const struct edid_timing *t)
+{
+	return t->pixclk_khz * 1000ULL / (t->hact + t->hfp + t->hsync + t->hbp);
+}
+
+static int detailed_cvt_descriptor(struct edid_state *state, const unsigned char *x, int first)
+{
+	const unsigned char empty[3] = { 0, 0, 0 };
+	/* the refresh rates of bits 4 - 0 of byte 2; bit 0 is 60 Hz RB */
+	static const unsigned rates[] = { 50, 60, 75, 85, 60 };
+	struct edid_info *info = state->info;
+	unsigned min_hfreq = ~0;
+	unsigned max_hfreq = 0;
+	unsigned max_clock = 0;
+	unsigned i;
+	int width, height;
+	unsigned min_refresh, max_refresh;
+
+	if (!first && !memcmp(x, empty, 3))
+		return 1;
+
+	if ((x[1] & 0x03) || (x[2] & 0x80) || !(x[2] & 0x1f))
+		return 0;
+
+	height = x[0];
+	height |= (x[1] & 0xf0) << 4;
+	height++;
+	height *= 2;
+
+	switch (x[1] & 0x0c) {
+	case 0x00:
+		width = 8 * (((height * 4) / 3) / 8);
+		break;
+	case 0x04:
+		width = 8 * (((height * 16) / 9) / 8);
+		break;
+	case 0x08:
+		width = 8 * (((height * 16) / 10) / 8);
+		break;
+	case 0x0c:
+		width = 8 * (((height * 15) / 9) / 8);
+		break;
+	}
+
+	/* 60 Hz reduced blanking alone gives no refresh rate */
+	min_refresh = (x[2] & 0x10) ? 50 : (x[2] & 0x08) ? 60 :
+		      (x[2] & 0x04) ? 75 : (x[2] & 0x02) ? 85 : 0xfffffff;
+	max_refresh = (x[2] & 0x02) ? 85 : (x[2] & 0x04) ? 75 :
+		      (x[2] & 0x08) ? 60 : (x[2] & 0x10) ? 50 : 0;
+	info->min_vfreq_hz = min(info->min_vfreq_hz, min_refresh);
+	info->max_vfreq_hz = max(info->max_vfreq_hz, max_refresh);
+
+	for (i = 0; i < ARRAY_SIZE(rates); i++) {
+		struct edid_timing t;
+		unsigned hfreq;
+
+		if (!(x[2] & (0x10 >> i)))
+			continue;
+		if (edid_calc_timing(width, height, rates[i],
+				     i == 4 ? EDID_FORMULA_CVT_RB : EDID_FORMULA_CVT, &t))
+			continue;
+		hfreq = timing_hfreq(&t);
+		t.offset = edid_offset(state, x);
+		t.block = t.offset / EDID_PAGE_SIZE;
+		info_add_mode(state, &t, EDID_MODE_SRC_CVT, 0);
+		min_hfreq = min(min_hfreq, hfreq);
+		max_hfreq = max(max_hfreq, hfreq);
+		max_clock = max(max_clock, t.pixclk_khz);
+	}
+	info->min_hfreq_hz = min(info->min_hfreq_hz, min_hfreq);
+	info->max_hfreq_hz = max(info->max_hfreq_hz, max_hfreq);
+	info->max_pixclk_khz = max(info->max_pixclk_khz, max_clock);
+	return 1;
+}
+
+/* extract a string from a detailed subblock, checking for termination */
+static char *extract_string(struct edid_state *state, const char *name, const unsigned char *x, int *valid, int len)
+{
+	char *ret = state->string;
+	int i, seen_newline = 0;
+
+	memset(ret, 0, sizeof(state->string));
+	*valid = 1;
+
+	for (i = 0; i < len; i++) {
+		if (isgraph(x[i])) {
+			ret[i] = x[i];
+		} else if (!seen_newline) {
+			if (x[i] == 0x0a) {
+				seen_newline = 1;
+				if (!i) {
+					state->empty_string = 1;
+					check_at(state, EDID_FINDING_EMPTY_STRINGS, x);
+					warn(state, EDID_FINDING_STRING_EMPTY, x + i, "%s: empty string\n", name);
+					*valid = 0;
+				} else if (ret[i - 1] == 0x20) {
+					warn(state, EDID_FINDING_STRING_TRAILING_SPACE, x + i - 1,
+					     "%s: one or more trailing spaces\n", name);
+					state->trailing_space = 1;
+					check_at(state, EDID_FINDING_TRAILING_SPACES, x + i - 1);
+					*valid = 0;
+				}
+			} else if (x[i] == 0x20) {
+				ret[i] = x[i];
+			} else {
+				state->has_valid_string_termination = 0;
+				check_at(state, EDID_FINDING_STRING_TERMINATION, x + i);
+				warn(state, EDID_FINDING_STRING_NON_PRINTABLE, x + i,
+				     "%s: non-printable character\n", name);
+				*valid = 0;
+				return ret;
+			}
+		} else if (x[i] != 0x20) {
+			state->has_valid_string_termination = 0;
+			check_at(state, EDID_FINDING_STRING_TERMINATION, x + i);
+			warn(state, EDID_FINDING_STRING_NON_SPACE_AFTER_NEWLINE, x + i,
+			     "%s: non-space after newline\n", name);
+			*valid = 0;
+			return ret;
+		}
+	}
+	/* Does the string end with a space? */
+	if (!seen_newline && ret[len - 1] == 0x20) {
+		state->trailing_space = 1;
+		check_at(state, EDID_FINDING_TRAILING_SPACES, x + len - 1);
+		warn(state, EDID_FINDING_STRING_TRAILING_SPACE, x + len - 1,
+		     "%s: one or more trailing spaces\n", name);
+		*valid = 0;
+	}
+
+	return ret;
+}
+
+#define SYNC_NN	0
+#define SYNC_NP	EDID_TIMING_PVSYNC
+#define SYNC_PN	EDID_TIMING_PHSYNC
+#define SYNC_PP	(EDID_TIMING_PHSYNC | EDID_TIMING_PVSYNC)
+
+/*
+ * The timings of the VESA Display Monitor Timing standard, indexed by
+ * DMT ID - 1, followed by the established timings that are not in DMT.
+ * rb is the reduced blanking version. Vertical porches and sync are per
+ * field for the interlaced timings.
+ */
+static const struct std_timing {
+	int x, y, refresh, ratio_w, ratio_h;
+	int hor_freq_hz, pixclk_khz, rb, interlaced;
+	unsigned short hfp, hsync, hbp, vfp, vsync, vbp;
+	unsigned char sync;
+} timing_db[] = {
+	{640, 350, 85, 64, 35, 37900, 31500, 0, 0, 32, 64, 96, 32, 3, 60, SYNC_PN}, /* 0x01 */
+	{640, 400, 85, 16, 10, 37900, 31500, 0, 0, 32, 64, 96, 1, 3, 41, SYNC_NP}, /* 0x02 */
+	{720, 400, 85, 9, 5, 37900, 35500, 0, 0, 36, 72, 108, 1, 3, 42, SYNC_NP}, /* 0x03 */
+	{640, 480, 60, 4, 3, 31469, 25175, 0, 0, 16, 96, 48, 10, 2, 33, SYNC_NN}, /* 0x04 */
+	{640, 480, 72, 4, 3, 37900, 31500, 0, 0, 24, 40, 128, 9, 3, 28, SYNC_NN}, /* 0x05 */
+	{640, 480, 75, 4, 3, 37500, 31500, 0, 0, 16, 64, 120, 1, 3, 16, SYNC_NN}, /* 0x06 */
+	{640, 480, 85, 4, 3, 43300, 36000, 0, 0, 56, 56, 80, 1, 3, 25, SYNC_NN}, /* 0x07 */
+	{800, 600, 56, 4, 3, 35200, 36000, 0, 0, 24, 72, 128, 1, 2, 22, SYNC_PP}, /* 0x08 */
+	{800, 600, 60, 4, 3, 37900, 40000, 0, 0, 40, 128, 88, 1, 4, 23, SYNC_PP}, /* 0x09 */
+	{800, 600, 72, 4, 3, 48100, 50000, 0, 0, 56, 120, 64, 37, 6, 23, SYNC_PP}, /* 0x0a */
+	{800, 600, 75, 4, 3, 46900, 49500, 0, 0, 16, 80, 160, 1, 3, 21, SYNC_PP}, /* 0x0b */
+	{800, 600, 85, 4, 3, 53700, 56250, 0, 0, 32, 64, 152, 1, 3, 27, SYNC_PP}, /* 0x0c */
+	{800, 600, 120, 4, 3, 76302, 73250, 1, 0, 48, 32, 80, 3, 4, 29, SYNC_PN}, /* 0x0d */
+	{848, 480, 60, 16, 9, 31020, 33750, 0, 0, 16, 112, 112, 6, 8, 23, SYNC_PP}, /* 0x0e */
+	{1024, 768, 43, 4, 3, 35522, 44900, 0, 1, 8, 176, 56, 0, 4, 20, SYNC_PP}, /* 0x0f */
+	{1024, 768, 60, 4, 3, 48400, 65000, 0, 0, 24, 136, 160, 3, 6, 29, SYNC_NN}, /* 0x10 */
+	{1024, 768, 70, 4, 3, 56500, 75000, 0, 0, 24, 136, 144, 3, 6, 29, SYNC_NN}, /* 0x11 */
+	{1024, 768, 75, 4, 3, 60000, 78750, 0, 0, 16, 96, 176, 1, 3, 28, SYNC_PP}, /* 0x12 */
+	{1024, 768, 85, 4, 3, 68700, 94500, 0, 0, 48, 96, 208, 1, 3, 36, SYNC_PP}, /* 0x13 */
+	{1024, 768, 120, 4, 3, 97551, 115500, 1, 0, 48, 32, 80, 3, 4, 38, SYNC_PN}, /* 0x14 */
+	{1152, 864, 75, 4, 3, 67500, 108000, 0, 0, 64, 128, 256, 1, 3, 32, SYNC_PP}, /* 0x15 */
+	{1280, 768, 60, 5, 3, 47400, 68250, 1, 0, 48, 32, 80, 3, 7, 12, SYNC_PN}, /* 0x16 */
+	{1280, 768, 60, 5, 3, 47800, 79500, 0, 0, 64, 128, 192, 3, 7, 20, SYNC_NP}, /* 0x17 */
+	{1280, 768, 75, 5, 3, 60300, 102250, 0, 0, 80, 128, 208, 3, 7, 27, SYNC_NP}, /* 0x18 */
+	{1280, 768, 85, 5, 3, 68600, 117500, 0, 0, 80, 136, 216, 3, 7, 31, SYNC_NP}, /* 0x19 */
+	{1280, 768, 120, 5, 3, 97396, 140250, 1, 0, 48, 32, 80, 3, 7, 35, SYNC_PN}, /* 0x1a */
+	{1280, 800, 60, 16, 10, 49306, 71000, 1, 0, 48, 32, 80, 3, 6, 14, SYNC_PN}, /* 0x1b */
+	{1280, 800, 60, 16, 10, 49702, 83500, 0, 0, 72, 128, 200, 3, 6, 22, SYNC_NP}, /* 0x1c */
+	{1280, 800, 75, 16, 10, 62795, 106500, 0, 0, 80, 128, 208, 3, 6, 29, SYNC_NP}, /* 0x1d */
+	{1280, 800, 85, 16, 10, 71554, 122500, 0, 0, 80, 136, 216, 3, 6, 34, SYNC_NP}, /* 0x1e */
+	{1280, 800, 120, 16, 10, 101563, 146250, 1, 0, 48, 32, 80, 3, 6, 38, SYNC_PN}, /* 0x1f */
+	{1280, 960, 60, 4, 3, 60000, 108000, 0, 0, 96, 112, 312, 1, 3, 36, SYNC_PP}, /* 0x20 */
+	{1280, 960, 85, 4, 3, 85900, 148500, 0, 0, 64, 160, 224, 1, 3, 47, SYNC_PP}, /* 0x21 */
+	{1280, 960, 120, 4, 3, 121875, 175500, 1, 0, 48, 32, 80, 3, 4, 50, SYNC_PN}, /* 0x22 */
+	{1280, 1024, 60, 5, 4, 64000, 108000, 0, 0, 48, 112, 248, 1, 3, 38, SYNC_PP}, /* 0x23 */
+	{1280, 1024, 75, 5, 4, 80000, 135000, 0, 0, 16, 144, 248, 1, 3, 38, SYNC_PP}, /* 0x24 */
+	{1280, 1024, 85, 5, 4, 91100, 157500, 0, 0, 64, 160, 224, 1, 3, 44, SYNC_PP}, /* 0x25 */
+	{1280, 1024, 120, 5, 4, 130035, 187250, 1, 0, 48, 32, 80, 3, 7, 50, SYNC_PN}, /* 0x26 */
+	{1360, 768, 60, 85, 48, 47700, 85500, 0, 0, 64, 112, 256, 3, 6, 18, SYNC_PP}, /* 0x27 */
+	{1360, 768, 120, 85, 48, 97533, 148250, 1, 0, 48, 32, 80, 3, 5, 37, SYNC_PN}, /* 0x28 */
+	{1400, 1050, 60, 4, 3, 64700, 101000, 1, 0, 48, 32, 80, 3, 4, 23, SYNC_PN}, /* 0x29 */
+	{1400, 1050, 60, 4, 3, 65300, 121750, 0, 0, 88, 144, 232, 3, 4, 32, SYNC_NP}, /* 0x2a */
+	{1400, 1050, 75, 4, 3, 82300, 156000, 0, 0, 104, 144, 248, 3, 4, 42, SYNC_NP}, /* 0x2b */
+	{1400, 1050, 85, 4, 3, 93900, 179500, 0, 0, 104, 152, 256, 3, 4, 48, SYNC_NP}, /* 0x2c */
+	{1400, 1050, 120, 4, 3, 133333, 208000, 1, 0, 48, 32, 80, 3, 4, 55, SYNC_PN}, /* 0x2d */
+	{1440, 900, 60, 16, 10, 55500, 88750, 1, 0, 48, 32, 80, 3, 6, 17, SYNC_PN}, /* 0x2e */
+	{1440, 900, 60, 16, 10, 55935, 106500, 0, 0, 80, 152, 232, 3, 6, 25, SYNC_NP}, /* 0x2f */
+	{1440, 900, 75, 16, 10, 70635, 136750, 0, 0, 96, 152, 248, 3, 6, 33, SYNC_NP}, /* 0x30 */
+	{1440, 900, 85, 16, 10, 80430, 157000, 0, 0, 104, 152, 256, 3, 6, 39, SYNC_NP}, /* 0x31 */
+	{1440, 900, 120, 16, 10, 114219, 182750, 1, 0, 48, 32, 80, 3, 6, 44, SYNC_PN}, /* 0x32 */
+	{1600, 1200, 60, 4, 3, 75000, 162000, 0, 0, 64, 192, 304, 1, 3, 46, SYNC_PP}, /* 0x33 */
+	{1600, 1200, 65, 4, 3, 81300, 175500, 0, 0, 64, 192, 304, 1, 3, 46, SYNC_PP}, /* 0x34 */
+	{1600, 1200, 70, 4, 3, 87500, 189000, 0, 0, 64, 192, 304, 1, 3, 46, SYNC_PP}, /* 0x35 */
+	{1600, 1200, 75, 4, 3, 93800, 202500, 0, 0, 64, 192, 304, 1, 3, 46, SYNC_PP}, /* 0x36 */
+	{1600, 1200, 85, 4, 3, 106300, 229500, 0, 0, 64, 192, 304, 1, 3, 46, SYNC_PP}, /* 0x37 */
+	{1600, 1200, 120, 4, 3, 152415, 268250, 1, 0, 48, 32, 80, 3, 4, 64, SYNC_PN}, /* 0x38 */
+	{1680, 1050, 60, 16, 10, 64700, 119000, 1, 0, 48, 32, 80, 3, 6, 21, SYNC_PN}, /* 0x39 */
+	{1680, 1050, 60, 16, 10, 65300, 146250, 0, 0, 104, 176, 280, 3, 6, 30, SYNC_NP}, /* 0x3a */
+	{1680, 1050, 75, 16, 10, 82300, 187000, 0, 0, 120, 176, 296, 3, 6, 40, SYNC_NP}, /* 0x3b */
+	{1680, 1050, 85, 16, 10, 93900, 214750, 0, 0, 128, 176, 304, 3, 6, 46, SYNC_NP}, /* 0x3c */
+	{1680, 1050, 120, 16, 10, 133424, 245500, 1, 0, 48, 32, 80, 3, 6, 53, SYNC_PN}, /* 0x3d */
+	{1792, 1344, 60, 4, 3, 83600, 204750, 0, 0, 128, 200, 328, 1, 3, 46, SYNC_NP}, /* 0x3e */
+	{1792, 1344, 75, 4, 3, 106300, 261000, 0, 0, 96, 216, 352, 1, 3, 69, SYNC_NP}, /* 0x3f */
+	{1792, 1344, 120, 4, 3, 170722, 333250, 1, 0, 48, 32, 80, 3, 4, 72, SYNC_PN}, /* 0x40 */
+	{1856, 1392, 60, 4, 3, 86300, 218250, 0, 0, 96, 224, 352, 1, 3, 43, SYNC_NP}, /* 0x41 */
+	{1856, 1392, 75, 4, 3, 112500, 288000, 0, 0, 128, 224, 352, 1, 3, 104, SYNC_NP}, /* 0x42 */
+	{1856, 1392, 120, 4, 3, 176835, 356500, 1, 0, 48, 32, 80, 3, 4, 75, SYNC_PN}, /* 0x43 */
+	{1920, 1200, 60, 16, 10, 74000, 154000, 1, 0, 48, 32, 80, 3, 6, 26, SYNC_PN}, /* 0x44 */
+	{1920, 1200, 60, 16, 10, 74600, 193250, 0, 0, 136, 200, 336, 3, 6, 36, SYNC_NP}, /* 0x45 */
+	{1920, 1200, 75, 16, 10, 94000, 245250, 0, 0, 136, 208, 344, 3, 6, 46, SYNC_NP}, /* 0x46 */
+	{1920, 1200, 85, 16, 10, 107200, 281250, 0, 0, 144, 208, 352, 3, 6, 53, SYNC_NP}, /* 0x47 */
+	{1920, 1200, 120, 16, 10, 152404, 317000, 1, 0, 48, 32, 80, 3, 6, 62, SYNC_PN}, /* 0x48 */
+	{1920, 1440, 60, 4, 3, 90000, 234000, 0, 0, 128, 208, 344, 1, 3, 56, SYNC_NP}, /* 0x49 */
+	{1920, 1440, 75, 4, 3, 112500, 297000, 0, 0, 144, 224, 352, 1, 3, 56, SYNC_NP}, /* 0x4a */
+	{1920, 1440, 120, 4, 3, 182933, 380500, 1, 0, 48, 32, 80, 3, 4, 78, SYNC_PN}, /* 0x4b */
+	{2560, 1600, 60, 16, 10, 98713, 268500, 1, 0, 48, 32, 80, 3, 6, 37, SYNC_PN}, /* 0x4c */
+	{2560, 1600, 60, 16, 10, 99458, 348500, 0, 0, 192, 280, 472, 3, 6, 49, SYNC_NP}, /* 0x4d */
+	{2560, 1600, 75, 16, 10, 125354, 443250, 0, 0, 208, 280, 488, 3, 6, 63, SYNC_NP}, /* 0x4e */
+	{2560, 1600, 85, 16, 10, 142887, 505250, 0, 0, 208, 280, 488, 3, 6, 73, SYNC_NP}, /* 0x4f */
+	{2560, 1600, 120, 16, 10, 203217, 552750, 1, 0, 48, 32, 80, 3, 6, 85, SYNC_PN}, /* 0x50 */
+	{1366, 768, 60, 16, 9, 47712, 85500, 0, 0, 70, 143, 213, 3, 3, 24, SYNC_PP}, /* 0x51 */
+	{1920, 1080, 60, 16, 9, 67500, 148500, 0, 0, 88, 44, 148, 4, 5, 36, SYNC_PP}, /* 0x52 */
+	{1600, 900, 60, 16, 9, 60000, 108000, 1, 0, 24, 80, 96, 1, 3, 96, SYNC_PP}, /* 0x53 */
+	{2048, 1152, 60, 16, 9, 72000, 162000, 1, 0, 26, 80, 96, 1, 3, 44, SYNC_PP}, /* 0x54 */
+	{1280, 720, 60, 16, 9, 45000, 74250, 0, 0, 110, 40, 220, 5, 5, 20, SYNC_PP}, /* 0x55 */
+	{1366, 768, 60, 16, 9, 48000, 72000, 1, 0, 14, 56, 64, 1, 3, 28, SYNC_PP}, /* 0x56 */
+	{4096, 2160, 60, 256, 135, 133320, 556744, 2, 0, 8, 32, 40, 48, 8, 6, SYNC_PN}, /* 0x57 */
+	{4096, 2160, 59, 256, 135, 133187, 556188, 2, 0, 8, 32, 40, 48, 8, 6, SYNC_PN}, /* 0x58, 59.94 Hz */
+	/* established timings that are not in DMT */
+	{720, 400, 70, 9, 5, 31469, 28320, 0, 0, 18, 108, 54, 12, 2, 35, SYNC_NP},
+	{720, 400, 88, 9, 5, 39500, 35500, 0, 0, 18, 108, 54, 12, 2, 35, SYNC_NP},
+	{640, 480, 67, 4, 3, 35000, 30240, 0, 0, 64, 64, 96, 3, 3, 39, SYNC_NN},
+	{832, 624, 75, 4, 3, 49726, 57284, 0, 0, 32, 64, 224, 1, 3, 39, SYNC_NN},
+	{1024, 768, 87, 4, 3, 35522, 44900, 0, 1, 8, 176, 56, 0, 4, 20, SYNC_PP},
+	{1152, 870, 75, 192, 145, 68681, 100000, 0, 0, 32, 128, 144, 3, 3, 39, SYNC_NN},
+};
+
+#define NUM_DMT		0x58
+#define DMT(id)		((id) - 1)
+#define NON_DMT(n)	(NUM_DMT + (n))
+
+/* Established timings I and II, as indices in timing_db */
+static const unsigned char established_timings[] = {
+	/* 0x23 bit 7 - 0 */
+	NON_DMT(0), NON_DMT(1), DMT(0x04), NON_DMT(2), DMT(0x05), DMT(0x06), DMT(0x08), DMT(0x09),
+	/* 0x24 bit 7 - 0 */
+	DMT(0x0a), DMT(0x0b), NON_DMT(3), NON_DMT(4), DMT(0x10), DMT(0x11), DMT(0x12), DMT(0x24),
+	/* 0x25 bit 7 */
+	NON_DMT(5),
+};
+
+/* Established timings III */
+static const unsigned char established_timings3[] = {
+	/* 0x06 bit 7 - 0 */
+	DMT(0x01), DMT(0x02), DMT(0x03), DMT(0x07), DMT(0x0e), DMT(0x0c), DMT(0x13), DMT(0x15),
+	/* 0x07 bit 7 - 0 */
+	DMT(0x16), DMT(0x17), DMT(0x18), DMT(0x19), DMT(0x20), DMT(0x21), DMT(0x23), DMT(0x25),
+	/* 0x08 bit 7 - 0 */
+	DMT(0x27), DMT(0x2e), DMT(0x2f), DMT(0x30), DMT(0x31), DMT(0x29), DMT(0x2a), DMT(0x2b),
+	/* 0x09 bit 7 - 0 */
+	DMT(0x2c), DMT(0x39), DMT(0x3a), DMT(0x3b), DMT(0x3c), DMT(0x33), DMT(0x34), DMT(0x35),
+	/* 0x0a bit 7 - 0 */
+	DMT(0x36), DMT(0x37), DMT(0x3e), DMT(0x3f), DMT(0x41), DMT(0x42), DMT(0x44), DMT(0x45),
+	/* 0x0b bit 7 - 4 */
+	DMT(0x46), DMT(0x47), DMT(0x49), DMT(0x4a),
+};
+
+static const struct std_timing *dmt_timing(unsigned dmt_id)
+{
+	if (dmt_id < 1 || dmt_id > NUM_DMT)
+		return NULL;
+	return &timing_db[DMT(dmt_id)];
+}
+
+/*
+ * timing_db, hashed on the size, refresh rate, reduced blanking and
+ * interlacing: each slot holds an index in timing_db + 1, or 0. It is
+ * filled before main() so that lookups need no locking.
+ */
+static unsigned char timing_hash[256];
+
+static unsigned timing_key(unsigned x, unsigned y, unsigned refresh,
+			   unsigned rb, unsigned interlaced)
+{
+	return (x * 7 + y * 3 + refresh * 5 + rb * 11 + interlaced) &
+	       (ARRAY_SIZE(timing_hash) - 1);
+}
+
+__attribute__((constructor)) static void timing_hash_init(void)
+{
+	unsigned i;
+
+	for (i = 0; i < ARRAY_SIZE(timing_db); i++) {
+		const struct std_timing *t = &timing_db[i];
+		unsigned h = timing_key(t->x, t->y, t->refresh, t->rb, t->interlaced);
+
+		while (timing_hash[h])
+			h = (h + 1) & (ARRAY_SIZE(timing_hash) - 1);
+		timing_hash[h] = i + 1;
+	}
+}
+
+static const struct std_timing *find_timing(unsigned x, unsigned y, unsigned refresh,
+					    unsigned rb, unsigned interlaced)
+{
+	unsigned h = timing_key(x, y, refresh, rb, interlaced);
+
+	for (; timing_hash[h]; h = (h + 1) & (ARRAY_SIZE(timing_hash) - 1)) {
+		const struct std_timing *t = &timing_db[timing_hash[h] - 1];
+
+		if (t->x == x && t->y == y && t->refresh == refresh &&
+		    t->rb == rb && t->interlaced == interlaced)
+			return t;
+	}
+	return NULL;
+}
+
+/* Fill et with the timing of t, listed at x */
+static void db_to_timing(struct edid_state *state, struct edid_timing *et,
+			 const struct std_timing *t, const unsigned char *x)
+{
+	memset(et, 0, sizeof(*et));
+	et->pixclk_khz = t->pixclk_khz;
+	et->hact = t->x;
+	et->hfp = t->hfp;
+	et->hsync = t->hsync;
+	et->hbp = t->hbp;
+	et->vact = t->interlaced ? t->y / 2 : t->y;
+	et->vfp = t->vfp;
+	et->vsync = t->vsync;
+	et->vbp = t->vbp;
+	et->flags = t->sync | (t->interlaced ? EDID_TIMING_INTERLACED : 0);
+	et->source = EDID_SRC_DMT;
+	et->offset = edid_offset(state, x);
+	et->block = et->offset / EDID_PAGE_SIZE;
+}
+
+/* Widen the span of the refresh rates of all timings to vfreq_hz */
+static void info_span_vfreq(struct edid_info *info, unsigned vfreq_hz)
+{
+	info->min_vfreq_hz = min(info->min_vfreq_hz, vfreq_hz);
+	info->max_vfreq_hz = max(info->max_vfreq_hz, vfreq_hz);
+}
+
+/* Likewise for the line rates and pixel clocks */
+static void info_span_hfreq(struct edid_info *info, unsigned hfreq_hz,
+			    unsigned pixclk_khz)
+{
+	info->min_hfreq_hz = min(info->min_hfreq_hz, hfreq_hz);
+	info->max_hfreq_hz = max(info->max_hfreq_hz, hfreq_hz);
+	info->max_pixclk_khz = max(info->max_pixclk_khz, pixclk_khz);
+}
+
+/* Account for a timing of timing_db listed at x and add it to the mode set */
+static void add_db_timing(struct edid_state *state, const struct std_timing *t,
+			  const unsigned char *x, unsigned source)
+{
+	struct edid_timing et;
+
+	info_span_vfreq(state->info, t->refresh);
+	info_span_hfreq(state->info, t->hor_freq_hz, t->pixclk_khz);
+	db_to_timing(state, &et, t, x);
+	info_add_mode(state, &et, source, 0);
+}
+
+/*
+ * Decode the standard timing code at std into *st. Returns 0 for an
+ * unused code and for one without a size.
+ */
+static int std_timing_decode(const unsigned char *std, int claims_one_point_three,
+			     struct edid_std_timing *st)
+{
+	unsigned char b1 = std[0], b2 = std[1];
+
+	if ((b1 == 0x01 && b2 == 0x01) || b1 == 0)
+		return 0;
+	st->hact = (b1 + 31) * 8;
+	switch ((b2 >> 6) & 0x3) {
+	case 0x00:
+		if (claims_one_point_three) {
+			st->vact = st->hact * 10 / 16;
+			st->ratio_w = 16;
+			st->ratio_h = 10;
+		} else {
+			st->vact = st->hact;
+			st->ratio_w = 1;
+			st->ratio_h = 1;
+		}
+		break;
+	case 0x01:
+		st->vact = st->hact * 3 / 4;
+		st->ratio_w = 4;
+		st->ratio_h = 3;
+		break;
+	case 0x02:
+		st->vact = st->hact * 4 / 5;
+		st->ratio_w = 5;
+		st->ratio_h = 4;
+		break;
+	case 0x03:
+		st->vact = st->hact * 9 / 16;
+		st->ratio_w = 16;
+		st->ratio_h = 9;
+		break;
+	}
+	st->refresh = 60 + (b2 & 0x3f);
+	return 1;
+}
+
+/*
+ * The timing_db entry of a standard timing, or NULL. A code cannot tell
+ * if reduced blanking is meant. As the DMT table order did, prefer the
+ * reduced blanking timing where there is one.
+ */
+static const struct std_timing *find_std_timing(const struct edid_std_timing *st)
+{
+	const struct std_timing *t = find_timing(st->hact, st->vact, st->refresh, 1, 0);
+
+	return t ? t : find_timing(st->hact, st->vact, st->refresh, 0, 0);
+}
+
+static void standard_timing(struct edid_state *state, const unsigned char *std)
+{
+	struct edid_info *info = state->info;
+	struct edid_std_timing st;
+	const struct std_timing *t;
+	struct edid_timing et;
+
+	if (!std_timing_decode(std, state->claims_one_point_three, &st))
+		return;
+	info_add_std_timing(state, st.hact, st.vact, st.refresh, st.ratio_w, st.ratio_h);
+
+	info_span_vfreq(info, st.refresh);
+	t = find_std_timing(&st);
+	if (t) {
+		info_span_hfreq(info, t->hor_freq_hz, t->pixclk_khz);
+		db_to_timing(state, &et, t, std);
+		info_add_mode(state, &et, EDID_MODE_SRC_STANDARD, 0);
+	} else if (!edid_calc_timing(st.hact, st.vact, st.refresh,
+				     state->claims_one_point_four ?
+				     EDID_FORMULA_CVT : EDID_FORMULA_GTF, &et)) {
+		/* Not a DMT: EDID 1.4 implies CVT, older versions GTF */
+		info_span_hfreq(info, timing_hfreq(&et), et.pixclk_khz);
+		et.offset = edid_offset(state, std);
+		et.block = et.offset / EDID_PAGE_SIZE;
+		info_add_mode(state, &et, EDID_MODE_SRC_STANDARD, 0);
+	}
+}
+
+/* 1 means valid data */
+/* Fill t from the detailed timing descriptor at x */
+static void dtd_to_timing(struct edid_timing *t, const unsigned char *x)
+{
+	unsigned hbl = x[3] + ((x[4] & 0x0F) << 8);
+	unsigned vbl = x[6] + ((x[7] & 0x0F) << 8);
+
+	t->pixclk_khz = (x[0] + (x[1] << 8)) * 10;
+	t->hact = x[2] + ((x[4] & 0xF0) << 4);
+	t->hfp = x[8] + ((x[11] & 0xC0) << 2);
+	t->hsync = x[9] + ((x[11] & 0x30) << 4);
+	t->hbp = hbl - t->hfp - t->hsync;
+	t->hborder = x[15];
+	t->vact = x[5] + ((x[7] & 0xF0) << 4);
+	t->vfp = (x[10] >> 4) + ((x[11] & 0x0C) << 2);
+	t->vsync = (x[10] & 0x0F) + ((x[11] & 0x03) << 4);
+	t->vbp = vbl - t->vfp - t->vsync;
+	t->vborder = x[16];
+	t->hsize_mm = x[12] + ((x[14] & 0xF0) << 4);
+	t->vsize_mm = x[13] + ((x[14] & 0x0F) << 8);
+	if (x[17] & 0x80)
+		t->flags |= EDID_TIMING_INTERLACED;
+	if (x[17] & (1 << 1))
+		t->flags |= EDID_TIMING_PHSYNC;
+	if (x[17] & (1 << 2))
+		t->flags |= EDID_TIMING_PVSYNC;
+}
+
+static int detailed_block(struct edid_state *state, const unsigned char *x, int in_extension)
+{
+	int ha, hbl, va, vbl;
+	int refresh, hfreq, pixclk_khz;
+	int i;
+	struct edid_timing *t;
+
+	if (x[0] == 0 && x[1] == 0) {
+		/* Monitor descriptor block, not detailed timing descriptor. */
+		if (x[2] != 0) {
+			/* 1.3, 3.10.3 */
+			state->has_valid_descriptor_pad = 0;
+			check_at(state, EDID_FINDING_DESCRIPTOR_PAD, x + 2);
+		}
+		if (x[3] != 0xfd && x[4] != 0x00) {
+			/* 1.3, 3.10.3 */
+			state->has_valid_descriptor_pad = 0;
+			check_at(state, EDID_FINDING_DESCRIPTOR_PAD, x + 4);
+		}
+
+		state->seen_non_detailed_descriptor = 1;
+		check_at(state, EDID_FINDING_NON_DETAILED_DESCRIPTOR, x);
+		if (x[3] <= 0xF)
+			return 1;
+		switch (x[3]) {
+		case 0x10:
+			for (i = 5; i < 18; i++)
+				if (x[i] != 0x00) {
+					state->has_valid_dummy_block = 0;
+					check_at(state, EDID_FINDING_DUMMY_BLOCK_GARBAGE, x + i);
+				}
+			return 1;
+		case 0xF7:
+			for (i = 0; i < 44; i++) {
+				if (x[6 + i / 8] & (1 << (7 - i % 8)))
+					add_db_timing(state, &timing_db[established_timings3[i]],
+						      x + 6 + i / 8, EDID_MODE_SRC_ESTABLISHED);
+			}
+			return 1;
+		case 0xF8: {
+			int valid_cvt = 1; /* just this block */
+
+			if (x[5] != 0x01) {
+				state->has_valid_cvt = 0;
+				check_at(state, EDID_FINDING_CVT, x + 5);
+				return 0;
+			}
+			for (i = 0; i < 4; i++) {
+				if (!detailed_cvt_descriptor(state, x + 6 + (i * 3), (i == 0))) {
+					valid_cvt = 0;
+					check_at(state, EDID_FINDING_CVT, x + 6 + (i * 3));
+				}
+			}
+			state->has_valid_cvt &= valid_cvt;
+			return valid_cvt;
+		}
+		case 0xF9:
+		case 0xFB:
+			return 1;
+		case 0xFA:
+			for (i = 0; i < 6; i++)
+				standard_timing(state, x + 5 + i * 2);
+			return 1;
+		case 0xFC:
+			state->has_name_descriptor = 1;
+			extract_string(state, "Display Product Name", x + 5, &state->has_valid_name_descriptor, 13);
+			if (!state->has_valid_name_descriptor)
+				check_at(state, EDID_FINDING_INVALID_NAME, x + 5);
+			info_copy_string(state->info->base.name, state->string);
+			return 1;
+		case 0xFD: {
+			int h_max_offset = 0, h_min_offset = 0;
+			int v_max_offset = 0, v_min_offset = 0;
+			int is_cvt = 0;
+			struct edid_range_limits *range;
+			state->has_range_descriptor = 1;
+			check_at(state, EDID_FINDING_OUT_OF_RANGE, x);
+			/* 
+			 * XXX todo: implement feature flags, vtd blocks
+			 * XXX check: ranges are well-formed; block termination if no vtd
+			 */
+			if (state->claims_one_point_four) {
+				if (x[4] & 0x02) {
+					v_max_offset = 255;
+					if (x[4] & 0x01) {
+						v_min_offset = 255;
+					}
+				}
+				if (x[4] & 0x04) {
+					h_max_offset = 255;
+					if (x[4] & 0x03) {
+						h_min_offset = 255;
+					}
+				}
+			} else if (x[4]) {
+				state->has_valid_range_descriptor = 0;
+			}
+
+			/*
+			 * despite the values, this is not a bitfield.
+			 */
+			switch (x[10]) {
+			case 0x00: /* default gtf */
+			case 0x02: /* secondary gtf curve */
+				break;
+			case 0x01: /* range limits only */
+				if (!state->claims_one_point_four)
+					state->has_valid_range_descriptor = 0;
+				break;
+			case 0x04: /* cvt */
+				is_cvt = 1;
+				if (!state->claims_one_point_four)
+					state->has_valid_range_descriptor = 0;
+				break;
+			default: /* invalid */
+				state->has_valid_range_descriptor = 0;
+				break;
+			}
+
+			if (x[5] + v_min_offset > x[6] + v_max_offset)
+				state->has_valid_range_descriptor = 0;
+			if (x[7] + h_min_offset > x[8] + h_max_offset)
+				state->has_valid_range_descriptor = 0;
+			state->info->base.has_range_limits = 1;
+			range = &state->info->base.range_limits;
+			range->min_vfreq_hz = x[5] + v_min_offset;
+			range->max_vfreq_hz = x[6] + v_max_offset;
+			range->min_hfreq_khz = x[7] + h_min_offset;
+			range->max_hfreq_khz = x[8] + h_max_offset;
+			range->max_pixclk_mhz = x[9] * 10;
+			range->type = x[10];
+			if (is_cvt) {
+				range->pixclk_adjust_khz = (x[12] >> 2) * 250;
+				range->max_hact = (((x[12] & 0x03) << 8) | x[13]) * 8;
+				range->cvt_blanking = x[15] & 0x18;
+			}
+			if (!x[9] && state->claims_one_point_four) {
+				state->has_valid_max_dotclock = 0;
+				check_at(state, EDID_FINDING_MISSING_MAX_DOTCLOCK, x + 9);
+			}
+
+			if (is_cvt) {
+				if ((x[12] & 0xfc) >> 2 >= 40) {
+					state->warning_excessive_dotclock_correction = 1;
+					check_at(state, EDID_FINDING_CVT_DOTCLOCK_CORRECTION, x + 12);
+				}
+				if ((x[14] & 0x07) || (x[15] & 0x07) || (x[16] & 0x0f))
+					state->has_valid_range_descriptor = 0;
+				if (!x[17]) {
+					state->warning_zero_preferred_refresh = 1;
+					check_at(state, EDID_FINDING_CVT_NO_PREFERRED_REFRESH, x + 17);
+				}
+			}
+
+			if (!state->has_valid_range_descriptor)
+				check_at(state, EDID_FINDING_RANGE_DESCRIPTOR_GARBAGE, x);
+
+			/*
+			 * Slightly weird to return a global, but I've never seen any
+			 * EDID block wth two range descriptors, so it's harmless.
+			 */
+			return state->has_valid_range_descriptor;
+		}
+		case 0xFE:
+			/*
+			 * TODO: Two of these in a row, in the third and fourth slots,
+			 * seems to be specified by SPWG: http://www.spwg.org/
+			 */
+			state->has_ascii_string = 1;
+			extract_string(state, "Alphanumeric Data String", x + 5, &state->has_valid_ascii_string, 13);
+			if (!state->has_valid_ascii_string)
+				check_at(state, EDID_FINDING_INVALID_ASCII_STRING, x + 5);
+			info_copy_string(state->info->base.ascii_string, state->string);
+			return 1;
+		case 0xFF:
+			state->has_serial_string = 1;
+			extract_string(state, "Display Product Serial Number", x + 5, &state->has_valid_serial_string, 13);
+			if (!state->has_valid_serial_string)
+				check_at(state, EDID_FINDING_INVALID_SERIAL_STRING, x + 5);
+			info_copy_string(state->info->base.serial_string, state->string);
+			return 1;
+		default:
+			return 0;
+		}
+	}
+
+	if (state->seen_non_detailed_descriptor && !in_extension) {
+		state->has_valid_descriptor_ordering = 0;
+		check_at(state, EDID_FINDING_DESCRIPTOR_ORDERING, x);
+	}
+
+	state->did_detailed_timing = 1;
+	ha = (x[2] + ((x[4] & 0xF0) << 4));
+	hbl = (x[3] + ((x[4] & 0x0F) << 8));
+	va = (x[5] + ((x[7] & 0xF0) << 4));
+	vbl = (x[6] + ((x[7] & 0x0F) << 8));
+	if (!ha || !hbl || !va || !vbl)
+		return 0;
+
+	pixclk_khz = (x[0] + (x[1] << 8)) * 10;
+	refresh = (pixclk_khz * 1000) / ((ha + hbl) * (va + vbl));
+	hfreq = (pixclk_khz * 1000) / (ha + hbl);
+	info_span_vfreq(state->info, refresh);
+	info_span_hfreq(state->info, hfreq, pixclk_khz);
+
+	t = info_add_timing(state, x, in_extension ? EDID_SRC_CTA : EDID_SRC_BASE);
+	if (t) {
+		unsigned mode_flags = 0;
+
+		dtd_to_timing(t, x);
+		if (!in_extension && t->offset == 0x36 && state->has_preferred_timing) {
+			t->flags |= EDID_TIMING_PREFERRED;
+			mode_flags = EDID_MODE_PREFERRED;
+			if (state->claims_one_point_four && (state->edid[0x18] & 0x02))
+				mode_flags |= EDID_MODE_NATIVE;
+		}
+		if (in_extension) {
+			const unsigned char *ext = state->edid + t->block * EDID_PAGE_SIZE;
+
+			/* byte 3 counts the native DTDs at the start of the list */
+			if (ext[1] >= 2 &&
+			    (t->offset % EDID_PAGE_SIZE - ext[2]) / 18 < (ext[3] & 0x0f))
+				mode_flags |= EDID_MODE_NATIVE;
+		}
+		info_add_mode(state, t, in_extension ? EDID_MODE_SRC_CTA_DTD :
+			      EDID_MODE_SRC_DETAILED, mode_flags);
+	}
+	/* XXX flag decode */
+
+	return 1;
+}
+
+static int do_checksum(const unsigned char *x, size_t len)
+{
+	unsigned char sum = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		sum += x[i];
+	return sum == 0;
+}
+
+/* CTA extension */
+
+static const char *audio_ext_format(unsigned char x)
+{
+	switch (x) {
+	case 4: return "MPEG-4 HE AAC";
+	case 5: return "MPEG-4 HE AAC v2";
+	case 6: return "MPEG-4 AAC LC";
+	case 7: return "DRA";
+	case 8: return "MPEG-4 HE AAC + MPEG Surround";
+	case 10: return "MPEG-4 AAC LC + MPEG Surround";
+	case 11: return "MPEG-H 3D Audio";
+	case 12: return "AC-4";
+	case 13: return "L-PCM 3D Audio";
+	default: return "RESERVED";
+	}
+	return "BROKEN"; /* can't happen */
+}
+
+static const char *audio_format(unsigned char x)
+{
+	switch (x) {
+	case 0: return "RESERVED";
+	case 1: return "Linear PCM";
+	case 2: return "AC-3";
+	case 3: return "MPEG 1 (Layers 1 & 2)";
+	case 4: return "MPEG 1 Layer 3 (MP3)";
+	case 5: return "MPEG2 (multichannel)";
+	case 6: return "AAC";
+	case 7: return "DTS";
+	case 8: return "ATRAC";
+	case 9: return "One Bit Audio";
+	case 10: return "Dolby Digital+";
+	case 11: return "DTS-HD";
+	case 12: return "MAT (MLP)";
+	case 13: return "DST";
+	case 14: return "WMA Pro";
+	case 15: return "RESERVED";
+	}
+	return "BROKEN"; /* can't happen */
+}
+
+static const char *mpeg_h_3d_audio_level(unsigned char x)
+{
+	switch (x) {
+	case 0: return "Unspecified";
+	case 1: return "Level 1";
+	case 2: return "Level 2";
+	case 3: return "Level 3";
+	case 4: return "Level 4";
+	case 5: return "Level 5";
+	case 6: return "Reserved";
+	case 7: return "Reserved";
+	}
+	return "BROKEN"; /* can't happen */
+}
+
+static void cta_audio_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	int i;
+
+	if (length % 3)
+		/* XXX non-state->conformant */
+		return;
+
+	for (i = 0; i < length; i += 3)
+		info_add_sad(state, x + i);
+}
+
+#define VIC_NN	0
+#define VIC_PP	(EDID_TIMING_PHSYNC | EDID_TIMING_PVSYNC)
+#define VIC_PN	EDID_TIMING_PHSYNC
+#define VIC_I	EDID_TIMING_INTERLACED
+
+/*
+ * Vertical values are per field for interlaced formats, as in detailed
+ * timing descriptors. The horizontal frequency is rounded to the Hz.
+ */
+#define VIC(vic, n, r, rw, rh, clk, ha, hf, hs, hb, va, vf, vs, vb, fl) \
+	[vic] = { n, r, rw, rh, \
+		  ((clk) * 1000ULL + ((ha) + (hf) + (hs) + (hb)) / 2) / \
+		  ((ha) + (hf) + (hs) + (hb)), \
+		  { .pixclk_khz = clk, \
+		    .hact = ha, .hfp = hf, .hsync = hs, .hbp = hb, \
+		    .vact = va, .vfp = vf, .vsync = vs, .vbp = vb, \
+		    .flags = fl, .source = EDID_SRC_VIC } }
+
+/* The CTA-861 video formats, indexed by VIC */
+static const struct edid_vic_mode edid_cta_modes[256] = {
+	VIC(1, "640x480@60Hz 4:3", 60, 4, 3, 25175,
+	    640, 16, 96, 48, 480, 10, 2, 33, VIC_NN),
+	VIC(2, "720x480@60Hz 4:3", 60, 4, 3, 27000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(3, "720x480@60Hz 16:9", 60, 16, 9, 27000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(4, "1280x720@60Hz 16:9", 60, 16, 9, 74250,
+	    1280, 110, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(5, "1920x1080i@60Hz 16:9", 60, 16, 9, 74250,
+	    1920, 88, 44, 148, 540, 2, 5, 15, VIC_PP | VIC_I),
+	VIC(6, "1440x480i@60Hz 4:3", 60, 4, 3, 27000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(7, "1440x480i@60Hz 16:9", 60, 16, 9, 27000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(8, "1440x240@60Hz 4:3", 60, 4, 3, 27000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN),
+	VIC(9, "1440x240@60Hz 16:9", 60, 16, 9, 27000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN),
+	VIC(10, "2880x480i@60Hz 4:3", 60, 4, 3, 54000,
+	    2880, 76, 248, 228, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(11, "2880x480i@60Hz 16:9", 60, 16, 9, 54000,
+	    2880, 76, 248, 228, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(12, "2880x240@60Hz 4:3", 60, 4, 3, 54000,
+	    2880, 76, 248, 228, 240, 4, 3, 15, VIC_NN),
+	VIC(13, "2880x240@60Hz 16:9", 60, 16, 9, 54000,
+	    2880, 76, 248, 228, 240, 4, 3, 15, VIC_NN),
+	VIC(14, "1440x480@60Hz 4:3", 60, 4, 3, 54000,
+	    1440, 32, 124, 120, 480, 9, 6, 30, VIC_NN),
+	VIC(15, "1440x480@60Hz 16:9", 60, 16, 9, 54000,
+	    1440, 32, 124, 120, 480, 9, 6, 30, VIC_NN),
+	VIC(16, "1920x1080@60Hz 16:9", 60, 16, 9, 148500,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(17, "720x576@50Hz 4:3", 50, 4, 3, 27000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(18, "720x576@50Hz 16:9", 50, 16, 9, 27000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(19, "1280x720@50Hz 16:9", 50, 16, 9, 74250,
+	    1280, 440, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(20, "1920x1080i@50Hz 16:9", 50, 16, 9, 74250,
+	    1920, 528, 44, 148, 540, 2, 5, 15, VIC_PP | VIC_I),
+	VIC(21, "1440x576i@50Hz 4:3", 50, 4, 3, 27000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(22, "1440x576i@50Hz 16:9", 50, 16, 9, 27000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(23, "1440x288@50Hz 4:3", 50, 4, 3, 27000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN),
+	VIC(24, "1440x288@50Hz 16:9", 50, 16, 9, 27000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN),
+	VIC(25, "2880x576i@50Hz 4:3", 50, 4, 3, 54000,
+	    2880, 48, 252, 276, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(26, "2880x576i@50Hz 16:9", 50, 16, 9, 54000,
+	    2880, 48, 252, 276, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(27, "2880x288@50Hz 4:3", 50, 4, 3, 54000,
+	    2880, 48, 252, 276, 288, 2, 3, 19, VIC_NN),
+	VIC(28, "2880x288@50Hz 16:9", 50, 16, 9, 54000,
+	    2880, 48, 252, 276, 288, 2, 3, 19, VIC_NN),
+	VIC(29, "1440x576@50Hz 4:3", 50, 4, 3, 54000,
+	    1440, 24, 128, 136, 576, 5, 5, 39, VIC_NN),
+	VIC(30, "1440x576@50Hz 16:9", 50, 16, 9, 54000,
+	    1440, 24, 128, 136, 576, 5, 5, 39, VIC_NN),
+	VIC(31, "1920x1080@50Hz 16:9", 50, 16, 9, 148500,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(32, "1920x1080@24Hz 16:9", 24, 16, 9, 74250,
+	    1920, 638, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(33, "1920x1080@25Hz 16:9", 25, 16, 9, 74250,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(34, "1920x1080@30Hz 16:9", 30, 16, 9, 74250,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(35, "2880x480@60Hz 4:3", 60, 4, 3, 108000,
+	    2880, 64, 248, 240, 480, 9, 6, 30, VIC_NN),
+	VIC(36, "2880x480@60Hz 16:9", 60, 16, 9, 108000,
+	    2880, 64, 248, 240, 480, 9, 6, 30, VIC_NN),
+	VIC(37, "2880x576@50Hz 4:3", 50, 4, 3, 108000,
+	    2880, 48, 256, 272, 576, 5, 5, 39, VIC_NN),
+	VIC(38, "2880x576@50Hz 16:9", 50, 16, 9, 108000,
+	    2880, 48, 256, 272, 576, 5, 5, 39, VIC_NN),
+	VIC(39, "1920x1080i@50Hz 16:9", 50, 16, 9, 72000,
+	    1920, 32, 168, 184, 540, 23, 5, 57, VIC_PN | VIC_I),
+	VIC(40, "1920x1080i@100Hz 16:9", 100, 16, 9, 148500,
+	    1920, 528, 44, 148, 540, 2, 5, 15, VIC_PP | VIC_I),
+	VIC(41, "1280x720@100Hz 16:9", 100, 16, 9, 148500,
+	    1280, 440, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(42, "720x576@100Hz 4:3", 100, 4, 3, 54000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(43, "720x576@100Hz 16:9", 100, 16, 9, 54000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(44, "1440x576i@100Hz 4:3", 100, 4, 3, 54000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(45, "1440x576i@100Hz 16:9", 100, 16, 9, 54000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(46, "1920x1080i@120Hz 16:9", 120, 16, 9, 148500,
+	    1920, 88, 44, 148, 540, 2, 5, 15, VIC_PP | VIC_I),
+	VIC(47, "1280x720@120Hz 16:9", 120, 16, 9, 148500,
+	    1280, 110, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(48, "720x480@120Hz 4:3", 120, 4, 3, 54000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(49, "720x480@120Hz 16:9", 120, 16, 9, 54000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(50, "1440x480i@120Hz 4:3", 120, 4, 3, 54000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(51, "1440x480i@120Hz 16:9", 120, 16, 9, 54000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(52, "720x576@200Hz 4:3", 200, 4, 3, 108000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(53, "720x576@200Hz 16:9", 200, 16, 9, 108000,
+	    720, 12, 64, 68, 576, 5, 5, 39, VIC_NN),
+	VIC(54, "1440x576i@200Hz 4:3", 200, 4, 3, 108000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(55, "1440x576i@200Hz 16:9", 200, 16, 9, 108000,
+	    1440, 24, 126, 138, 288, 2, 3, 19, VIC_NN | VIC_I),
+	VIC(56, "720x480@240Hz 4:3", 240, 4, 3, 108000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(57, "720x480@240Hz 16:9", 240, 16, 9, 108000,
+	    720, 16, 62, 60, 480, 9, 6, 30, VIC_NN),
+	VIC(58, "1440x480i@240Hz 4:3", 240, 4, 3, 108000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(59, "1440x480i@240Hz 16:9", 240, 16, 9, 108000,
+	    1440, 38, 124, 114, 240, 4, 3, 15, VIC_NN | VIC_I),
+	VIC(60, "1280x720@24Hz 16:9", 24, 16, 9, 59400,
+	    1280, 1760, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(61, "1280x720@25Hz 16:9", 25, 16, 9, 74250,
+	    1280, 2420, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(62, "1280x720@30Hz 16:9", 30, 16, 9, 74250,
+	    1280, 1760, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(63, "1920x1080@120Hz 16:9", 120, 16, 9, 297000,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(64, "1920x1080@100Hz 16:9", 100, 16, 9, 297000,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(65, "1280x720@24Hz 64:27", 24, 64, 27, 59400,
+	    1280, 1760, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(66, "1280x720@25Hz 64:27", 25, 64, 27, 74250,
+	    1280, 2420, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(67, "1280x720@30Hz 64:27", 30, 64, 27, 74250,
+	    1280, 1760, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(68, "1280x720@50Hz 64:27", 50, 64, 27, 74250,
+	    1280, 440, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(69, "1280x720@60Hz 64:27", 60, 64, 27, 74250,
+	    1280, 110, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(70, "1280x720@100Hz 64:27", 100, 64, 27, 148500,
+	    1280, 440, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(71, "1280x720@120Hz 64:27", 120, 64, 27, 148500,
+	    1280, 110, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(72, "1920x1080@24Hz 64:27", 24, 64, 27, 74250,
+	    1920, 638, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(73, "1920x1080@25Hz 64:27", 25, 64, 27, 74250,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(74, "1920x1080@30Hz 64:27", 30, 64, 27, 74250,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(75, "1920x1080@50Hz 64:27", 50, 64, 27, 148500,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(76, "1920x1080@60Hz 64:27", 60, 64, 27, 148500,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(77, "1920x1080@100Hz 64:27", 100, 64, 27, 297000,
+	    1920, 528, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(78, "1920x1080@120Hz 64:27", 120, 64, 27, 297000,
+	    1920, 88, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(79, "1680x720@24Hz 64:27", 24, 64, 27, 59400,
+	    1680, 1360, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(80, "1680x720@25Hz 64:27", 25, 64, 27, 59400,
+	    1680, 1228, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(81, "1680x720@30Hz 64:27", 30, 64, 27, 59400,
+	    1680, 700, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(82, "1680x720@50Hz 64:27", 50, 64, 27, 82500,
+	    1680, 260, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(83, "1680x720@60Hz 64:27", 60, 64, 27, 99000,
+	    1680, 260, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(84, "1680x720@100Hz 64:27", 100, 64, 27, 165000,
+	    1680, 60, 40, 220, 720, 5, 5, 95, VIC_PP),
+	VIC(85, "1680x720@120Hz 64:27", 120, 64, 27, 198000,
+	    1680, 60, 40, 220, 720, 5, 5, 95, VIC_PP),
+	VIC(86, "2560x1080@24Hz 64:27", 24, 64, 27, 99000,
+	    2560, 998, 44, 148, 1080, 4, 5, 11, VIC_PP),
+	VIC(87, "2560x1080@25Hz 64:27", 25, 64, 27, 90000,
+	    2560, 448, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(88, "2560x1080@30Hz 64:27", 30, 64, 27, 118800,
+	    2560, 768, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(89, "2560x1080@50Hz 64:27", 50, 64, 27, 185625,
+	    2560, 548, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(90, "2560x1080@60Hz 64:27", 60, 64, 27, 198000,
+	    2560, 248, 44, 148, 1080, 4, 5, 11, VIC_PP),
+	VIC(91, "2560x1080@100Hz 64:27", 100, 64, 27, 371250,
+	    2560, 218, 44, 148, 1080, 4, 5, 161, VIC_PP),
+	VIC(92, "2560x1080@120Hz 64:27", 120, 64, 27, 495000,
+	    2560, 548, 44, 148, 1080, 4, 5, 161, VIC_PP),
+	VIC(93, "3840x2160@24Hz 16:9", 24, 16, 9, 297000,
+	    3840, 1276, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(94, "3840x2160@25Hz 16:9", 25, 16, 9, 297000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(95, "3840x2160@30Hz 16:9", 30, 16, 9, 297000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(96, "3840x2160@50Hz 16:9", 50, 16, 9, 594000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(97, "3840x2160@60Hz 16:9", 60, 16, 9, 594000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(98, "4096x2160@24Hz 256:135", 24, 256, 135, 297000,
+	    4096, 1020, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(99, "4096x2160@25Hz 256:135", 25, 256, 135, 297000,
+	    4096, 968, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(100, "4096x2160@30Hz 256:135", 30, 256, 135, 297000,
+	    4096, 88, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(101, "4096x2160@50Hz 256:135", 50, 256, 135, 594000,
+	    4096, 968, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(102, "4096x2160@60Hz 256:135", 60, 256, 135, 594000,
+	    4096, 88, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(103, "3840x2160@24Hz 64:27", 24, 64, 27, 297000,
+	    3840, 1276, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(104, "3840x2160@25Hz 64:27", 25, 64, 27, 297000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(105, "3840x2160@30Hz 64:27", 30, 64, 27, 297000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(106, "3840x2160@50Hz 64:27", 50, 64, 27, 594000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(107, "3840x2160@60Hz 64:27", 60, 64, 27, 594000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(108, "1280x720@48Hz 16:9", 48, 16, 9, 90000,
+	    1280, 960, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(109, "1280x720@48Hz 64:27", 48, 64, 27, 90000,
+	    1280, 960, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(110, "1680x720@48Hz 64:27", 48, 64, 27, 99000,
+	    1680, 810, 40, 220, 720, 5, 5, 20, VIC_PP),
+	VIC(111, "1920x1080@48Hz 16:9", 48, 16, 9, 148500,
+	    1920, 638, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(112, "1920x1080@48Hz 64:27", 48, 64, 27, 148500,
+	    1920, 638, 44, 148, 1080, 4, 5, 36, VIC_PP),
+	VIC(113, "2560x1080@48Hz 64:27", 48, 64, 27, 198000,
+	    2560, 998, 44, 148, 1080, 4, 5, 11, VIC_PP),
+	VIC(114, "3840x2160@48Hz 16:9", 48, 16, 9, 594000,
+	    3840, 1276, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(115, "4096x2160@48Hz 256:135", 48, 256, 135, 594000,
+	    4096, 1020, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(116, "3840x2160@48Hz 64:27", 48, 64, 27, 594000,
+	    3840, 1276, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(117, "3840x2160@100Hz 16:9", 100, 16, 9, 1188000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(118, "3840x2160@120Hz 16:9", 120, 16, 9, 1188000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(119, "3840x2160@100Hz 64:27", 100, 64, 27, 1188000,
+	    3840, 1056, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(120, "3840x2160@120Hz 64:27", 120, 64, 27, 1188000,
+	    3840, 176, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(121, "5120x2160@24Hz 64:27", 24, 64, 27, 396000,
+	    5120, 1996, 88, 296, 2160, 8, 10, 22, VIC_PP),
+	VIC(122, "5120x2160@25Hz 64:27", 25, 64, 27, 396000,
+	    5120, 1696, 88, 296, 2160, 8, 10, 22, VIC_PP),
+	VIC(123, "5120x2160@30Hz 64:27", 30, 64, 27, 396000,
+	    5120, 664, 88, 128, 2160, 8, 10, 22, VIC_PP),
+	VIC(124, "5120x2160@48Hz 64:27", 48, 64, 27, 742500,
+	    5120, 746, 88, 296, 2160, 8, 10, 297, VIC_PP),
+	VIC(125, "5120x2160@50Hz 64:27", 50, 64, 27, 742500,
+	    5120, 1096, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(126, "5120x2160@60Hz 64:27", 60, 64, 27, 742500,
+	    5120, 164, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(127, "5120x2160@100Hz 64:27", 100, 64, 27, 1485000,
+	    5120, 1096, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(193, "5120x2160@120Hz 64:27", 120, 64, 27, 1485000,
+	    5120, 164, 88, 128, 2160, 8, 10, 72, VIC_PP),
+	VIC(194, "7680x4320@24Hz 16:9", 24, 16, 9, 1188000,
+	    7680, 2552, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(195, "7680x4320@25Hz 16:9", 25, 16, 9, 1188000,
+	    7680, 2352, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(196, "7680x4320@30Hz 16:9", 30, 16, 9, 1188000,
+	    7680, 552, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(197, "7680x4320@48Hz 16:9", 48, 16, 9, 2376000,
+	    7680, 2552, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(198, "7680x4320@50Hz 16:9", 50, 16, 9, 2376000,
+	    7680, 2352, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(199, "7680x4320@60Hz 16:9", 60, 16, 9, 2376000,
+	    7680, 552, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(200, "7680x4320@100Hz 16:9", 100, 16, 9, 4752000,
+	    7680, 2112, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(201, "7680x4320@120Hz 16:9", 120, 16, 9, 4752000,
+	    7680, 352, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(202, "7680x4320@24Hz 64:27", 24, 64, 27, 1188000,
+	    7680, 2552, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(203, "7680x4320@25Hz 64:27", 25, 64, 27, 1188000,
+	    7680, 2352, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(204, "7680x4320@30Hz 64:27", 30, 64, 27, 1188000,
+	    7680, 552, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(205, "7680x4320@48Hz 64:27", 48, 64, 27, 2376000,
+	    7680, 2552, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(206, "7680x4320@50Hz 64:27", 50, 64, 27, 2376000,
+	    7680, 2352, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(207, "7680x4320@60Hz 64:27", 60, 64, 27, 2376000,
+	    7680, 552, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(208, "7680x4320@100Hz 64:27", 100, 64, 27, 4752000,
+	    7680, 2112, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(209, "7680x4320@120Hz 64:27", 120, 64, 27, 4752000,
+	    7680, 352, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(210, "10240x4320@24Hz 64:27", 24, 64, 27, 1485000,
+	    10240, 1492, 176, 592, 4320, 16, 20, 594, VIC_PP),
+	VIC(211, "10240x4320@25Hz 64:27", 25, 64, 27, 1485000,
+	    10240, 2492, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(212, "10240x4320@30Hz 64:27", 30, 64, 27, 1485000,
+	    10240, 288, 176, 296, 4320, 16, 20, 144, VIC_PP),
+	VIC(213, "10240x4320@48Hz 64:27", 48, 64, 27, 2970000,
+	    10240, 1492, 176, 592, 4320, 16, 20, 594, VIC_PP),
+	VIC(214, "10240x4320@50Hz 64:27", 50, 64, 27, 2970000,
+	    10240, 2492, 176, 592, 4320, 16, 20, 44, VIC_PP),
+	VIC(215, "10240x4320@60Hz 64:27", 60, 64, 27, 2970000,
+	    10240, 288, 176, 296, 4320, 16, 20, 144, VIC_PP),
+	VIC(216, "10240x4320@100Hz 64:27", 100, 64, 27, 5940000,
+	    10240, 2192, 176, 592, 4320, 16, 20, 144, VIC_PP),
+	VIC(217, "10240x4320@120Hz 64:27", 120, 64, 27, 5940000,
+	    10240, 288, 176, 296, 4320, 16, 20, 144, VIC_PP),
+	VIC(218, "4096x2160@100Hz 256:135", 100, 256, 135, 1188000,
+	    4096, 800, 88, 296, 2160, 8, 10, 72, VIC_PP),
+	VIC(219, "4096x2160@120Hz 256:135", 120, 256, 135, 1188000,
+	    4096, 88, 88, 128, 2160, 8, 10, 72, VIC_PP),
+};
+
+static const struct edid_vic_mode *vic_to_mode(unsigned char vic)
+{
+	return edid_cta_modes[vic].name ? &edid_cta_modes[vic] : NULL;
+}
+
+const struct edid_vic_mode *edid_vic_mode(unsigned vic)
+{
+	return vic < ARRAY_SIZE(edid_cta_modes) ? vic_to_mode(vic) : NULL;
+}
+
+static void cta_svd(struct edid_state *state, const unsigned char *x, int n, int for_ycbcr420)
+{
+	int i;
+
+	for (i = 0; i < n; i++)  {
+		const struct edid_vic_mode *vicmode = NULL;
+		unsigned char svd = x[i];
+		unsigned char native;
+		unsigned char vic;
+
+		if ((svd & 0x7f) == 0)
+			continue;
+
+		if ((svd - 1) & 0x40) {
+			vic = svd;
+			native = 0;
+		} else {
+			vic = svd & 0x7f;
+			native = svd & 0x80;
+		}
+
+		vicmode = vic_to_mode(vic);
+		if (vicmode) {
+			switch (vic) {
+			case 95:
+				state->supported_hdmi_vic_vsb_codes |= 1 << 0;
+				break;
+			case 94:
+				state->supported_hdmi_vic_vsb_codes |= 1 << 1;
+				break;
+			case 93:
+				state->supported_hdmi_vic_vsb_codes |= 1 << 2;
+				break;
+			case 98:
+				state->supported_hdmi_vic_vsb_codes |= 1 << 3;
+				break;
+			}
+			info_span_vfreq(state->info, vicmode->refresh);
+			info_span_hfreq(state->info, vicmode->hor_freq_hz,
+					vicmode->timing.pixclk_khz / (for_ycbcr420 ? 2 : 1));
+		}
+
+		if (vic == 1)
+			state->has_cta861_vic_1 = 1;
+		info_add_svd(state, vic, (native ? EDID_SVD_NATIVE : 0) |
+				  (for_ycbcr420 ? EDID_SVD_YCBCR420_ONLY : 0));
+		if (vicmode) {
+			struct edid_timing t = vicmode->timing;
+			struct edid_mode *m;
+
+			t.offset = edid_offset(state, x + i);
+			t.block = t.offset / EDID_PAGE_SIZE;
+			m = info_add_mode(state, &t, EDID_MODE_SRC_CTA_SVD,
+					  (native ? EDID_MODE_NATIVE : 0) |
+					  (for_ycbcr420 ? EDID_MODE_YCBCR420_ONLY : 0));
+			if (m)
+				m->vic = vic;
+		}
+	}
+}
+
+static void cta_video_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	cta_svd(state, x, length, 0);
+}
+
+static void cta_y420vdb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	cta_svd(state, x, length, 1);
+}
+
+static void cta_y420cmdb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	state->has_y420cmdb = 1;
+	state->y420cmdb = x;
+	state->y420cmdb_len = length;
+}
+
+static struct {
+	const char *name;
+	int refresh, hor_freq_hz, pixclk_khz;
+} edid_hdmi_modes[] = {
+	{"3840x2160@30Hz 16:9", 30, 67500, 297000},
+	{"3840x2160@25Hz 16:9", 25, 56250, 297000},
+	{"3840x2160@24Hz 16:9", 24, 54000, 297000},
+	{"4096x2160@24Hz 256:135", 24, 54000, 297000},
+};
+
+static void cta_hdmi_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	struct edid_hdmi_caps *hdmi = &state->info->cta.hdmi;
+	int len_vic, i;
+	int b = 0;
+
+	hdmi->present = 1;
+	hdmi->phys_addr = (x[3] << 8) | x[4];
+	if (length >= 6)
+		hdmi->flags = x[5];
+	if (length < 7)
+		return;
+
+	hdmi->max_tmds_mhz = x[6] * 5;
+	if (x[6] * 5 > 340) {
+		state->nonconformant_hdmi_vsdb_tmds_rate = 1;
+		check_at(state, EDID_FINDING_HDMI_VSDB_TMDS_RATE, x + 6);
+	}
+
+	/* XXX the walk here is really ugly, and needs to be length-checked */
+	if (length < 8)
+		return;
+
+	if (x[7] & 0x80) {
+		b += 2;
+		if (x[7] & 0x40)
+			b += 2;
+	}
+
+	if (!(x[7] & 0x20))
+		return;
+
+	len_vic = (x[9 + b] & 0xe0) >> 5;
+	b += 2;
+
+	for (i = 0; i < len_vic; i++) {
+		unsigned char vic = x[8 + b + i];
+
+		/* the VICs of a second HDMI VSDB may not fit */
+		if (hdmi->num_vics < ARRAY_SIZE(hdmi->vics))
+			hdmi->vics[hdmi->num_vics++] = vic;
+		if (vic && vic <= ARRAY_SIZE(edid_hdmi_modes)) {
+			state->supported_hdmi_vic_codes |= 1 << (vic - 1);
+			check_at(state, EDID_FINDING_HDMI_VIC_NOT_IN_VSB, x + 8 + b + i);
+			info_span_vfreq(state->info, edid_hdmi_modes[vic - 1].refresh);
+			info_span_hfreq(state->info, edid_hdmi_modes[vic - 1].hor_freq_hz,
+					edid_hdmi_modes[vic - 1].pixclk_khz);
+		}
+	}
+}
+
+static void cta_hf_eeodb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	if (length != 1 || x[0] == 0) {
+		state->nonconformant_hf_eeodb = 1;
+		check_at(state, EDID_FINDING_HF_EEODB, x);
+	}
+}
+
+static void cta_hf_scdb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	struct edid_hf_caps *hf = &state->info->cta.hf;
+	unsigned rate = x[1] * 5;
+	unsigned max_frl_rate = x[3] >> 4;
+
+	hf->present = 1;
+	hf->version = x[0];
+	hf->max_tmds_mhz = rate;
+	hf->max_frl_rate = max_frl_rate;
+	hf->flags[0] = x[2];
+	hf->flags[1] = x[3] & 0x0f;
+	if (length > 4)
+		hf->flags[2] = x[4];
+	if (length > 6) {
+		hf->vrr_min = x[5] & 0x3f;
+		hf->vrr_max = (x[5] & 0xc0) << 2 | x[6];
+	}
+	if (length > 9) {
+		hf->dsc_flags = x[7];
+		hf->dsc_max_slices = x[8] & 0xf;
+		hf->dsc_max_frl_rate = x[8] >> 4;
+		hf->dsc_total_chunk_kbytes = x[9] & 0x3f ? 1 + (x[9] & 0x3f) : 0;
+	}
+
+	if ((rate && rate <= 340) || rate > 600 ||
+	    (max_frl_rate == 1 && rate < 300) ||
+	    (max_frl_rate >= 2 && rate < 600)) {
+		state->nonconformant_hf_vsdb_tmds_rate = 1;
+		check_at(state, EDID_FINDING_HF_VSDB_TMDS_RATE, x + 1);
+	}
+}
+
+/* 2^(n / 32), for the luminance code values of HDR static metadata */
+static const float hdr_exp2[32] = {
+	1.00000000f, 1.02189715f, 1.04427378f, 1.06714040f,
+	1.09050773f, 1.11438674f, 1.13878863f, 1.16372486f,
+	1.18920712f, 1.21524736f, 1.24185781f, 1.26905096f,
+	1.29683955f, 1.32523664f, 1.35425555f, 1.38390988f,
+	1.41421356f, 1.44518081f, 1.47682615f, 1.50916443f,
+	1.54221083f, 1.57598085f, 1.61049033f, 1.64575548f,
+	1.68179283f, 1.71861930f, 1.75625216f, 1.79470908f,
+	1.83400809f, 1.87416763f, 1.91520656f, 1.95714412f,
+};
+
+/* 50 * 2^(cv / 32) cd/m^2 */
+static float hdr_luminance(unsigned char cv)
+{
+	return 50.0f * (1u << (cv >> 5)) * hdr_exp2[cv & 0x1f];
+}
+
+/*
+ * The hdr_*_caps() functions fill the HDR capabilities from the payload
+ * of a data block, for both the full decode and edid_hdr_probe().
+ */
+static void hdr_colorimetry_caps(struct edid_hdr_caps *hdr, const unsigned char *x,
+				 unsigned int length)
+{
+	if (length < 2)
+		return;
+	hdr->has_colorimetry = 1;
+	hdr->colorimetry = x[0] | (x[1] << 8);
+}
+
+static void hdr_static_caps(struct edid_hdr_caps *hdr, const unsigned char *x,
+			    unsigned int length)
+{
+	if (length < 2)
+		return;
+	hdr->has_static = 1;
+	hdr->eotfs = x[0] & 0x3f;
+	hdr->static_metadata = x[1];
+	if (length >= 3)
+		hdr->max_luminance = hdr_luminance(x[2]);
+	if (length >= 4)
+		hdr->max_frame_avg_luminance = hdr_luminance(x[3]);
+	if (length >= 5)
+		hdr->min_luminance = hdr->max_luminance *
+				     (x[4] / 255.0f) * (x[4] / 255.0f) / 100.0f;
+}
+
+static void hdr_dyn_caps(struct edid_hdr_caps *hdr, const unsigned char *x,
+			 unsigned int length)
+{
+	while (length >= 3) {
+		unsigned type_len = x[0];
+		unsigned type = x[1] | (x[2] << 8);
+
+		if (length < type_len + 1)
+			return;
+		if (hdr->num_dynamic < EDID_HDR_MAX_DYNAMIC) {
+			hdr->dynamic[hdr->num_dynamic].type = type;
+			hdr->dynamic[hdr->num_dynamic].version =
+				(type == 1 || type == 2 || type == 4) && type_len > 2 ?
+				x[3] & 0xf : 0;
+			hdr->num_dynamic++;
+		}
+		length -= type_len + 1;
+		x += type_len + 1;
+	}
+}
+
+static void hdr_hdr10plus_caps(struct edid_hdr_caps *hdr, const unsigned char *x,
+			       unsigned int length)
+{
+	if (length < 1)
+		return;
+	hdr->has_hdr10plus = 1;
+	hdr->hdr10plus_version = x[0];
+}
+
+static void cta_hdr10plus(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	hdr_hdr10plus_caps(&state->info->cta.hdr, x, length);
+}
+
+static const char *speaker_map[] = {
+	"FL/FR - Front Left/Right",
+	"LFE1 - Low Frequency Effects 1",
+	"FC - Front Center",
+	"BL/BR - Back Left/Right",
+	"BC - Back Center",
+	"FLc/FRc - Front Left/Right of Center",
+	"RLC/RRC - Rear Left/Right of Center (Deprecated)",
+	"FLw/FRw - Front Left/Right Wide",
+	"TpFL/TpFR - Top Front Left/Right",
+	"TpC - Top Center",
+	"TpFC - Top Front Center",
+	"LS/RS - Left/Right Surround",
+	"LFE2 - Low Frequency Effects 2",
+	"TpBC - Top Back Center",
+	"SiL/SiR - Side Left/Right",
+	"TpSiL/TpSiR - Top Side Left/Right",
+	"TpBL/TpBR - Top Back Left/Right",
+	"BtFC - Bottom Front Center",
+	"BtFL/BtFR - Bottom Front Left/Right",
+	"TpLS/TpRS - Top Left/Right Surround (Deprecated for CTA-861)",
+	"LSd/RSd - Left/Right Surround Direct (HDMI only)",
+};
+
+static void cta_sadb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	if (length < 3)
+		return;
+
+	state->info->cta.speakers = (x[2] << 16) | (x[1] << 8) | x[0];
+}
+
+static void cta_vcdb(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	state->info->cta.vcdb = x[0];
+}
+
+static const char *colorimetry_map[] = {
+	"xvYCC601",
+	"xvYCC709",
+	"sYCC601",
+	"opYCC601",
+	"opRGB",
+	"BT2020cYCC",
+	"BT2020YCC",
+	"BT2020RGB",
+};
+
+static void cta_colorimetry_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	hdr_colorimetry_caps(&state->info->cta.hdr, x, length);
+	if (length >= 2)
+		state->info->cta.colorimetry = x[0] | (x[1] << 8);
+}
+
+static void cta_hdr_static_metadata_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	hdr_static_caps(&state->info->cta.hdr, x, length);
+}
+
+static void cta_hdr_dyn_metadata_block(struct edid_state *state, const unsigned char *x, unsigned int length)
+{
+	hdr_dyn_caps(&state->info->cta.hdr, x, length);
+}
+
+static void cta_block(struct edid_state *state, const unsigned char *x)
+{
+	unsigned int length = x[0] & 0x1f;
+	unsigned int oui;
+
+	info_add_cta_block(state, x);
+	switch ((x[0] & 0xe0) >> 5) {
+	case 0x01:
+		state->cur_block = "Audio Data Block";
+		cta_audio_block(state, x + 1, length);
+		break;
+	case 0x02:
+		state->cur_block = "Video Data Block";
+		cta_video_block(state, x + 1, length);
+		break;
+	case 0x03:
+		oui = (x[3] << 16) + (x[2] << 8) + x[1];
+		if (oui == EDID_OUI_HDMI) {
+			state->cur_block = "Vendor-Specific Data Block (HDMI)";
+			cta_hdmi_block(state, x + 1, length);
+			state->last_block_was_hdmi_vsdb = 1;
+			state->first_block = 0;
+			return;
+		}
+		if (oui == EDID_OUI_HDMI_FORUM) {
+			state->cur_block = "Vendor-Specific Data Block (HDMI Forum)";
+			if (!state->last_block_was_hdmi_vsdb) {
+				state->nonconformant_hf_vsdb_position = 1;
+				check_at(state, EDID_FINDING_HF_VSDB_POSITION, x);
+			}
+			if (state->have_hf_scdb || state->have_hf_vsdb) {
+				state->duplicate_scdb = 1;
+				check_at(state, EDID_FINDING_DUPLICATE_SCDB, x);
+			}
+			cta_hf_scdb(state, x + 4, length - 3);
+			state->have_hf_vsdb = 1;
+		}
+		break;
+	case 0x04:
+		state->cur_block = "Speaker Allocation Data Block";
+		cta_sadb(state, x + 1, length);
+		break;
+	case 0x07:
+		switch (x[1]) {
+		case 0x00:
+			state->cur_block = "Video Capability Data Block";
+			cta_vcdb(state, x + 2, length - 1);
+			break;
+		case 0x01:
+			oui = (x[4] << 16) + (x[3] << 8) + x[2];
+			if (oui == EDID_OUI_HDR10PLUS) {
+				state->cur_block = "Vendor-Specific Video Data Block (HDR10+)";
+				cta_hdr10plus(state, x + 5, length - 4);
+			}
+			break;
+		case 0x05:
+			state->cur_block = "Colorimetry Data Block";
+			cta_colorimetry_block(state, x + 2, length - 1);
+			break;
+		case 0x06:
+			state->cur_block = "HDR Static Metadata Data Block";
+			cta_hdr_static_metadata_block(state, x + 2, length - 1);
+			break;
+		case 0x07:
+			state->cur_block = "HDR Dynamic Metadata Data Block";
+			cta_hdr_dyn_metadata_block(state, x + 2, length - 1);
+			break;
+		case 0x0d:
+			state->cur_block = "Video Format Preference Data Block";
+			break;
+		case 0x0e:
+			state->cur_block = "YCbCr 4:2:0 Video Data Block";
+			cta_y420vdb(state, x + 2, length - 1);
+			break;
+		case 0x0f:
+			state->cur_block = "YCbCr 4:2:0 Capability Map Data Block";
+			cta_y420cmdb(state, x + 2, length - 1);
+			break;
+		case 0x12:
+			state->cur_block = "HDMI Audio Data Block";
+			break;
+		case 0x13:
+			state->cur_block = "Room Configuration Data Block";
+			break;
+		case 0x14:
+			state->cur_block = "Speaker Location Data Block";
+			break;
+		case 0x78:
+			state->cur_block = "HDMI Forum EDID Extension Override Data Block";
+			cta_hf_eeodb(state, x + 2, length - 1);
+			// This must be the first CTA block
+			if (!state->first_block) {
+				state->nonconformant_hf_eeodb = 1;
+				check_at(state, EDID_FINDING_HF_EEODB, x);
+			}
+			break;
+		case 0x79:
+			state->cur_block = "HDMI Forum Sink Capability Data Block";
+			if (!state->last_block_was_hdmi_vsdb) {
+				state->nonconformant_hf_vsdb_position = 1;
+				check_at(state, EDID_FINDING_HF_VSDB_POSITION, x);
+			}
+			if (state->have_hf_scdb || state->have_hf_vsdb) {
+				state->duplicate_scdb = 1;
+				check_at(state, EDID_FINDING_DUPLICATE_SCDB, x);
+			}
+			cta_hf_scdb(state, x + 4, length - 3);
+			state->have_hf_scdb = 1;
+			break;
+		}
+		break;
+	}
+	state->first_block = 0;
+	state->last_block_was_hdmi_vsdb = 0;
+}
+
+static int parse_cta(struct edid_state *state, const unsigned char *x)
+{
+	int ret = 0;
+	int version = x[1];
+	int offset = x[2];
+	const unsigned char *detailed;
+
+	state->cur_block = "CTA-861";
+
+	if (version >= 1) do {
+		if (version == 1 && x[3] != 0)
+			ret = 1;
+
+		if (offset < 4)
+			break;
+
+		if (version == 3) {
+			int i;
+
+			for (i = 4; i < offset; i += (x[i] & 0x1f) + 1)
+				cta_block(state, x + i);
+		}
+
+		for (detailed = x + offset; detailed + 18 < x + 127; detailed += 18)
+			if (detailed[0])
+				detailed_block(state, detailed, 1);
+	} while (0);
+
+	state->has_valid_cta_checksum = do_checksum(x, EDID_PAGE_SIZE);
+	state->cta_checksum_offset = edid_offset(state, x + EDID_PAGE_SIZE - 1);
+	state->has_cta861 = 1;
+	state->nonconformant_cta861_640x480 = !state->has_cta861_vic_1 && !state->has_640x480p60_est_timing;
+
+	return ret;
+}
+
+static void parse_displayid_detailed_timing(struct edid_state *state, const unsigned char *x)
+{
+	int hbl, hso, hspw;
+	int vbl, vso, vspw;
+	struct edid_timing *t;
+
+	/* the timing fields hold the actual value minus one */
+	t = info_add_timing(state, x, EDID_SRC_DISPLAYID);
+	if (!t)
+		return;
+
+	hbl = x[6] | (x[7] << 8);
+	hso = x[8] | ((x[9] & 0x7f) << 8);
+	hspw = x[10] | (x[11] << 8);
+	vbl = x[14] | (x[15] << 8);
+	vso = x[16] | ((x[17] & 0x7f) << 8);
+	vspw = x[18] | (x[19] << 8);
+
+	t->pixclk_khz = (x[0] + (x[1] << 8) + (x[2] << 16) + 1) * 10;
+	t->hact = (x[4] | (x[5] << 8)) + 1;
+	t->hfp = hso + 1;
+	t->hsync = hspw + 1;
+	t->hbp = hbl - hso - hspw - 1;
+	t->vact = (x[12] | (x[13] << 8)) + 1;
+	t->vfp = vso + 1;
+	t->vsync = vspw + 1;
+	t->vbp = vbl - vso - vspw - 1;
+	if (x[3] & 0x10)
+		t->flags |= EDID_TIMING_INTERLACED;
+	if (x[9] & 0x80)
+		t->flags |= EDID_TIMING_PHSYNC;
+	if (x[17] & 0x80)
+		t->flags |= EDID_TIMING_PVSYNC;
+	if (x[3] & 0x80)
+		t->flags |= EDID_TIMING_PREFERRED;
+	info_add_mode(state, t, EDID_MODE_SRC_DISPLAYID,
+		      (x[3] & 0x80) ? EDID_MODE_PREFERRED : 0);
+}
+
+static const char *displayid_block_name(unsigned tag)
+{
+	switch (tag) {
+	case 0x0: return "Product ID Block";
+	case 0x1: return "Display Parameters Block";
+	case 0x2: return "Color Characteristics Block";
+	case 0x3: return "Type 1 Detailed Timings Block";
+	case 0x4: return "Type 2 Detailed Timings Block";
+	case 0x5: return "Type 3 Short Timings Block";
+	case 0x6: return "Type 4 DMT Timings Block";
+	case 0x7: return "Type 1 VESA DMT Timings Block";
+	case 0x8: return "CTA Timings Block";
+	case 0x9: return "Video Timing Range Block";
+	case 0xa: return "Product Serial Number Block";
+	case 0xb: return "GP ASCII String Block";
+	case 0xc: return "Display Device Data Block";
+	case 0xd: return "Interface Power Sequencing Block";
+	case 0xe: return "Transfer Characteristics Block";
+	case 0xf: return "Display Interface Block";
+	case 0x10: return "Stereo Display Interface Block";
+	case 0x12: return "Tiled Display Topology Block";
+	default: return NULL;
+	}
+}
+
+static int parse_displayid(struct edid_state *state, const unsigned char *x)
+{
+	const unsigned char *orig = x;
+	int length = x[2];
+	int i;
+
+	state->cur_block = "DisplayID";
+
+	int offset = 5;
+	while (length > 0) {
+		int tag = x[offset];
+		int len = x[offset + 2];
+
+		if (len == 0)
+			break;
+		info_add_displayid_block(state, x + offset);
+		switch (tag) {
+		case 3:
+			for (i = 0; i < len / 20; i++)
+				parse_displayid_detailed_timing(state, &x[offset + 3 + (i * 20)]);
+			break;
+		case 7:
+			for (i = 0; i < min(len, 10) * 8; i++) {
+				if (x[offset + 3 + i / 8] & (1 << (i % 8)))
+					add_db_timing(state, dmt_timing(i + 1),
+						      x + offset + 3 + i / 8,
+						      EDID_MODE_SRC_DISPLAYID_DMT);
+			}
+			break;
+		case 0x12:
+			/* the bevel sizes and the pixel multiplier come together */
+			if (!(x[offset + 3] & 0x40) != !x[offset + 11])
+				warn(state, EDID_FINDING_TILE_NO_BEVEL, x + offset + 12,
+				     "No bevel information, but the pixel multiplier is non-zero\n");
+			break;
+		}
+		length -= len + 3;
+		offset += len + 3;
+	}
+
+	/* DisplayID length field is number of following bytes
+	 * but checksum is calculated over the entire structure
+	 * (excluding DisplayID-in-EDID magic byte)
+	 */
+	state->has_valid_displayid_checksum = do_checksum(orig+1, orig[2] + 5);
+	state->displayid_checksum_offset = edid_offset(state, orig + orig[2] + 5);
+	return 0;
+}
+
+/* generic extension code */
+
+static int parse_extension(struct edid_state *state, const unsigned char *x)
+{
+	struct edid_info *info = state->info;
+	int conformant_extension = 0;
+
+	info->extensions[info->num_extensions].tag = x[0];
+	info->extensions[info->num_extensions].revision = x[1];
+	if (x[0] == 0x02)
+		info->extensions[info->num_extensions].flags = x[3];
+	info->num_extensions++;
+
+	switch(x[0]) {
+	case 0x02:
+		conformant_extension = parse_cta(state, x);
+		break;
+	case 0x70:
+		conformant_extension = parse_displayid(state, x);
+		break;
+	}
+
+	return conformant_extension;
+}
+
+static void parse_base_info(struct edid_state *state, const unsigned char *edid)
+{
+	struct edid_base *base = &state->info->base;
+	int i;
+
+	base->version = edid[0x12];
+	base->revision = edid[0x13];
+	strcpy(base->manufacturer, state->manufacturer);
+	base->product = edid[0x0A] + (edid[0x0B] << 8);
+	base->serial = edid[0x0C] + (edid[0x0D] << 8) +
+		       (edid[0x0E] << 16) + ((unsigned)edid[0x0F] << 24);
+	base->week = edid[0x10];
+	base->year = edid[0x11] + 1990;
+	base->input = edid[0x14];
+	base->digital = !!(edid[0x14] & 0x80);
+	if (base->digital && edid[0x13] >= 4 && (edid[0x14] & 0x70) && (edid[0x14] & 0x70) != 0x70)
+		base->bpc = ((edid[0x14] & 0x70) >> 3) + 4;
+	base->max_hsize_cm = edid[0x15];
+	base->max_vsize_cm = edid[0x16];
+	base->gamma = edid[0x17] == 0xff ? 0 : edid[0x17] + 100;
+	base->features = edid[0x18];
+	base->chromaticity[0] = (edid[0x1b] << 2) | (edid[0x19] >> 6);
+	base->chromaticity[1] = (edid[0x1c] << 2) | ((edid[0x19] >> 4) & 3);
+	base->chromaticity[2] = (edid[0x1d] << 2) | ((edid[0x19] >> 2) & 3);
+	base->chromaticity[3] = (edid[0x1e] << 2) | (edid[0x19] & 3);
+	base->chromaticity[4] = (edid[0x1f] << 2) | (edid[0x1a] >> 6);
+	base->chromaticity[5] = (edid[0x20] << 2) | ((edid[0x1a] >> 4) & 3);
+	base->chromaticity[6] = (edid[0x21] << 2) | ((edid[0x1a] >> 2) & 3);
+	base->chromaticity[7] = (edid[0x22] << 2) | (edid[0x1a] & 3);
+	for (i = 0; i < 3; i++)
+		base->established[i] = edid[0x23 + i];
+	base->num_extensions = edid[0x7e];
+}
+
+/*
+ * Conformance checks. Each rule tests the state the decode left behind
+ * and belongs to a group, which decides how its failures are reported:
+ *
+ * - the EDID version groups print their header if any of their fatal
+ *   rules failed, followed by every failed rule;
+ * - the EDID group prints its header and failed rules only if one of its
+ *   fatal rules failed;
+ * - the extension checksum groups print their header for any failure;
+ * - the other groups have no header.
+ *
+ * A failed fatal rule makes the EDID nonconformant. Rules are listed in
+ * the order they are reported in, grouped by group.
+ */
+enum {
+	EDID_V_OTHER = 1 << 0,
+	EDID_V_1_0 = 1 << 1,	/* also 1.1 */
+	EDID_V_1_2 = 1 << 2,
+	EDID_V_1_3 = 1 << 3,
+	EDID_V_1_4 = 1 << 4,
+	EDID_V_ANY = 0x1f,
+};
+
+enum {
+	GROUP_V1_3,
+	GROUP_V1_2,
+	GROUP_V1_0,
+	GROUP_RANGES,
+	GROUP_EDID,
+	GROUP_CTA,
+	GROUP_DISPLAYID,
+	GROUP_EDID_WARNINGS,
+	GROUP_CTA_WARNINGS,
+};
+
+/* check_group.flags */
+enum {
+	GROUP_ISSUES_ON_FAIL = 1 << 0,	/* report nothing unless a fatal rule failed */
+	GROUP_HEADER_ON_ISSUE = 1 << 1,	/* print the header for any failed rule */
+};
+
+struct check_group {
+	const char *block;
+	const char *header;	/* a format, given the EDID minor version */
+	const char *prefix;
+	unsigned flags;
+};
+
+static const struct check_group check_groups[] = {
+	[GROUP_V1_3] = { "EDID", "EDID block does NOT conform to EDID 1.%d!\n", "\t" },
+	[GROUP_V1_2] = { "EDID", "EDID block does NOT conform to EDID 1.2!\n", "\t" },
+	[GROUP_V1_0] = { "EDID", "EDID block does NOT conform to EDID 1.0!\n", "\t" },
+	[GROUP_RANGES] = { "EDID", NULL, "" },
+	[GROUP_EDID] = { "EDID", "EDID block does not conform:\n", "\t", GROUP_ISSUES_ON_FAIL },
+	[GROUP_CTA] = { "CTA-861", "CTA extension block does not conform\n", "\t", GROUP_HEADER_ON_ISSUE },
+	[GROUP_DISPLAYID] = { "DisplayID", "DisplayID extension block does not conform\n", "\t", GROUP_HEADER_ON_ISSUE },
+	[GROUP_EDID_WARNINGS] = { "EDID", NULL, "" },
+	[GROUP_CTA_WARNINGS] = { "CTA-861", NULL, "" },
+};
+
+/* check_rule.flags */
+enum {
+	RULE_NOT_FATAL = 1 << 0,	/* an error that does not fail the EDID */
+	RULE_WARNING = 1 << 1,		/* a warning, never fatal */
+};
+
+struct check_rule {
+	uint8_t group;
+	uint8_t versions;	/* EDID_V_* the rule applies to */
+	uint8_t flags;
+	uint16_t code;		/* enum edid_finding_code */
+	/*
+	 * nonzero if the rule failed; the value is passed to message. The
+	 * offset of the finding is state->check_offset[code] unless the test
+	 * sets it.
+	 */
+	int (*test)(const struct edid_state *state, int *offset);
+	const char *message;
+	/* print details after the message in the text report */
+	void (*details)(struct text_out *out);
+};
+
+/* Whether the timings span more than the monitor range limits */
+static int timings_out_of_range(const struct edid_info *info)
+{
+	const struct edid_range_limits *range = &info->base.range_limits;
+
+	return info->min_vfreq_hz < range->min_vfreq_hz ||
+	       info->max_vfreq_hz > range->max_vfreq_hz ||
+	       info->min_hfreq_hz < range->min_hfreq_khz * 1000 ||
+	       info->max_hfreq_hz > range->max_hfreq_khz * 1000 ||
+	       info->max_pixclk_khz > range->max_pixclk_mhz * 1000;
+}
+
+#define DEFINE_TEST(name, expr)						\
+static int test_##name(const struct edid_state *state, int *offset)	\
+{									\
+	return expr;							\
+}
+
+/* a test of a byte at a known place */
+#define DEFINE_TEST_AT(name, expr, at)					\
+static int test_##name(const struct edid_state *state, int *offset)	\
+{									\
+	*offset = at;							\
+	return expr;							\
+}
+
+DEFINE_TEST_AT(srgb_chromaticity, state->nonconformant_srgb_chromaticity, 0x19)
+DEFINE_TEST_AT(digital_display, state->nonconformant_digital_display, 0x14)
+DEFINE_TEST(cta861_640x480, state->nonconformant_cta861_640x480)
+DEFINE_TEST(hf_vsdb_position, state->nonconformant_hf_vsdb_position)
+DEFINE_TEST(duplicate_scdb, state->duplicate_scdb)
+DEFINE_TEST(hdmi_vsdb_tmds_rate, state->nonconformant_hdmi_vsdb_tmds_rate)
+DEFINE_TEST(hf_vsdb_tmds_rate, state->nonconformant_hf_vsdb_tmds_rate)
+DEFINE_TEST(hf_eeodb, state->nonconformant_hf_eeodb)
+DEFINE_TEST(missing_name, !state->has_name_descriptor)
+DEFINE_TEST_AT(missing_preferred_timing, !state->has_preferred_timing, 0x18)
+DEFINE_TEST(missing_ranges, !state->has_range_descriptor)
+DEFINE_TEST(descriptor_pad, !state->has_valid_descriptor_pad)
+DEFINE_TEST(string_termination, !state->has_valid_string_termination)
+DEFINE_TEST(non_detailed_descriptor, state->seen_non_detailed_descriptor)
+DEFINE_TEST(out_of_range, state->has_range_descriptor &&
+	    state->has_valid_range_descriptor &&
+	    timings_out_of_range(state->info))
+DEFINE_TEST(nonconformant_extension, state->nonconformant_extension)
+DEFINE_TEST_AT(checksum, !state->has_valid_checksum, 0x7f)
+DEFINE_TEST(cvt, !state->has_valid_cvt)
+DEFINE_TEST_AT(bad_year, !state->has_valid_year, 0x11)
+DEFINE_TEST_AT(bad_week, !state->has_valid_week, 0x10)
+DEFINE_TEST_AT(serial_number_and_string, state->has_cta861 &&
+	       state->has_valid_serial_number && state->has_valid_serial_string,
+	       0x0c)
+DEFINE_TEST(detailed_block_garbage, !state->has_valid_detailed_blocks)
+DEFINE_TEST(dummy_block_garbage, !state->has_valid_dummy_block)
+DEFINE_TEST_AT(manufacturer_name, !state->manufacturer_name_well_formed, 0x08)
+DEFINE_TEST(descriptor_ordering, !state->has_valid_descriptor_ordering)
+DEFINE_TEST(range_descriptor_garbage, !state->has_valid_range_descriptor)
+DEFINE_TEST(missing_max_dotclock, !state->has_valid_max_dotclock)
+DEFINE_TEST(invalid_name, state->has_name_descriptor && !state->has_valid_name_descriptor)
+DEFINE_TEST(invalid_ascii_string, state->has_ascii_string && !state->has_valid_ascii_string)
+DEFINE_TEST(invalid_serial_string, state->has_serial_string && !state->has_valid_serial_string)
+DEFINE_TEST(trailing_spaces, state->trailing_space)
+DEFINE_TEST(empty_strings, state->empty_string)
+DEFINE_TEST_AT(cta_checksum, !state->has_valid_cta_checksum,
+	       state->cta_checksum_offset)
+DEFINE_TEST_AT(displayid_checksum, !state->has_valid_displayid_checksum,
+	       state->displayid_checksum_offset)
+DEFINE_TEST(cvt_dotclock_correction, state->warning_excessive_dotclock_correction)
+DEFINE_TEST(cvt_no_preferred_refresh, state->warning_zero_preferred_refresh)
+DEFINE_TEST(hdmi_vic_not_in_vsb, (state->supported_hdmi_vic_vsb_codes &
+				  state->supported_hdmi_vic_codes) !=
+				 state->supported_hdmi_vic_codes)
+
+static void out_of_range_details(struct text_out *out)
+{
+	const struct edid_info *info = out->info;
+	const struct edid_range_limits *range = &info->base.range_limits;
+
+	out_printf(out, "  Vertical Freq: %u - %u Hz (Monitor: %u - %u Hz)\n",
+		   info->min_vfreq_hz, info->max_vfreq_hz,
+		   range->min_vfreq_hz, range->max_vfreq_hz);
+	out_printf(out, "  Horizontal Freq: %u - %u Hz (Monitor: %u - %u Hz)\n",
+		   info->min_hfreq_hz, info->max_hfreq_hz,
+		   range->min_hfreq_khz * 1000, range->max_hfreq_khz * 1000);
+	out_printf(out, "  Maximum Clock: %.3f MHz (Monitor: %.3f MHz)\n",
+		   info->max_pixclk_khz / 1000.0, range->max_pixclk_mhz * 1.0);
+}
+
+#define RULE(g, v, f, c, t, m) \
+	{ GROUP_##g, v, f, EDID_FINDING_##c, test_##t, m }
+
+#define EDID_V_1_3_UP (EDID_V_1_3 | EDID_V_1_4)
+
+static const struct check_rule check_rules[] = {
+	RULE(V1_3, EDID_V_1_3_UP, 0, SRGB_CHROMATICITY, srgb_chromaticity,
+	     "sRGB is signaled, but the chromaticities do not match\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, DIGITAL_DISPLAY_GARBAGE, digital_display,
+	     "Digital display field contains garbage: %x\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, MISSING_640X480P60, cta861_640x480,
+	     "Required 640x480p60 timings are missing in the established timings\n"
+	     "\tand/or in the SVD list (VIC 1)\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, HF_VSDB_POSITION, hf_vsdb_position,
+	     "HDMI Forum VSDB or SCDB did not immediately follow the HDMI VSDB\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, DUPLICATE_SCDB, duplicate_scdb,
+	     "Duplicate HDMI Forum VSDB/SCDB\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, HDMI_VSDB_TMDS_RATE, hdmi_vsdb_tmds_rate,
+	     "HDMI VSDB Max TMDS rate is > 340\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, HF_VSDB_TMDS_RATE, hf_vsdb_tmds_rate,
+	     "HDMI Forum VSDB Max TMDS rate is > 0 and <= 340 or > 600\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, HF_EEODB, hf_eeodb,
+	     "HDMI Forum EDID Extension Override Data Block starts at a wrong offset or is too long or reports a 0 block count\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, MISSING_NAME, missing_name,
+	     "Missing name descriptor\n"),
+	RULE(V1_3, EDID_V_1_3_UP, 0, MISSING_PREFERRED_TIMING, missing_preferred_timing,
+	     "Missing preferred timing\n"),
+	/* EDID 1.4 made the range descriptor optional */
+	RULE(V1_3, EDID_V_1_3, 0, MISSING_RANGES, missing_ranges,
+	     "Missing monitor ranges\n"),
+	RULE(V1_3, EDID_V_1_4, RULE_NOT_FATAL, MISSING_RANGES, missing_ranges,
+	     "Missing monitor ranges\n"),
+	/* Might be more than just 1.3 */
+	RULE(V1_3, EDID_V_1_3_UP, 0, DESCRIPTOR_PAD, descriptor_pad,
+	     "Invalid descriptor block padding\n"),
+	/* Likewise */
+	RULE(V1_3, EDID_V_1_3_UP, 0, STRING_TERMINATION, string_termination,
+	     "Detailed block string not properly terminated\n"),
+
+	RULE(V1_2, EDID_V_1_2, 0, DIGITAL_DISPLAY_GARBAGE, digital_display,
+	     "Digital display field contains garbage: %x\n"),
+
+	RULE(V1_0, EDID_V_1_0, 0, NON_DETAILED_DESCRIPTOR, non_detailed_descriptor,
+	     "Has descriptor blocks other than detailed timings\n"),
+
+	/*
+	 * EDID 1.4 states (in an Errata) that explicitly defined
+	 * timings supersede the monitor range definition.
+	 */
+	{ GROUP_RANGES, EDID_V_ANY & ~EDID_V_1_4, 0, EDID_FINDING_OUT_OF_RANGE,
+	  test_out_of_range,
+	  "One or more of the timings is out of range of the Monitor Ranges:\n",
+	  out_of_range_details },
+	{ GROUP_RANGES, EDID_V_1_4, RULE_WARNING, EDID_FINDING_OUT_OF_RANGE,
+	  test_out_of_range,
+	  "One or more of the timings is out of range of the Monitor Ranges:\n",
+	  out_of_range_details },
+
+	RULE(EDID, EDID_V_ANY, 0, NONCONFORMANT_EXTENSION, nonconformant_extension,
+	     "Has %d nonconformant extension block(s)\n"),
+	RULE(EDID, EDID_V_ANY, 0, CHECKSUM, checksum,
+	     "Block has broken checksum\n"),
+	RULE(EDID, EDID_V_ANY, 0, CVT, cvt,
+	     "Broken 3-byte CVT blocks\n"),
+	RULE(EDID, EDID_V_ANY, 0, BAD_YEAR, bad_year,
+	     "Bad year of manufacture\n"),
+	RULE(EDID, EDID_V_ANY, 0, BAD_WEEK, bad_week,
+	     "Bad week of manufacture\n"),
+	RULE(EDID, EDID_V_ANY, 0, SERIAL_NUMBER_AND_STRING, serial_number_and_string,
+	     "Both the serial number and the serial string are set\n"),
+	RULE(EDID, EDID_V_ANY, 0, DETAILED_BLOCK_GARBAGE, detailed_block_garbage,
+	     "Detailed blocks filled with garbage\n"),
+	RULE(EDID, EDID_V_ANY, 0, DUMMY_BLOCK_GARBAGE, dummy_block_garbage,
+	     "Dummy block filled with garbage\n"),
+	RULE(EDID, EDID_V_ANY, 0, MANUFACTURER_NAME, manufacturer_name,
+	     "Manufacturer name field contains garbage\n"),
+	RULE(EDID, EDID_V_ANY, 0, DESCRIPTOR_ORDERING, descriptor_ordering,
+	     "Invalid detailed timing descriptor ordering\n"),
+	RULE(EDID, EDID_V_ANY, 0, RANGE_DESCRIPTOR_GARBAGE, range_descriptor_garbage,
+	     "Range descriptor contains garbage\n"),
+	RULE(EDID, EDID_V_ANY, RULE_NOT_FATAL, MISSING_MAX_DOTCLOCK, missing_max_dotclock,
+	     "EDID 1.4 block does not set max dotclock\n"),
+	RULE(EDID, EDID_V_ANY, 0, INVALID_NAME, invalid_name,
+	     "Invalid Monitor Name descriptor\n"),
+	RULE(EDID, EDID_V_ANY, 0, INVALID_ASCII_STRING, invalid_ascii_string,
+	     "Invalid ASCII string\n"),
+	RULE(EDID, EDID_V_ANY, 0, INVALID_SERIAL_STRING, invalid_serial_string,
+	     "Invalid serial string\n"),
+	RULE(EDID, EDID_V_ANY, 0, TRAILING_SPACES, trailing_spaces,
+	     "String contains one or more trailing spaces\n"),
+	RULE(EDID, EDID_V_ANY, 0, EMPTY_STRINGS, empty_strings,
+	     "String is empty\n"),
+
+	/* extension checksums are reported, but do not fail the EDID */
+	RULE(CTA, EDID_V_ANY, RULE_NOT_FATAL, CHECKSUM, cta_checksum,
+	     "Block has broken checksum\n"),
+	RULE(DISPLAYID, EDID_V_ANY, RULE_NOT_FATAL, CHECKSUM, displayid_checksum,
+	     "Block has broken checksum\n"),
+
+	RULE(EDID_WARNINGS, EDID_V_ANY, RULE_WARNING, CVT_DOTCLOCK_CORRECTION, cvt_dotclock_correction,
+	     "CVT block corrects dotclock by more than 9.75MHz\n"),
+	RULE(EDID_WARNINGS, EDID_V_ANY, RULE_WARNING, CVT_NO_PREFERRED_REFRESH, cvt_no_preferred_refresh,
+	     "CVT block does not set preferred refresh rate\n"),
+	RULE(CTA_WARNINGS, EDID_V_ANY, RULE_WARNING, HDMI_VIC_NOT_IN_VSB, hdmi_vic_not_in_vsb,
+	     "HDMI VIC Codes must have their CTA-861 VIC equivalents in the VSB\n"),
+};
+
+/* The EDID_V_* class of the EDID version the base block claims */
+static unsigned edid_version_class(const struct edid_base *base)
+{
+	if (base->version != 1)
+		return EDID_V_OTHER;
+	switch (base->revision) {
+	case 0:
+	case 1:
+		return EDID_V_1_0;
+	case 2:
+		return EDID_V_1_2;
+	case 3:
+		return EDID_V_1_3;
+	default:
+		return EDID_V_1_4;
+	}
+}
+
+static int rule_selected(const struct edid_state *state, unsigned code)
+{
+	unsigned i;
+
+	if (!state->check_codes)
+		return 1;
+	for (i = 0; i < state->num_check_codes; i++)
+		if (state->check_codes[i] == code)
+			return 1;
+	return 0;
+}
+
+/*
+ * Evaluate the rules in a single pass over the table. With
+ * EDID_DECODE_CHECK_FIRST, stop after the first fatal failure.
+ */
+static void run_checks(struct edid_state *state)
+{
+	unsigned version = edid_version_class(&state->info->base);
+	unsigned i = 0;
+
+	while (i < ARRAY_SIZE(check_rules)) {
+		unsigned g = check_rules[i].group;
+		const struct check_group *group = &check_groups[g];
+		const struct check_rule *failed[32];
+		int values[32], offsets[32];
+		unsigned num_failed = 0, j;
+		int fatal = 0;
+
+		for (; i < ARRAY_SIZE(check_rules) && check_rules[i].group == g; i++) {
+			const struct check_rule *rule = &check_rules[i];
+			int offset = state->check_offset[rule->code];
+			int v;
+
+			if (fatal && (state->flags & EDID_DECODE_CHECK_FIRST))
+				continue;
+			if (!(rule->versions & version) ||
+			    !rule_selected(state, rule->code))
+				continue;
+			v = rule->test(state, &offset);
+			if (!v)
+				continue;
+			failed[num_failed] = rule;
+			offsets[num_failed] = offset;
+			values[num_failed++] = v;
+			if (!(rule->flags & (RULE_NOT_FATAL | RULE_WARNING)))
+				fatal = 1;
+		}
+		if (!num_failed || (!fatal && (group->flags & GROUP_ISSUES_ON_FAIL)))
+			continue;
+
+		state->cur_block = group->block;
+		if (fatal)
+			state->conformant = 0;
+		for (j = 0; j < num_failed; j++)
+			check_issue(state, failed[j]->code,
+				    failed[j]->flags & RULE_WARNING ?
+				    EDID_SEV_WARNING : EDID_SEV_ERROR,
+				    offsets[j], failed[j]->message, values[j]);
+		if (fatal && (state->flags & EDID_DECODE_CHECK_FIRST))
+			break;
+	}
+}
+
+static int parse_edid(struct edid_state *state, const unsigned char *edid)
+{
+	const unsigned char *x;
+	time_t the_time;
+	struct tm tm;
+	int i;
+
+	state->cur_block = "EDID Structure Version & Revision";
+	if (edid[0x12] == 1) {
+		state->edid_minor = min(edid[0x13], 4);
+		switch (state->edid_minor) {
+		case 4:
+			state->claims_one_point_four = 1;
+		case 3:
+			state->claims_one_point_three = 1;
+		case 2:
+			state->claims_one_point_two = 1;
+		default:
+			break;
+		}
+		state->claims_one_point_oh = 1;
+	}
+
+	state->cur_block = "Vendor & Product Identification";
+	manufacturer_name(state, edid + 0x08);
+	state->has_valid_serial_number = edid[0x0C] || edid[0x0D] || edid[0x0E] || edid[0x0F];
+	/* XXX need manufacturer ID table */
+	parse_base_info(state, edid);
+
+	time(&the_time);
+	localtime_r(&the_time, &tm);
+	if (edid[0x10] < 55 || (edid[0x10] == 0xff && state->claims_one_point_four)) {
+		state->has_valid_week = 1;
+		if (edid[0x11] > 0x0f &&
+		    (edid[0x10] == 0xff || edid[0x11] + 90 <= tm.tm_year + 1))
+			state->has_valid_year = 1;
+	}
+	state->info->base.valid_year = state->has_valid_year;
+	if (!state->has_valid_year)
+		warn(state, EDID_FINDING_INVALID_YEAR, edid + 0x11, "Invalid year\n");
+
+	/* display section */
+
+	state->cur_block = "Basic Display Parameters & Features";
+	if (edid[0x14] & 0x80) {
+		int conformance_mask;
+
+		if (state->claims_one_point_four) {
+			conformance_mask = 0;
+			if ((edid[0x14] & 0x70) == 0x70 || (edid[0x14] & 0x0f) > 0x05)
+				state->nonconformant_digital_display = 1;
+		} else if (state->claims_one_point_two) {
+			conformance_mask = 0x7E;
+		} else conformance_mask = 0x7F;
+		if (!state->nonconformant_digital_display)
+			state->nonconformant_digital_display = edid[0x14] & conformance_mask;
+	}
+
+	if (edid[0x18] & 0x04) {
+		/*
+		 * The sRGB chromaticities are (x, y):
+		 * red:   0.640,  0.330
+		 * green: 0.300,  0.600
+		 * blue:  0.150,  0.060
+		 * white: 0.3127, 0.3290
+		 */
+		static const unsigned char srgb_chromaticity[10] = {
+			0xee, 0x91, 0xa3, 0x54, 0x4c, 0x99, 0x26, 0x0f, 0x50, 0x54
+		};
+		state->nonconformant_srgb_chromaticity =
+			memcmp(edid + 0x19, srgb_chromaticity, sizeof(srgb_chromaticity));
+	}
+	/* 1.4 always has a preferred timing and this bit means something else. */
+	if ((edid[0x18] & 0x02) || state->claims_one_point_four)
+		state->has_preferred_timing = 1;
+
+	state->cur_block = "Established Timings";
+	for (i = 0; i < 17; i++) {
+		if (edid[0x23 + i / 8] & (1 << (7 - i % 8)))
+			add_db_timing(state, &timing_db[established_timings[i]],
+				      edid + 0x23 + i / 8, EDID_MODE_SRC_ESTABLISHED);
+	}
+	state->has_640x480p60_est_timing = edid[0x23] & 0x20;
+
+	state->cur_block = "Standard Timings";
+	for (i = 0; i < 8; i++)
+		standard_timing(state, edid + 0x26 + i * 2);
+
+	/* detailed timings */
+	state->cur_block = "Detailed Timings";
+	state->has_valid_detailed_blocks = 1;
+	for (i = 0; i < 4; i++) {
+		x = edid + 0x36 + i * 18;
+		if (!detailed_block(state, x, 0)) {
+			state->has_valid_detailed_blocks = 0;
+			check_at(state, EDID_FINDING_DETAILED_BLOCK_GARBAGE, x);
+		}
+		if (!i && state->has_preferred_timing && !state->did_detailed_timing)
+			state->has_preferred_timing = 0; /* not really accurate... */
+	}
+
+	state->has_valid_checksum = do_checksum(edid, EDID_PAGE_SIZE);
+
+	x = edid;
+	for (i = 1; i < state->num_blocks; i++) {
+		x += EDID_PAGE_SIZE;
+		if (parse_extension(state, x)) {
+			state->nonconformant_extension++;
+			check_at(state, EDID_FINDING_NONCONFORMANT_EXTENSION, x);
+		}
+	}
+	info_apply_y420cmdb(state);
+	info_sort_modes(state);
+
+	if (!(state->flags & EDID_DECODE_CHECK))
+		return 0;
+
+	run_checks(state);
+	state->info->conformant = state->conformant;
+	return state->conformant ? 0 : -2;
+}
+
+static int edid_decode_all(const uint8_t *buf, size_t len,
+			   struct edid_info *info, unsigned flags,
+			   const uint16_t *codes, unsigned num_codes)
+{
+	struct edid_state state;
+	int ret;
+
+	edid_state_init(&state, info, flags);
+	state.check_codes = codes;
+	state.num_check_codes = num_codes;
+	if (len < EDID_PAGE_SIZE)
+		return -1;
+	/* an EDID has at most 255 extension blocks */
+	state.num_blocks = min(len / EDID_PAGE_SIZE, 256);
+	state.edid = buf;
+	info->buf = buf;
+	info->flags = flags;
+
+	if (memcmp(buf, "\x00\xFF\xFF\xFF\xFF\xFF\xFF\x00", 8)) {
+		ret = -1;
+	} else {
+		info->size = state.num_blocks * EDID_PAGE_SIZE;
+		info->num_blocks = state.num_blocks;
+		ret = parse_edid(&state, buf);
+		info_add_findings(&state);
+	}
+	edid_state_free(&state);
+	return ret;
+}
+
+/* Decode, then write the text report of the result to out if it is set */
+static int edid_decode_out(const uint8_t *buf, size_t len,
+			   struct edid_info *info, unsigned flags, FILE *out,
+			   const uint16_t *codes, unsigned num_codes)
+{
+	struct edid_info scratch;
+	int ret;
+
+	if (!info)
+		info = &scratch;
+	/* the text report needs the messages of the findings */
+	if (out)
+		flags &= ~EDID_DECODE_QUIET;
+	ret = edid_decode_all(buf, len, info, flags, codes, num_codes);
+	if (out)
+		edid_emit(out, info, EDID_OUTPUT_TEXT, NULL);
+	return ret;
+}
+
+int edid_decode_text(const uint8_t *buf, size_t len, struct edid_info *info,
+		     unsigned flags, FILE *out)
+{
+	return edid_decode_out(buf, len, info, flags, out, NULL, 0);
+}
+
+int edid_check(const uint8_t *buf, size_t len, struct edid_info *info,
+	       unsigned flags, FILE *out, const uint16_t *codes,
+	       unsigned num_codes)
+{
+	return edid_decode_out(buf, len, info, flags | EDID_DECODE_CHECK, out,
+			       codes, num_codes);
+}
+
+int edid_decode(const uint8_t *buf, size_t len, struct edid_info *info)
+{
+	return edid_decode_text(buf, len, info, 0, NULL);
+}
+
+/* Copy a descriptor string up to its terminating newline */
+static void summary_string(char *dst, const unsigned char *x)
+{
+	unsigned i;
+
+	for (i = 0; i < 13 && x[i] != 0x0a && (isgraph(x[i]) || x[i] == ' '); i++)
+		dst[i] = x[i];
+	dst[i] = '\0';
+}
+
+int edid_summary(const uint8_t *buf, size_t len, struct edid_summary *sum)
+{
+	const uint8_t *x;
+	unsigned i;
+
+	memset(sum, 0, sizeof(*sum));
+	if (len < EDID_PAGE_SIZE ||
+	    memcmp(buf, "\x00\xFF\xFF\xFF\xFF\xFF\xFF\x00", 8))
+		return -1;
+
+	decode_manufacturer(sum->manufacturer, buf + 0x08);
+	sum->product = buf[0x0a] + (buf[0x0b] << 8);
+	sum->serial = buf[0x0c] + (buf[0x0d] << 8) +
+		      (buf[0x0e] << 16) + ((unsigned)buf[0x0f] << 24);
+	sum->week = buf[0x10];
+	sum->year = buf[0x11] + 1990;
+
+	for (i = 0, x = buf + 0x36; i < 4; i++, x += 18) {
+		if (x[0] || x[1]) {
+			if (sum->preferred.pixclk_khz)
+				continue;
+			dtd_to_timing(&sum->preferred, x);
+			sum->preferred.source = EDID_SRC_BASE;
+			sum->preferred.offset = x - buf;
+			/* in EDID 1.4 the first detailed timing is always preferred */
+			if (!i && ((buf[0x18] & 0x02) ||
+				   (buf[0x12] == 1 && buf[0x13] >= 4)))
+				sum->preferred.flags |= EDID_TIMING_PREFERRED;
+		} else if (x[3] == 0xfc) {
+			summary_string(sum->name, x + 5);
+		} else if (x[3] == 0xff) {
+			summary_string(sum->serial_string, x + 5);
+		}
+	}
+
+	/* without one in the base block, take the first DTD of a CTA block */
+	x = buf + EDID_PAGE_SIZE;
+	if (!sum->preferred.pixclk_khz && buf[0x7e] &&
+	    len >= 2 * EDID_PAGE_SIZE && x[0] == 0x02 && x[2] >= 4) {
+		const uint8_t *d = x + x[2];
+
+		if (d + 18 <= x + 127 && (d[0] || d[1])) {
+			dtd_to_timing(&sum->preferred, d);
+			sum->preferred.source = EDID_SRC_CTA;
+			sum->preferred.block = 1;
+			sum->preferred.offset = d - buf;
+		}
+	}
+	return 0;
+}
+
+/*
+ * End of the data block collection of the extension block at x, or 0 if
+ * it is not a CTA-861 block with one: only revision 3 and up has them
+ */
+static unsigned cta_collection_end(const uint8_t *x)
+{
+	if (x[0] != 0x02 || x[1] < 3 || x[2] < 4 || x[2] > 127)
+		return 0;
+	return x[2];
+}
+
+int edid_cta_index(const uint8_t *buf, size_t len, struct edid_cta_index *idx)
+{
+	unsigned num_blocks;
+	unsigned b;
+
+	idx->buf = buf;
+	idx->num_blocks = 0;
+	idx->truncated = 0;
+	if (len < EDID_PAGE_SIZE ||
+	    memcmp(buf, "\x00\xFF\xFF\xFF\xFF\xFF\xFF\x00", 8))
+		return -1;
+	num_blocks = min(len / EDID_PAGE_SIZE, 256);
+
+	for (b = 1; b < num_blocks; b++) {
+		const uint8_t *x = buf + b * EDID_PAGE_SIZE;
+		unsigned i, end = cta_collection_end(x);
+
+		for (i = 4; i < end; i += (x[i] & 0x1f) + 1) {
+			if (i + (x[i] & 0x1f) >= end)
+				break;
+			if (idx->num_blocks == EDID_INFO_MAX_CTA_BLOCKS) {
+				idx->truncated = 1;
+				return 0;
+			}
+			cta_index_block(&idx->blocks[idx->num_blocks++], buf,
+					x + i - buf);
+		}
+	}
+	return 0;
+}
+
+const struct edid_cta_block *
+edid_cta_find(const struct edid_cta_block *blocks, unsigned num_blocks,
+	      unsigned tag, unsigned ext_tag, uint32_t oui)
+{
+	unsigned i;
+
+	for (i = 0; i < num_blocks; i++) {
+		const struct edid_cta_block *b = &blocks[i];
+
+		if (b->tag == tag &&
+		    (tag != EDID_CTA_TAG_EXTENDED || b->ext_tag == ext_tag) &&
+		    (!oui || b->oui == oui))
+			return b;
+	}
+	return NULL;
+}
+
+const struct edid_cta_block *
+edid_cta_find_hdr_static(const struct edid_cta_index *idx)
+{
+	return edid_cta_find(idx->blocks, idx->num_blocks,
+			     EDID_CTA_TAG_EXTENDED, EDID_CTA_EXT_HDR_STATIC, 0);
+}
+
+const struct edid_cta_block *
+edid_cta_find_hf_scdb(const struct edid_cta_index *idx)
+{
+	const struct edid_cta_block *b;
+
+	b = edid_cta_find(idx->blocks, idx->num_blocks,
+			  EDID_CTA_TAG_EXTENDED, EDID_CTA_EXT_HF_SCDB, 0);
+	if (!b)
+		b = edid_cta_find(idx->blocks, idx->num_blocks,
+				  EDID_CTA_TAG_VENDOR, 0, EDID_OUI_HDMI_FORUM);
+	return b;
+}
+
+int edid_hdr_probe(const uint8_t *buf, size_t len, struct edid_hdr_caps *caps)
+{
+	unsigned num_blocks;
+	unsigned b;
+
+	memset(caps, 0, sizeof(*caps));
+	if (len < EDID_PAGE_SIZE ||
+	    memcmp(buf, "\x00\xFF\xFF\xFF\xFF\xFF\xFF\x00", 8))
+		return -1;
+	num_blocks = min(len / EDID_PAGE_SIZE, 256);
+
+	for (b = 1; b < num_blocks; b++) {
+		const uint8_t *x = buf + b * EDID_PAGE_SIZE;
+		unsigned i, end = cta_collection_end(x);
+
+		for (i = 4; i < end; i += (x[i] & 0x1f) + 1) {
+			const uint8_t *p = x + i + 1;
+			unsigned length = x[i] & 0x1f;
+
+			if (i + length >= end)
+				break;
+			if (x[i] >> 5 != EDID_CTA_TAG_EXTENDED || !length)
+				continue;
+			switch (p[0]) {
+			case EDID_CTA_EXT_VENDOR_VIDEO:
+				if (length >= 5 &&
+				    (p[3] << 16) + (p[2] << 8) + p[1] == EDID_OUI_HDR10PLUS)
+					hdr_hdr10plus_caps(caps, p + 4, length - 4);
+				break;
+			case EDID_CTA_EXT_COLORIMETRY:
+				hdr_colorimetry_caps(caps, p + 1, length - 1);
+				break;
+			case EDID_CTA_EXT_HDR_STATIC:
+				hdr_static_caps(caps, p + 1, length - 1);
+				break;
+			case EDID_CTA_EXT_HDR_DYNAMIC:
+				hdr_dyn_caps(caps, p + 1, length - 1);
+				break;
+			}
+		}
+	}
+	return 0;
+}
+
+/* the lines of the frame; DisplayID gives these, the others a field */
+static unsigned frame_height(const struct edid_timing *t)
+{
+	if ((t->flags & EDID_TIMING_INTERLACED) && t->source != EDID_SRC_DISPLAYID)
+		return t->vact * 2;
+	return t->vact;
+}
+
+static uint64_t mode_index_key(unsigned width, unsigned height,
+			       unsigned refresh, unsigned interlaced)
+{
+	return ((uint64_t)width << 32) | (height << 16) | (refresh << 1) | interlaced;
+}
+
+static unsigned mode_index_slot(uint64_t key)
+{
+	key *= 0x9e3779b97f4a7c15ULL;
+	return (key >> 32) & (2 * EDID_INFO_MAX_MODES - 1);
+}
+
+int edid_mode_index(const struct edid_info *info, struct edid_mode_index *idx)
+{
+	const struct edid_range_limits *range = &info->base.range_limits;
+	unsigned i;
+
+	memset(idx, 0, sizeof(*idx));
+	idx->info = info;
+	if (!info->size)
+		return -1;
+
+	for (i = 0; i < info->num_modes; i++) {
+		const struct edid_timing *t = &info->modes[i].timing;
+		uint64_t key = mode_index_key(t->hact, frame_height(t),
+					      (info->modes[i].refresh_mhz + 500) / 1000,
+					      !!(t->flags & EDID_TIMING_INTERLACED));
+		unsigned s;
+
+		for (s = mode_index_slot(key); idx->slots[s];
+		     s = (s + 1) & (ARRAY_SIZE(idx->slots) - 1))
+			;
+		idx->keys[s] = key;
+		idx->slots[s] = i + 1;
+	}
+
+	/* feature bit 0: continuous frequencies, or GTF before EDID 1.4 */
+	if (!info->base.has_range_limits || !(info->base.features & 0x01))
+		return 0;
+	switch (range->type) {
+	case 0x00: /* default GTF */
+	case 0x02: /* secondary GTF curve */
+		idx->formulas[idx->num_formulas++] = EDID_FORMULA_GTF;
+		break;
+	case 0x04: /* CVT */
+		if (range->cvt_blanking & 0x08)
+			idx->formulas[idx->num_formulas++] = EDID_FORMULA_CVT;
+		if (range->cvt_blanking & 0x10)
+			idx->formulas[idx->num_formulas++] = EDID_FORMULA_CVT_RB;
+		break;
+	case 0x01: /* range limits only: any timing within them */
+		idx->formulas[idx->num_formulas++] = EDID_FORMULA_CVT;
+		idx->formulas[idx->num_formulas++] = EDID_FORMULA_CVT_RB;
+		break;
+	}
+	idx->min_vfreq_hz = range->min_vfreq_hz;
+	idx->max_vfreq_hz = range->max_vfreq_hz;
+	idx->min_hfreq_hz = range->min_hfreq_khz * 1000;
+	idx->max_hfreq_hz = range->max_hfreq_khz * 1000;
+	if (range->max_pixclk_mhz)
+		idx->max_pixclk_khz = range->max_pixclk_mhz * 1000 -
+				      range->pixclk_adjust_khz;
+	idx->max_hact = range->max_hact;
+	return 0;
+}
+
+int edid_supports(const struct edid_mode_index *idx, unsigned width,
+		  unsigned height, unsigned refresh, unsigned flags,
+		  struct edid_timing *t)
+{
+	uint64_t key = mode_index_key(width, height, refresh,
+				      !!(flags & EDID_SUPPORTS_INTERLACED));
+	unsigned s, i;
+
+	if (width > 0xffff || height > 0xffff || refresh > 0x7fff)
+		return EDID_SUPPORTS_NONE;
+	for (s = mode_index_slot(key); idx->slots[s];
+	     s = (s + 1) & (ARRAY_SIZE(idx->slots) - 1)) {
+		const struct edid_mode *m = &idx->info->modes[idx->slots[s] - 1];
+
+		if (idx->keys[s] != key)
+			continue;
+		if ((flags & EDID_SUPPORTS_YCBCR420) ?
+		    !(m->flags & EDID_MODE_YCBCR420) :
+		    (m->flags & EDID_MODE_YCBCR420_ONLY))
+			continue;
+		if (t)
+			*t = m->timing;
+		return EDID_SUPPORTS_MODE;
+	}
+
+	if (flags)
+		return EDID_SUPPORTS_NONE;
+	for (i = 0; i < idx->num_formulas; i++) {
+		struct edid_timing ct;
+		unsigned hfreq;
+
+		if (edid_calc_timing(width, height, refresh, idx->formulas[i], &ct))
+			continue;
+		hfreq = timing_hfreq(&ct);
+		if (refresh < idx->min_vfreq_hz || refresh > idx->max_vfreq_hz ||
+		    hfreq < idx->min_hfreq_hz || hfreq > idx->max_hfreq_hz ||
+		    (idx->max_pixclk_khz && ct.pixclk_khz > idx->max_pixclk_khz) ||
+		    (idx->max_hact && width > idx->max_hact))
+			continue;
+		if (t)
+			*t = ct;
+		return EDID_SUPPORTS_RANGE;
+	}
+	return EDID_SUPPORTS_NONE;
+}
+
+/* Gbps per lane and number of lanes of each Max_FRL_Rate */
+static const struct {
+	uint8_t gbps, lanes;
+} frl_rates[] = {
+	{ 0, 0 }, { 3, 3 }, { 6, 3 }, { 6, 4 }, { 8, 4 }, { 10, 4 }, { 12, 4 },
+};
+
+/* slices and maximum pixel clock per slice in MHz of each DSC_MaxSlices */
+static const struct {
+	uint8_t slices;
+	uint16_t mhz;
+} dsc_max_slice_rates[] = {
+	{ 0, 0 }, { 1, 340 }, { 2, 340 }, { 4, 340 },
+	{ 8, 340 }, { 8, 400 }, { 12, 400 }, { 16, 400 },
+};
+
+/* DSC target bitrate, in bits per pixel */
+#define DSC_BPP		12
+
+/* What both ends of the link support, as used by edid_negotiate() */
+struct link_caps {
+	int hdmi;
+	unsigned formats;		/* EDID_FORMAT_* */
+	uint32_t bpcs[4];		/* bit n: n bpc, per format */
+	uint32_t max_pixclk_khz;	/* 0 if not limited */
+	uint32_t max_tmds_khz;		/* 0 without TMDS */
+	unsigned max_frl_rate;
+	unsigned dsc_max_frl_rate;	/* 0 without DSC */
+	uint32_t dsc_bpcs;
+	uint32_t dsc_max_pixclk_khz;
+};
+
+static void link_caps(struct link_caps *c, const struct edid_info *info,
+		      const struct edid_source_caps *src)
+{
+	const struct edid_hdmi_caps *hdmi = &info->cta.hdmi;
+	const struct edid_hf_caps *hf = &info->cta.hf;
+	const struct edid_range_limits *range = &info->base.range_limits;
+	uint32_t src_bpcs = 0;
+	unsigned bpc, i;
+
+	memset(c, 0, sizeof(*c));
+	for (bpc = 8; bpc <= src->max_bpc; bpc += bpc == 12 ? 4 : 2)
+		src_bpcs |= 1 << bpc;
+
+	c->formats = EDID_FORMAT_RGB | EDID_FORMAT_YCBCR420;
+	for (i = 0; i < info->num_extensions; i++)
+		if (info->extensions[i].tag == 0x02)
+			c->formats |= (info->extensions[i].flags & 0x20 ? EDID_FORMAT_YCBCR444 : 0) |
+				      (info->extensions[i].flags & 0x10 ? EDID_FORMAT_YCBCR422 : 0);
+	/* the color encoding formats of a digital EDID 1.4 */
+	if (info->base.digital && info->base.revision >= 4)
+		c->formats |= (info->base.features & 0x08 ? EDID_FORMAT_YCBCR444 : 0) |
+			      (info->base.features & 0x10 ? EDID_FORMAT_YCBCR422 : 0);
+	c->formats &= src->formats;
+
+	c->hdmi = hdmi->present;
+	if (c->hdmi) {
+		/* deep color, from the HDMI and HDMI Forum blocks */
+		c->bpcs[0] = 1 << 8 | (hdmi->flags & 0x10 ? 1 << 10 : 0) |
+			     (hdmi->flags & 0x20 ? 1 << 12 : 0) |
+			     (hdmi->flags & 0x40 ? 1 << 16 : 0);
+		c->bpcs[1] = hdmi->flags & 0x08 ? c->bpcs[0] : 1 << 8;
+		c->bpcs[2] = 1 << 8 | 1 << 10 | 1 << 12;
+		c->bpcs[3] = 1 << 8 | (hf->flags[1] & 0x01 ? 1 << 10 : 0) |
+			     (hf->flags[1] & 0x02 ? 1 << 12 : 0) |
+			     (hf->flags[1] & 0x04 ? 1 << 16 : 0);
+
+		if (hf->present && hf->max_tmds_mhz > 340)
+			c->max_tmds_khz = hf->max_tmds_mhz * 1000;
+		else if (hdmi->max_tmds_mhz)
+			c->max_tmds_khz = hdmi->max_tmds_mhz * 1000;
+		else
+			c->max_tmds_khz = 165000;
+		c->max_tmds_khz = min(c->max_tmds_khz, src->max_tmds_mhz * 1000);
+
+		if (hf->present) {
+			c->max_frl_rate = min(hf->max_frl_rate, src->max_frl_rate);
+			c->max_frl_rate = min(c->max_frl_rate, ARRAY_SIZE(frl_rates) - 1);
+		}
+		if (hf->present && (hf->dsc_flags & 0x80) && src->dsc &&
+		    hf->dsc_max_slices < ARRAY_SIZE(dsc_max_slice_rates)) {
+			c->dsc_max_frl_rate = min(hf->dsc_max_frl_rate, c->max_frl_rate);
+			c->dsc_bpcs = 1 << 8 | (hf->dsc_flags & 0x01 ? 1 << 10 : 0) |
+				      (hf->dsc_flags & 0x02 ? 1 << 12 : 0);
+			c->dsc_max_pixclk_khz = dsc_max_slice_rates[hf->dsc_max_slices].slices *
+				dsc_max_slice_rates[hf->dsc_max_slices].mhz * 1000;
+		}
+	} else {
+		/* the bit depth of a digital EDID 1.4, else 8 bpc */
+		c->bpcs[0] = 1 << 8;
+		for (bpc = 10; bpc <= info->base.bpc; bpc += bpc == 12 ? 4 : 2)
+			c->bpcs[0] |= 1 << bpc;
+		c->bpcs[1] = c->bpcs[2] = c->bpcs[3] = c->bpcs[0];
+	}
+	for (i = 0; i < ARRAY_SIZE(c->bpcs); i++)
+		c->bpcs[i] &= src_bpcs;
+	c->dsc_bpcs &= src_bpcs;
+
+	if (info->base.has_range_limits && range->max_pixclk_mhz)
+		c->max_pixclk_khz = range->max_pixclk_mhz * 1000 - range->pixclk_adjust_khz;
+	if (src->max_pixclk_khz && (!c->max_pixclk_khz || src->max_pixclk_khz < c->max_pixclk_khz))
+		c->max_pixclk_khz = src->max_pixclk_khz;
+}
+
+/* FRL capacity after 16b/18b coding, less 3% for RS FEC and packets */
+static uint32_t frl_mbps(unsigned rate)
+{
+	return frl_rates[rate].gbps * frl_rates[rate].lanes * 1000 * 16 / 18 * 97 / 100;
+}
+
+/*
+ * Fill lm with the link that carries pixclk_khz in format fmt (as an
+ * index in EDID_FORMAT_*) at bpc, and return 0, or return -1 if none can
+ */
+static int link_fit(const struct link_caps *c, uint32_t pixclk_khz,
+		    unsigned fmt, unsigned bpc, int dsc, struct edid_link_mode *lm)
+{
+	/* bits per pixel times 2: 4:2:0 carries 1.5 components a pixel */
+	static const uint8_t components2[] = { 6, 6, 4, 3 };
+	uint64_t data_mbps = (uint64_t)pixclk_khz * components2[fmt] * bpc / 2000;
+	unsigned rate;
+
+	lm->format = 1 << fmt;
+	lm->bpc = bpc;
+	lm->dsc = dsc;
+	lm->frl_rate = 0;
+	lm->tmds_khz = 0;
+	if (!c->hdmi) {
+		lm->link = EDID_LINK_NONE;
+		lm->bandwidth_mbps = data_mbps;
+		return 0;
+	}
+
+	if (dsc) {
+		if (pixclk_khz > c->dsc_max_pixclk_khz)
+			return -1;
+		data_mbps = (uint64_t)pixclk_khz * DSC_BPP / 1000;
+		for (rate = 1; rate <= c->dsc_max_frl_rate; rate++)
+			if (data_mbps <= frl_mbps(rate))
+				break;
+		if (rate > c->dsc_max_frl_rate)
+			return -1;
+	} else {
+		/* TMDS sends 4:2:2 in a 12 bit container, and 4:2:0 at half rate */
+		uint64_t tmds_khz = fmt == 2 ? pixclk_khz :
+				    (uint64_t)pixclk_khz * bpc / (fmt == 3 ? 16 : 8);
+
+		if (tmds_khz <= c->max_tmds_khz) {
+			lm->link = EDID_LINK_TMDS;
+			lm->tmds_khz = tmds_khz;
+			/* three channels of 10 bit characters */
+			lm->bandwidth_mbps = tmds_khz * 30 / 1000;
+			return 0;
+		}
+		for (rate = 1; rate <= c->max_frl_rate; rate++)
+			if (data_mbps <= frl_mbps(rate))
+				break;
+		if (rate > c->max_frl_rate)
+			return -1;
+	}
+	lm->link = EDID_LINK_FRL;
+	lm->frl_rate = rate;
+	lm->bandwidth_mbps = data_mbps;
+	return 0;
+}
+
+/* Fill lm with the best way to send mode m, and return 0, or return -1 */
+static int link_mode(const struct link_caps *c, const struct edid_mode *m,
+		     struct edid_link_mode *lm)
+{
+	static const uint8_t bpcs[] = { 16, 12, 10, 8 };
+	uint32_t pixclk_khz = m->timing.pixclk_khz;
+	unsigned fmt, i;
+	int dsc;
+
+	if (c->max_pixclk_khz && pixclk_khz > c->max_pixclk_khz)
+		return -1;
+	lm->mode = m;
+	for (dsc = 0; dsc <= !!c->dsc_max_frl_rate; dsc++) {
+		for (fmt = 0; fmt < ARRAY_SIZE(c->bpcs); fmt++) {
+			uint32_t mode_bpcs = dsc ? c->dsc_bpcs & c->bpcs[fmt] : c->bpcs[fmt];
+
+			if (!(c->formats & (1 << fmt)))
+				continue;
+			/* only DSC of RGB and 4:4:4 is used */
+			if (dsc && fmt >= 2)
+				break;
+			if ((1 << fmt) == EDID_FORMAT_YCBCR420 ?
+			    !(m->flags & EDID_MODE_YCBCR420) :
+			    (m->flags & EDID_MODE_YCBCR420_ONLY))
+				continue;
+			for (i = 0; i < ARRAY_SIZE(bpcs); i++)
+				if ((mode_bpcs & (1 << bpcs[i])) &&
+				    !link_fit(c, pixclk_khz, fmt, bpcs[i], dsc, lm))
+					return 0;
+		}
+	}
+	return -1;
+}
+
+/* best first: larger, progressive, faster, deeper, less subsampled */
+static int link_mode_cmp(const void *a, const void *b)
+{
+	const struct edid_link_mode *la = a, *lb = b;
+	const struct edid_timing *ta = &la->mode->timing, *tb = &lb->mode->timing;
+	uint32_t area_a = ta->hact * frame_height(ta);
+	uint32_t area_b = tb->hact * frame_height(tb);
+	unsigned pref_a = la->mode->flags & (EDID_MODE_PREFERRED | EDID_MODE_NATIVE);
+	unsigned pref_b = lb->mode->flags & (EDID_MODE_PREFERRED | EDID_MODE_NATIVE);
+
+	if (area_a != area_b)
+		return area_a > area_b ? -1 : 1;
+	if ((ta->flags ^ tb->flags) & EDID_TIMING_INTERLACED)
+		return ta->flags & EDID_TIMING_INTERLACED ? 1 : -1;
+	if (la->mode->refresh_mhz != lb->mode->refresh_mhz)
+		return la->mode->refresh_mhz > lb->mode->refresh_mhz ? -1 : 1;
+	if (la->bpc != lb->bpc)
+		return la->bpc > lb->bpc ? -1 : 1;
+	if (la->format != lb->format)
+		return la->format < lb->format ? -1 : 1;
+	if (pref_a != pref_b)
+		return pref_a > pref_b ? -1 : 1;
+	if (la->bandwidth_mbps != lb->bandwidth_mbps)
+		return la->bandwidth_mbps < lb->bandwidth_mbps ? -1 : 1;
+	return la->mode < lb->mode ? -1 : la->mode > lb->mode;
+}
+
+unsigned edid_negotiate(const struct edid_info *info,
+			const struct edid_source_caps *src,
+			struct edid_link_mode *modes, unsigned max_modes)
+{
+	struct edid_link_mode all[EDID_INFO_MAX_MODES];
+	struct link_caps c;
+	unsigned i, n = 0;
+
+	if (!info->size)
+		return 0;
+	link_caps(&c, info, src);
+	for (i = 0; i < info->num_modes; i++)
+		if (!link_mode(&c, &info->modes[i], &all[n]))
+			n++;
+	qsort(all, n, sizeof(all[0]), link_mode_cmp);
+	n = min(n, max_modes);
+	memcpy(modes, all, n * sizeof(all[0]));
+	return n;
+}
+
+/*
+ * Emitters: each writes a decoded edid_info in one output format.
+ */
+
+/*
+ * The text report: the edid-decode output, written from a decoded
+ * edid_info. The fields of each block are formatted from its bytes in
+ * info->buf; where the report depends on the decode, such as the
+ * conformance checks, it is taken from info.
+ */
+
+static void text_cvt_descriptor(struct text_out *out, const unsigned char *x, int first)
+{
+	const unsigned char empty[3] = { 0, 0, 0 };
+	/* the refresh rates of bits 4 - 0 of byte 2; bit 0 is 60 Hz RB */
+	static const unsigned rates[] = { 50, 60, 75, 85, 60 };
+	const char *ratio;
+	char *names[] = { "50", "60", "75", "85" };
+	unsigned min_hfreq = ~0;
+	unsigned max_hfreq = 0;
+	unsigned max_clock = 0;
+	unsigned i;
+	int width, height;
+
+	if (!first && !memcmp(x, empty, 3))
+		return;
+
+	if ((x[1] & 0x03) || (x[2] & 0x80) || !(x[2] & 0x1f)) {
+		out_printf(out, "    (broken)\n");
+		return;
+	}
+
+	height = x[0];
+	height |= (x[1] & 0xf0) << 4;
+	height++;
+	height *= 2;
+
+	switch (x[1] & 0x0c) {
+	case 0x00:
+		width = 8 * (((height * 4) / 3) / 8);
+		ratio = "4:3";
+		break;
+	case 0x04:
+		width = 8 * (((height * 16) / 9) / 8);
+		ratio = "16:9";
+		break;
+	case 0x08:
+		width = 8 * (((height * 16) / 10) / 8);
+		ratio = "16:10";
+		break;
+	case 0x0c:
+		width = 8 * (((height * 15) / 9) / 8);
+		ratio = "15:9";
+		break;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(rates); i++) {
+		struct edid_timing t;
+		unsigned hfreq;
+
+		if (!(x[2] & (0x10 >> i)))
+			continue;
+		if (edid_calc_timing(width, height, rates[i],
+				     i == 4 ? EDID_FORMULA_CVT_RB : EDID_FORMULA_CVT, &t))
+			continue;
+		hfreq = timing_hfreq(&t);
+		min_hfreq = min(min_hfreq, hfreq);
+		max_hfreq = max(max_hfreq, hfreq);
+		max_clock = max(max_clock, t.pixclk_khz);
+	}
+
+	out_printf(out, "    %dx%d @ ( %s%s%s%s%s) Hz %s (%s%s preferred) HorFreq: %d-%d Hz MaxClock: %.3f MHz\n",
+			width, height,
+			(x[2] & 0x10) ? "50 " : "",
+			(x[2] & 0x08) ? "60 " : "",
+			(x[2] & 0x04) ? "75 " : "",
+			(x[2] & 0x02) ? "85 " : "",
+			(x[2] & 0x01) ? "60RB " : "",
+			ratio,
+			names[(x[2] & 0x60) >> 5],
+			(((x[2] & 0x60) == 0x20) && (x[2] & 0x01)) ? "RB" : "",
+			min_hfreq, max_hfreq, max_clock / 1000.0);
+}
+
+static void text_db_timing(struct text_out *out, const struct std_timing *t)
+{
+	out_printf(out, "  %dx%d%s@%dHz %s%u:%u HorFreq: %d Hz Clock: %.3f MHz\n",
+			t->x, t->y, t->interlaced ? "i" : "", t->refresh,
+			t->rb ? "RB " : "", t->ratio_w, t->ratio_h,
+			t->hor_freq_hz, t->pixclk_khz / 1000.0);
+}
+
+static void text_standard_timing(struct text_out *out, const unsigned char *std)
+{
+	struct edid_std_timing st;
+	const struct std_timing *t;
+	struct edid_timing et;
+
+	if (!std_timing_decode(std, out->minor >= 3, &st)) {
+		if (!std[0])
+			out_printf(out, "non-conformant standard timing (0 horiz)\n");
+		return;
+	}
+	t = find_std_timing(&st);
+	if (t)
+		out_printf(out, "  %dx%d@%dHz %d:%d HorFreq: %d Hz Clock: %.3f MHz\n",
+				st.hact, st.vact, st.refresh, st.ratio_w, st.ratio_h,
+				t->hor_freq_hz, t->pixclk_khz / 1000.0);
+	else if (!edid_calc_timing(st.hact, st.vact, st.refresh, out->minor >= 4 ?
+				   EDID_FORMULA_CVT : EDID_FORMULA_GTF, &et))
+		out_printf(out, "  %dx%d@%dHz %d:%d HorFreq: %d Hz Clock: %.3f MHz\n",
+				st.hact, st.vact, st.refresh, st.ratio_w, st.ratio_h,
+				timing_hfreq(&et), et.pixclk_khz / 1000.0);
+	else
+		out_printf(out, "  %dx%d@%dHz %d:%d\n",
+				st.hact, st.vact, st.refresh, st.ratio_w, st.ratio_h);
+}
+
+/* The length of a descriptor string up to its terminating newline */
+static int text_string_len(const unsigned char *x)
+{
+	int i;
+
+	for (i = 0; i < 13 && (isgraph(x[i]) || x[i] == ' '); i++)
+		;
+	return i;
+}
+
+static void text_color_point(struct text_out *out, const unsigned char *x)
+{
+	unsigned w_x = (x[2] << 2) | ((x[1] >> 2) & 3);
+	unsigned w_y = (x[3] << 2) | (x[1] & 3);
+
+	out_printf(out, "  Index: %u White: 0.%04u, 0.%04u", x[0],
+			(w_x * 10000) / 1024, (w_y * 10000) / 1024);
+	if (x[4] == 0xff)
+		out_printf(out, " Gamma: is defined in an extension block");
+	else
+		out_printf(out, " Gamma: %.2f", ((x[4] + 100.0) / 100.0));
+	out_printf(out, "\n");
+}
+
+static void text_range_descriptor(struct text_out *out, const unsigned char *x)
+{
+	int h_max_offset = 0, h_min_offset = 0;
+	int v_max_offset = 0, v_min_offset = 0;
+	const char *range_class;
+	int max_h_pixels;
+
+	if (out->minor >= 4) {
+		if (x[4] & 0x02) {
+			v_max_offset = 255;
+			if (x[4] & 0x01)
+				v_min_offset = 255;
+		}
+		if (x[4] & 0x04) {
+			h_max_offset = 255;
+			if (x[4] & 0x03)
+				h_min_offset = 255;
+		}
+	}
+
+	/*
+	 * despite the values, this is not a bitfield.
+	 */
+	switch (x[10]) {
+	case 0x00: range_class = "GTF"; break;
+	case 0x01: range_class = "bare limits"; break;
+	case 0x02: range_class = "GTF with icing"; break;
+	case 0x04: range_class = "CVT"; break;
+	default: range_class = "invalid"; break;
+	}
+
+	out_printf(out, "Monitor ranges (%s): %d-%dHz V, %d-%dkHz H",
+			range_class,
+			x[5] + v_min_offset, x[6] + v_max_offset,
+			x[7] + h_min_offset, x[8] + h_max_offset);
+	if (x[9])
+		out_printf(out, ", max dotclock %dMHz\n", x[9] * 10);
+	else
+		out_printf(out, "\n");
+
+	if (x[10] != 0x04)
+		return;
+
+	out_printf(out, "CVT version %d.%d\n", (x[11] & 0xf0) >> 4, x[11] & 0x0f);
+
+	if (x[12] & 0xfc)
+		out_printf(out, "Real max dotclock: %.2fMHz\n",
+				(x[9] * 10) - (((x[12] & 0xfc) >> 2) * 0.25));
+
+	max_h_pixels = x[12] & 0x03;
+	max_h_pixels <<= 8;
+	max_h_pixels |= x[13];
+	max_h_pixels *= 8;
+	if (max_h_pixels)
+		out_printf(out, "Max active pixels per line: %d\n", max_h_pixels);
+
+	out_printf(out, "Supported aspect ratios: %s %s %s %s %s\n",
+			x[14] & 0x80 ? "4:3" : "",
+			x[14] & 0x40 ? "16:9" : "",
+			x[14] & 0x20 ? "16:10" : "",
+			x[14] & 0x10 ? "5:4" : "",
+			x[14] & 0x08 ? "15:9" : "");
+
+	out_printf(out, "Preferred aspect ratio: ");
+	switch((x[15] & 0xe0) >> 5) {
+	case 0x00: out_printf(out, "4:3"); break;
+	case 0x01: out_printf(out, "16:9"); break;
+	case 0x02: out_printf(out, "16:10"); break;
+	case 0x03: out_printf(out, "5:4"); break;
+	case 0x04: out_printf(out, "15:9"); break;
+	default: out_printf(out, "(broken)"); break;
+	}
+	out_printf(out, "\n");
+
+	if (x[15] & 0x08)
+		out_printf(out, "Supports CVT standard blanking\n");
+	if (x[15] & 0x10)
+		out_printf(out, "Supports CVT reduced blanking\n");
+
+	if (x[16] & 0xf0) {
+		out_printf(out, "Supported display scaling:\n");
+		if (x[16] & 0x80)
+			out_printf(out, "    Horizontal shrink\n");
+		if (x[16] & 0x40)
+			out_printf(out, "    Horizontal stretch\n");
+		if (x[16] & 0x20)
+			out_printf(out, "    Vertical shrink\n");
+		if (x[16] & 0x10)
+			out_printf(out, "    Vertical stretch\n");
+	}
+
+	if (x[17])
+		out_printf(out, "Preferred vertical refresh: %d Hz\n", x[17]);
+}
+
+static void text_detailed_block(struct text_out *out, const unsigned char *x)
+{
+	int ha, hbl, hso, hspw, hborder, va, vbl, vso, vspw, vborder;
+	int pixclk_khz;
+	int i;
+	char phsync, pvsync, *syncmethod, *stereo;
+
+#if 0
+	out_printf(out, "Hex of detail: ");
+	for (i = 0; i < 18; i++)
+		out_printf(out, "%02x", x[i]);
+	out_printf(out, "\n");
+#endif
+
+	if (x[0] == 0 && x[1] == 0) {
+		/* Monitor descriptor block, not detailed timing descriptor. */
+		if (x[2] != 0)
+			out_printf(out, "Monitor descriptor block has byte 2 nonzero (0x%02x)\n",
+					x[2]);
+		if (x[3] != 0xfd && x[4] != 0x00)
+			out_printf(out, "Monitor descriptor block has byte 4 nonzero (0x%02x)\n",
+					x[4]);
+		if (x[3] <= 0xF) {
+			/*
+			 * in principle we can decode these, if we know what they are.
+			 * 0x0f seems to be common in laptop panels.
+			 * 0x0e is used by EPI: http://www.epi-standard.org/
+			 */
+			out_printf(out, "Manufacturer-specified data, tag %d\n", x[3]);
+			return;
+		}
+		switch (x[3]) {
+		case 0x10:
+			out_printf(out, "Dummy block\n");
+			return;
+		case 0xF7:
+			out_printf(out, "Established timings III:\n");
+			for (i = 0; i < 44; i++) {
+				if (x[6 + i / 8] & (1 << (7 - i % 8)))
+					text_db_timing(out, &timing_db[established_timings3[i]]);
+			}
+			return;
+		case 0xF8:
+			out_printf(out, "CVT 3-byte code descriptor:\n");
+			if (x[5] != 0x01)
+				return;
+			for (i = 0; i < 4; i++)
+				text_cvt_descriptor(out, x + 6 + (i * 3), (i == 0));
+			return;
+		case 0xF9:
+			out_printf(out, "Color management data:\n");
+			out_printf(out, "  Version:  %d\n", x[5]);
+			out_printf(out, "  Red a3:   %.2f\n", (short)(x[6] | (x[7] << 8)) / 100.0);
+			out_printf(out, "  Red a2:   %.2f\n", (short)(x[8] | (x[9] << 8)) / 100.0);
+			out_printf(out, "  Green a3: %.2f\n", (short)(x[10] | (x[11] << 8)) / 100.0);
+			out_printf(out, "  Green a2: %.2f\n", (short)(x[12] | (x[13] << 8)) / 100.0);
+			out_printf(out, "  Blue a3:  %.2f\n", (short)(x[14] | (x[15] << 8)) / 100.0);
+			out_printf(out, "  Blue a2:  %.2f\n", (short)(x[16] | (x[17] << 8)) / 100.0);
+			return;
+		case 0xFA:
+			out_printf(out, "More standard timings:\n");
+			for (i = 0; i < 6; i++)
+				text_standard_timing(out, x + 5 + i * 2);
+			return;
+		case 0xFB:
+			out_printf(out, "Color point:\n");
+			text_color_point(out, x + 5);
+			if (x[10])
+				text_color_point(out, x + 10);
+			return;
+		case 0xFC:
+			out_printf(out, "Monitor name: %.*s\n", text_string_len(x + 5), x + 5);
+			return;
+		case 0xFD:
+			text_range_descriptor(out, x);
+			return;
+		case 0xFE:
+			out_printf(out, "ASCII string: %.*s\n", text_string_len(x + 5), x + 5);
+			return;
+		case 0xFF:
+			out_printf(out, "Serial number: %.*s\n", text_string_len(x + 5), x + 5);
+			return;
+		default:
+			out_printf(out, "Unknown monitor description type %d\n", x[3]);
+			return;
+		}
+	}
+
+	ha = (x[2] + ((x[4] & 0xF0) << 4));
+	hbl = (x[3] + ((x[4] & 0x0F) << 8));
+	hso = (x[8] + ((x[11] & 0xC0) << 2));
+	hspw = (x[9] + ((x[11] & 0x30) << 4));
+	hborder = x[15];
+	va = (x[5] + ((x[7] & 0xF0) << 4));
+	vbl = (x[6] + ((x[7] & 0x0F) << 8));
+	vso = ((x[10] >> 4) + ((x[11] & 0x0C) << 2));
+	vspw = ((x[10] & 0x0F) + ((x[11] & 0x03) << 4));
+	vborder = x[16];
+	switch ((x[17] & 0x18) >> 3) {
+	case 0x00:
+		syncmethod = " analog composite";
+		break;
+	case 0x01:
+		syncmethod = " bipolar analog composite";
+		break;
+	case 0x02:
+		syncmethod = " digital composite";
+		break;
+	case 0x03:
+		syncmethod = "";
+		break;
+	}
+	pvsync = (x[17] & (1 << 2)) ? '+' : '-';
+	phsync = (x[17] & (1 << 1)) ? '+' : '-';
+	switch (x[17] & 0x61) {
+	case 0x20:
+		stereo = "field sequential L/R";
+		break;
+	case 0x40:
+		stereo = "field sequential R/L";
+		break;
+	case 0x21:
+		stereo = "interleaved right even";
+		break;
+	case 0x41:
+		stereo = "interleaved left even";
+		break;
+	case 0x60:
+		stereo = "four way interleaved";
+		break;
+	case 0x61:
+		stereo = "side by side interleaved";
+		break;
+	default:
+		stereo = "";
+		break;
+	}
+
+	if (!ha || !hbl || !va || !vbl) {
+		out_printf(out, "Invalid Detailed Timings:\n"
+				"  Horizontal Active/Blanking %d/%d\n"
+				"  Vertical Active/Blanking %d/%d\n",
+				ha, hbl, va, vbl);
+		return;
+	}
+
+	pixclk_khz = (x[0] + (x[1] << 8)) * 10;
+	out_printf(out, "Detailed mode: Clock %.3f MHz, %d mm x %d mm\n"
+			"               %4d %4d %4d %4d hborder %d\n"
+			"               %4d %4d %4d %4d vborder %d\n"
+			"               %chsync %cvsync%s%s %s\n"
+			"               VertFreq: %d Hz, HorFreq: %d Hz\n",
+			pixclk_khz / 1000.0,
+			(x[12] + ((x[14] & 0xF0) << 4)),
+			(x[13] + ((x[14] & 0x0F) << 8)),
+			ha, ha + hso, ha + hso + hspw, ha + hbl, hborder,
+			va, va + vso, va + vso + vspw, va + vbl, vborder,
+			phsync, pvsync, syncmethod, x[17] & 0x80 ? " interlaced" : "",
+			stereo, (pixclk_khz * 1000) / ((ha + hbl) * (va + vbl)),
+			(pixclk_khz * 1000) / (ha + hbl));
+}
+
+static void text_checksum(struct text_out *out, const unsigned char *x, size_t len)
+{
+	unsigned char check = x[len - 1];
+	unsigned char sum = 0;
+	size_t i;
+
+	out_printf(out, "Checksum: 0x%hx", check);
+
+	for (i = 0; i < len - 1; i++)
+		sum += x[i];
+
+	if ((unsigned char)(check + sum) != 0)
+		out_printf(out, " (should be 0x%hx)\n", -sum & 0xff);
+	else
+		out_printf(out, " (valid)\n");
+}
+static void text_cta_audio_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int i, format, ext_format = 0;
+
+	if (length % 3) {
+		out_printf(out, "Broken CTA audio block length %d\n", length);
+		/* XXX non-out->conformant */
+		return;
+	}
+
+	for (i = 0; i < length; i += 3) {
+		format = (x[i] & 0x78) >> 3;
+		ext_format = (x[i + 2] & 0xf8) >> 3;
+		if (format != 15)
+			out_printf(out, "    %s, max channels %d\n", audio_format(format),
+					  (x[i] & 0x07)+1);
+		else if (ext_format == 11)
+			out_printf(out, "    %s, MPEG-H 3D Audio Level: %s\n", audio_ext_format(ext_format),
+					  mpeg_h_3d_audio_level(x[i] & 0x07));
+		else if (ext_format == 13)
+			out_printf(out, "    %s, max channels %d\n", audio_ext_format(ext_format),
+					  (((x[i + 1] & 0x80) >> 3) | ((x[i] & 0x80) >> 4) |
+					   (x[i] & 0x07))+1);
+		else
+			out_printf(out, "    %s, max channels %d\n", audio_ext_format(ext_format),
+					  (x[i] & 0x07)+1);
+		out_printf(out, "      Supported sample rates (kHz):%s%s%s%s%s%s%s\n",
+				  (x[i+1] & 0x40) ? " 192" : "",
+				  (x[i+1] & 0x20) ? " 176.4" : "",
+				  (x[i+1] & 0x10) ? " 96" : "",
+				  (x[i+1] & 0x08) ? " 88.2" : "",
+				  (x[i+1] & 0x04) ? " 48" : "",
+				  (x[i+1] & 0x02) ? " 44.1" : "",
+				  (x[i+1] & 0x01) ? " 32" : "");
+		if (format == 1 || ext_format == 13) {
+			out_printf(out, "      Supported sample sizes (bits):%s%s%s\n",
+					  (x[i+2] & 0x04) ? " 24" : "",
+					  (x[i+2] & 0x02) ? " 20" : "",
+					  (x[i+2] & 0x01) ? " 16" : "");
+		} else if (format <= 8) {
+			out_printf(out, "      Maximum bit rate: %d kb/s\n", x[i+2] * 8);
+		} else if (format == 10) {
+			// As specified by the "Dolby Audio and Dolby Atmos over HDMI"
+			// specification (v1.0).
+			if(x[i+2] & 1)
+				out_printf(out, "      Supports Joint Object Coding\n");
+			if(x[i+2] & 2)
+				out_printf(out, "      Supports Joint Object Coding with ACMOD28\n");
+		} else if (format == 14) {
+			out_printf(out, "      Profile: %d\n", x[i+2] & 7);
+		} else if (ext_format == 11 && (x[i+2] & 1)) {
+			out_printf(out, "      Supports MPEG-H 3D Audio Low Complexity Profile\n");
+		} else if ((ext_format >= 4 && ext_format <= 6) ||
+			   ext_format == 8 || ext_format == 10) {
+			out_printf(out, "      AAC audio frame lengths:%s%s\n",
+					  (x[i+2] & 4) ? " 1024_TL" : "",
+					  (x[i+2] & 2) ? " 960_TL" : "");
+			if (ext_format >= 8 && (x[i+2] & 1))
+				out_printf(out, "      Supports %s signaled MPEG Surround data\n",
+						  (x[i+2] & 1) ? "implicitly and explicitly" : "only implicitly");
+			if (ext_format == 6 && (x[i+2] & 1))
+				out_printf(out, "      Supports 22.2ch System H\n");
+		}
+	}
+}
+
+static void text_cta_svd(struct text_out *out, const unsigned char *x, int n, int for_ycbcr420)
+{
+	int i;
+
+	for (i = 0; i < n; i++)  {
+		const struct edid_vic_mode *vicmode = NULL;
+		unsigned char svd = x[i];
+		unsigned char native;
+		unsigned char vic;
+		const char *mode;
+		unsigned hfreq = 0;
+		unsigned clock_khz = 0;
+
+		if ((svd & 0x7f) == 0)
+			continue;
+
+		if ((svd - 1) & 0x40) {
+			vic = svd;
+			native = 0;
+		} else {
+			vic = svd & 0x7f;
+			native = svd & 0x80;
+		}
+
+		vicmode = vic_to_mode(vic);
+		if (vicmode) {
+			mode = vicmode->name;
+			hfreq = vicmode->hor_freq_hz;
+			clock_khz = vicmode->timing.pixclk_khz / (for_ycbcr420 ? 2 : 1);
+		} else {
+			mode = "Unknown mode";
+		}
+
+		out_printf(out, "    VIC %3d %s %s HorFreq: %d Hz Clock: %.3f MHz\n",
+				vic, mode, native ? "(native)" : "", hfreq, clock_khz / 1000.0);
+	}
+}
+
+static void text_cta_video_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	text_cta_svd(out, x, length, 0);
+}
+
+static void text_cta_y420vdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	text_cta_svd(out, x, length, 1);
+}
+
+static void text_cta_y420cmdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int i;
+
+	for (i = 0; i < length; i++) {
+		uint8_t v = x[0 + i];
+		int j;
+
+		for (j = 0; j < 8; j++)
+			if (v & (1 << j))
+				out_printf(out, "    VSD Index %d\n", i * 8 + j);
+	}
+}
+
+static void text_cta_vfpdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int i;
+
+	for (i = 0; i < length; i++)  {
+		unsigned char svr = x[i];
+
+		if ((svr > 0 && svr < 128) || (svr > 192 && svr < 254)) {
+			const struct edid_vic_mode *vicmode;
+			unsigned char vic;
+			const char *mode;
+
+			vic = svr;
+
+			vicmode = vic_to_mode(vic);
+			if (vicmode)
+				mode = vicmode->name;
+			else
+				mode = "Unknown mode";
+
+			out_printf(out, "    VIC %02d %s\n", vic, mode);
+
+		} else if (svr > 128 && svr < 145) {
+			out_printf(out, "    DTD number %02d\n", svr - 128);
+		}
+	}
+}
+
+
+static void text_cta_hdmi_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int mask = 0, formats = 0;
+	int len_vic, len_3d;
+	int b = 0;
+
+	out_printf(out, " (HDMI)\n");
+	out_printf(out, "    Source physical address %d.%d.%d.%d\n", x[3] >> 4, x[3] & 0x0f,
+			  x[4] >> 4, x[4] & 0x0f);
+
+	if (length < 6)
+		return;
+
+	if (x[5] & 0x80)
+		out_printf(out, "    Supports_AI\n");
+	if (x[5] & 0x40)
+		out_printf(out, "    DC_48bit\n");
+	if (x[5] & 0x20)
+		out_printf(out, "    DC_36bit\n");
+	if (x[5] & 0x10)
+		out_printf(out, "    DC_30bit\n");
+	if (x[5] & 0x08)
+		out_printf(out, "    DC_Y444\n");
+	/* two reserved */
+	if (x[5] & 0x01)
+		out_printf(out, "    DVI_Dual\n");
+
+	if (length < 7)
+		return;
+
+	out_printf(out, "    Maximum TMDS clock: %dMHz\n", x[6] * 5);
+
+	/* XXX the walk here is really ugly, and needs to be length-checked */
+	if (length < 8)
+		return;
+
+	if (x[7] & 0x0f) {
+		out_printf(out, "    Supported Content Types:\n");
+		if (x[7] & 0x01)
+			out_printf(out, "      Graphics\n");
+		if (x[7] & 0x02)
+			out_printf(out, "      Photo\n");
+		if (x[7] & 0x04)
+			out_printf(out, "      Cinema\n");
+		if (x[7] & 0x08)
+			out_printf(out, "      Game\n");
+	}
+
+	if (x[7] & 0x80) {
+		out_printf(out, "    Video latency: %d\n", x[8 + b]);
+		out_printf(out, "    Audio latency: %d\n", x[9 + b]);
+		b += 2;
+
+		if (x[7] & 0x40) {
+			out_printf(out, "    Interlaced video latency: %d\n", x[8 + b]);
+			out_printf(out, "    Interlaced audio latency: %d\n", x[9 + b]);
+			b += 2;
+		}
+	}
+
+	if (!(x[7] & 0x20))
+		return;
+
+	out_printf(out, "    Extended HDMI video details:\n");
+	if (x[8 + b] & 0x80)
+		out_printf(out, "      3D present\n");
+	if ((x[8 + b] & 0x60) == 0x20) {
+		out_printf(out, "      All advertised VICs are 3D-capable\n");
+		formats = 1;
+	}
+	if ((x[8 + b] & 0x60) == 0x40) {
+		out_printf(out, "      3D-capable-VIC mask present\n");
+		formats = 1;
+		mask = 1;
+	}
+	switch (x[8 + b] & 0x18) {
+	case 0x00: break;
+	case 0x08:
+		   out_printf(out, "      Base EDID image size is aspect ratio\n");
+		   break;
+	case 0x10:
+		   out_printf(out, "      Base EDID image size is in units of 1cm\n");
+		   break;
+	case 0x18:
+		   out_printf(out, "      Base EDID image size is in units of 5cm\n");
+		   break;
+	}
+	len_vic = (x[9 + b] & 0xe0) >> 5;
+	len_3d = (x[9 + b] & 0x1f) >> 0;
+	b += 2;
+
+	if (len_vic) {
+		unsigned hfreq = 0;
+		unsigned clock_khz = 0;
+		int i;
+
+		for (i = 0; i < len_vic; i++) {
+			unsigned char vic = x[8 + b + i];
+			const char *mode;
+
+			/* an unknown VIC shows the rates of the one before it */
+			if (vic && vic <= ARRAY_SIZE(edid_hdmi_modes)) {
+				mode = edid_hdmi_modes[vic - 1].name;
+				hfreq = edid_hdmi_modes[vic - 1].hor_freq_hz;
+				clock_khz = edid_hdmi_modes[vic - 1].pixclk_khz;
+			} else {
+				mode = "Unknown mode";
+			}
+
+			out_printf(out, "      HDMI VIC %d %s HorFreq: %d Hz Clock: %.3f MHz\n",
+					  vic, mode, hfreq, clock_khz / 1000.0);
+		}
+
+		b += len_vic;
+	}
+
+	if (len_3d) {
+		if (formats) {
+			/* 3D_Structure_ALL_15..8 */
+			if (x[8 + b] & 0x80)
+				out_printf(out, "      3D: Side-by-side (half, quincunx)\n");
+			if (x[8 + b] & 0x01)
+				out_printf(out, "      3D: Side-by-side (half, horizontal)\n");
+			/* 3D_Structure_ALL_7..0 */
+			if (x[9 + b] & 0x40)
+				out_printf(out, "      3D: Top-and-bottom\n");
+			if (x[9 + b] & 0x20)
+				out_printf(out, "      3D: L + depth + gfx + gfx-depth\n");
+			if (x[9 + b] & 0x10)
+				out_printf(out, "      3D: L + depth\n");
+			if (x[9 + b] & 0x08)
+				out_printf(out, "      3D: Side-by-side (full)\n");
+			if (x[9 + b] & 0x04)
+				out_printf(out, "      3D: Line-alternative\n");
+			if (x[9 + b] & 0x02)
+				out_printf(out, "      3D: Field-alternative\n");
+			if (x[9 + b] & 0x01)
+				out_printf(out, "      3D: Frame-packing\n");
+			b += 2;
+			len_3d -= 2;
+		}
+		if (mask) {
+			int i;
+			out_printf(out, "      3D VIC indices:");
+			/* worst bit ordering ever */
+			for (i = 0; i < 8; i++)
+				if (x[9 + b] & (1 << i))
+					out_printf(out, " %d", i);
+			for (i = 0; i < 8; i++)
+				if (x[8 + b] & (1 << i))
+					out_printf(out, " %d", i + 8);
+			out_printf(out, "\n");
+			b += 2;
+			len_3d -= 2;
+		}
+
+		/*
+		 * list of nibbles:
+		 * 2D_VIC_Order_X
+		 * 3D_Structure_X
+		 * (optionally: 3D_Detail_X and reserved)
+		 */
+		if (len_3d > 0) {
+			int end = b + len_3d;
+
+			while (b < end) {
+				out_printf(out, "      VIC index %d supports ", x[8 + b] >> 4);
+				switch (x[8 + b] & 0x0f) {
+				case 0: out_printf(out, "frame packing"); break;
+				case 6: out_printf(out, "top-and-bottom"); break;
+				case 8:
+					if ((x[9 + b] >> 4) == 1) {
+						out_printf(out, "side-by-side (half, horizontal)");
+						break;
+					}
+				default: out_printf(out, "unknown");
+				}
+				out_printf(out, "\n");
+
+				if ((x[8 + b] & 0x0f) > 7) {
+					/* Optional 3D_Detail_X and reserved */
+					b++;
+				}
+				b++;
+			}
+		}
+	}
+}
+
+static const char *max_frl_rates[] = {
+	"Not Supported",
+	"3 Gbps per lane on 3 lanes",
+	"3 and 6 Gbps per lane on 3 lanes",
+	"3 and 6 Gbps per lane on 3 lanes, 6 Gbps on 4 lanes",
+	"3 and 6 Gbps per lane on 3 lanes, 6 and 8 Gbps on 4 lanes",
+	"3 and 6 Gbps per lane on 3 lanes, 6, 8 and 10 Gbps on 4 lanes",
+	"3 and 6 Gbps per lane on 3 lanes, 6, 8, 10 and 12 Gbps on 4 lanes",
+};
+
+static const char *dsc_max_slices[] = {
+	"Not Supported",
+	"up to 1 slice and up to (340 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 2 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 4 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 8 slices and up to (340 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 8 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 12 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
+	"up to 16 slices and up to (400 MHz/Ksliceadjust) pixel clock per slice",
+};
+
+static void text_cta_hf_eeodb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	out_printf(out, "    EDID Extension Block Count: %u\n", x[0]);
+}
+
+static void text_cta_hf_scdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	unsigned rate = x[1] * 5;
+
+	out_printf(out, "    Version: %u\n", x[0]);
+	if (rate)
+		out_printf(out, "    Maximum TMDS Character Rate: %uMHz\n", rate);
+	if (x[2] & 0x80)
+		out_printf(out, "    SCDC Present\n");
+	if (x[2] & 0x40)
+		out_printf(out, "    SCDC Read Request Capable\n");
+	if (x[2] & 0x10)
+		out_printf(out, "    Supports Color Content Bits Per Component Indication\n");
+	if (x[2] & 0x08)
+		out_printf(out, "    Supports scrambling for <= 340 Mcsc\n");
+	if (x[2] & 0x04)
+		out_printf(out, "    Supports 3D Independent View signaling\n");
+	if (x[2] & 0x02)
+		out_printf(out, "    Supports 3D Dual View signaling\n");
+	if (x[2] & 0x01)
+		out_printf(out, "    Supports 3D OSD Disparity signaling\n");
+	if (x[3] & 0xf0) {
+		unsigned max_frl_rate = x[3] >> 4;
+
+		out_printf(out, "    Max Fixed Rate Link: ");
+		if (max_frl_rate >= ARRAY_SIZE(max_frl_rates))
+			out_printf(out, "Reserved\n");
+		else
+			out_printf(out, "%s\n", max_frl_rates[max_frl_rate]);
+	}
+	if (x[3] & 0x08)
+		out_printf(out, "    Supports UHD VIC\n");
+	if (x[3] & 0x04)
+		out_printf(out, "    Supports 16-bits/component Deep Color 4:2:0 Pixel Encoding\n");
+	if (x[3] & 0x02)
+		out_printf(out, "    Supports 12-bits/component Deep Color 4:2:0 Pixel Encoding\n");
+	if (x[3] & 0x01)
+		out_printf(out, "    Supports 10-bits/component Deep Color 4:2:0 Pixel Encoding\n");
+
+	if (length <= 7)
+		return;
+
+	if (x[4] & 0x20)
+		out_printf(out, "    Supports Mdelta\n");
+	if (x[4] & 0x10)
+		out_printf(out, "    Supports media rates below VRRmin (CinemaVRR)\n");
+	if (x[4] & 0x08)
+		out_printf(out, "    Supports negative Mvrr values\n");
+	if (x[4] & 0x04)
+		out_printf(out, "    Supports Fast Vactive\n");
+	if (x[4] & 0x02)
+		out_printf(out, "    Supports Auto Low-Latency Mode\n");
+	if (x[4] & 0x01)
+		out_printf(out, "    Supports a FAPA in blanking after first active video line\n");
+
+	if (length <= 8)
+		return;
+
+	out_printf(out, "    VRRmin: %d Hz\n", x[8] & 0x3f);
+	out_printf(out, "    VRRmax: %d Hz\n", (x[8] & 0xc0) << 2 | x[9]);
+
+	if (length <= 10)
+		return;
+
+	if (x[7] & 0x80)
+		out_printf(out, "    Supports VESA DSC 1.2a compression\n");
+	if (x[7] & 0x40)
+		out_printf(out, "    Supports Compressed Video Transport for 4:2:0 Pixel Encoding\n");
+	if (x[7] & 0x08)
+		out_printf(out, "    Supports Compressed Video Transport at any valid 1/16th bit bpp\n");
+	if (x[7] & 0x04)
+		out_printf(out, "    Supports 16 bpc Compressed Video Transport\n");
+	if (x[7] & 0x02)
+		out_printf(out, "    Supports 12 bpc Compressed Video Transport\n");
+	if (x[7] & 0x01)
+		out_printf(out, "    Supports 10 bpc Compressed Video Transport\n");
+	if (x[8] & 0xf) {
+		unsigned max_slices = x[8] & 0xf;
+
+		if (max_slices < ARRAY_SIZE(dsc_max_slices))
+			out_printf(out, "    Supports %s\n", dsc_max_slices[max_slices]);
+	}
+	if (x[8] & 0xf0) {
+		unsigned max_frl_rate = x[8] >> 4;
+
+		out_printf(out, "    DSC Max Fixed Rate Link: ");
+		if (max_frl_rate >= ARRAY_SIZE(max_frl_rates))
+			out_printf(out, "Reserved\n");
+		else
+			out_printf(out, "%s\n", max_frl_rates[max_frl_rate]);
+	}
+	if (x[9] & 0x3f)
+		out_printf(out, "    Maximum number of bytes in a line of chunks: %u\n",
+				  1024 * (1 + (x[9] & 0x3f)));
+}
+
+static void text_cta_hdr10plus(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	out_printf(out, "    Application Version: %u\n", x[0]);
+}
+
+struct value {
+	int value;
+	const char *description;
+};
+
+struct field {
+	const char *name;
+	int start, end;
+	struct value *values;
+	int n_values;
+};
+
+#define DEFINE_FIELD(n, var, s, e, ...)				\
+static struct value var##_values[] =  {				\
+	__VA_ARGS__						\
+};								\
+static struct field var = {					\
+	.name = n,						\
+	.start = s,		        			\
+	.end = e,						\
+	.values = var##_values,	        			\
+	.n_values = ARRAY_SIZE(var##_values),			\
+}
+
+static void decode_value(struct text_out *out, struct field *field, int val, const char *prefix)
+{
+	struct value *v;
+	int i;
+
+	for (i = 0; i < field->n_values; i++) {
+		v = &field->values[i];
+
+		if (v->value == val)
+			break;
+	}
+
+	if (i == field->n_values) {
+		out_printf(out, "%s%s: %d\n", prefix, field->name, val);
+		return;
+	}
+
+	out_printf(out, "%s%s: %s (%d)\n", prefix, field->name, v->description, val);
+}
+
+static void _decode(struct text_out *out, struct field **fields, int n_fields, int data, const char *prefix)
+{
+	int i;
+
+	for (i = 0; i < n_fields; i++) {
+		struct field *f = fields[i];
+		int field_length = f->end - f->start + 1;
+		int val;
+
+		if (field_length == 32)
+			val = data;
+		else
+			val = (data >> f->start) & ((1 << field_length) - 1);
+
+		decode_value(out, f, val, prefix);
+	}
+}
+
+#define decode(out, fields, data, prefix)    \
+	_decode(out, fields, ARRAY_SIZE(fields), data, prefix)
+
+
+DEFINE_FIELD("YCbCr quantization", YCbCr_quantization, 7, 7,
+	     { 0, "No Data" },
+	     { 1, "Selectable (via AVI YQ)" });
+DEFINE_FIELD("RGB quantization", RGB_quantization, 6, 6,
+	     { 0, "No Data" },
+	     { 1, "Selectable (via AVI Q)" });
+DEFINE_FIELD("PT scan behaviour", PT_scan, 4, 5,
+	     { 0, "No Data" },
+	     { 1, "Always Overscannned" },
+	     { 2, "Always Underscanned" },
+	     { 3, "Support both over- and underscan" });
+DEFINE_FIELD("IT scan behaviour", IT_scan, 2, 3,
+	     { 0, "IT video formats not supported" },
+	     { 1, "Always Overscannned" },
+	     { 2, "Always Underscanned" },
+	     { 3, "Support both over- and underscan" });
+DEFINE_FIELD("CE scan behaviour", CE_scan, 0, 1,
+	     { 0, "CE video formats not supported" },
+	     { 1, "Always Overscannned" },
+	     { 2, "Always Underscanned" },
+	     { 3, "Support both over- and underscan" });
+
+static struct field *vcdb_fields[] = {
+	&YCbCr_quantization,
+	&RGB_quantization,
+	&PT_scan,
+	&IT_scan,
+	&CE_scan,
+};
+
+static void text_cta_sadb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	uint32_t sad;
+	int i;
+
+	if (length < 3)
+		return;
+
+	sad = ((x[2] << 16) | (x[1] << 8) | x[0]);
+
+	out_printf(out, "    Speaker map:\n");
+
+	for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
+		if ((sad >> i) & 1)
+			out_printf(out, "      %s\n", speaker_map[i]);
+	}
+}
+
+/* A signed 2.6 fixed point value */
+static float decode_uchar_as_float(unsigned char x)
+{
+	signed char s = (signed char)x;
+
+	return s / 64.0;
+}
+
+static void text_cta_rcdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	uint32_t spm = ((x[3] << 16) | (x[2] << 8) | x[1]);
+	int i;
+
+	if (length < 4)
+		return;
+
+	if (x[0] & 0x40)
+		out_printf(out, "    Speaker count: %d\n", (x[0] & 0x1f) + 1);
+
+	out_printf(out, "    Speaker Presence Mask:\n");
+	for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
+		if ((spm >> i) & 1)
+			out_printf(out, "      %s\n", speaker_map[i]);
+	}
+	if ((x[0] & 0x20) && length >= 7) {
+		out_printf(out, "    Xmax: %d dm\n", x[4]);
+		out_printf(out, "    Ymax: %d dm\n", x[5]);
+		out_printf(out, "    Zmax: %d dm\n", x[6]);
+	}
+	if ((x[0] & 0x80) && length >= 10) {
+		out_printf(out, "    DisplayX: %.3f * Xmax\n", decode_uchar_as_float(x[7]));
+		out_printf(out, "    DisplayY: %.3f * Ymax\n", decode_uchar_as_float(x[8]));
+		out_printf(out, "    DisplayZ: %.3f * Zmax\n", decode_uchar_as_float(x[9]));
+	}
+}
+
+static const char *speaker_location[] = {
+	"FL - Front Left",
+	"FR - Front Right",
+	"FC - Front Center",
+	"LFE1 - Low Frequency Effects 1",
+	"BL - Back Left",
+	"BR - Back Right",
+	"FLC - Front Left of Center",
+	"FRC - Front Right of Center",
+	"BC - Back Center",
+	"LFE2 - Low Frequency Effects 2",
+	"SiL - Side Left",
+	"SiR - Side Right",
+	"TpFL - Top Front Left",
+	"TpFR - Top Front Right",
+	"TpFC - Top Front Center",
+	"TpC - Top Center",
+	"TpBL - Top Back Left",
+	"TpBR - Top Back Right",
+	"TpSiL - Top Side Left",
+	"TpSiR - Top Side Right",
+	"TpBC - Top Back Center",
+	"BtFC - Bottom Front Center",
+	"BtFL - Bottom Front Left",
+	"BtFR - Bottom Front Right",
+	"FLW - Front Left Wide",
+	"FRW - Front Right Wide",
+	"LS - Left Surround",
+	"RS - Right Surround",
+};
+
+static void text_cta_sldb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	while (length >= 2) {
+		out_printf(out, "    Channel: %d (%sactive)\n", x[0] & 0x1f,
+				  (x[0] & 0x20) ? "" : "not ");
+		if ((x[1] & 0x1f) < ARRAY_SIZE(speaker_location))
+			out_printf(out, "      Speaker: %s\n", speaker_location[x[1] & 0x1f]);
+		if (length >= 5 && (x[0] & 0x40)) {
+			out_printf(out, "      X: %.3f * Xmax\n", decode_uchar_as_float(x[2]));
+			out_printf(out, "      Y: %.3f * Ymax\n", decode_uchar_as_float(x[3]));
+			out_printf(out, "      Z: %.3f * Zmax\n", decode_uchar_as_float(x[4]));
+			length -= 3;
+			x += 3;
+		}
+
+		length -= 2;
+		x += 2;
+	}
+}
+
+static void text_cta_vcdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	decode(out, vcdb_fields, x[0], "    ");
+}
+
+static void text_cta_colorimetry_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int i;
+
+	if (length >= 2) {
+		for (i = 0; i < ARRAY_SIZE(colorimetry_map); i++) {
+			if (x[0] & (1 << i))
+				out_printf(out, "    %s\n", colorimetry_map[i]);
+		}
+		if (x[1] & 0x80)
+			out_printf(out, "    DCI-P3\n");
+		if (x[1] & 0x40)
+			out_printf(out, "    ICtCp\n");
+	}
+}
+
+static const char *eotf_map[] = {
+	"Traditional gamma - SDR luminance range",
+	"Traditional gamma - HDR luminance range",
+	"SMPTE ST2084",
+	"Hybrid Log-Gamma",
+};
+
+static void text_cta_hdr_static_metadata_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int i;
+
+	if (length >= 2) {
+		out_printf(out, "    Electro optical transfer functions:\n");
+		for (i = 0; i < 6; i++) {
+			if (x[0] & (1 << i)) {
+				out_printf(out, "      %s\n", i < ARRAY_SIZE(eotf_map) ?
+						  eotf_map[i] : "Unknown");
+			}
+		}
+		out_printf(out, "    Supported static metadata descriptors:\n");
+		for (i = 0; i < 8; i++) {
+			if (x[1] & (1 << i))
+				out_printf(out, "      Static metadata type %d\n", i + 1);
+		}
+	}
+
+	if (length >= 3)
+		out_printf(out, "    Desired content max luminance: %d (%.3f cd/m^2)\n",
+				  x[2], 50.0 * pow(2, x[2] / 32.0));
+
+	if (length >= 4)
+		out_printf(out, "    Desired content max frame-average luminance: %d (%.3f cd/m^2)\n",
+				  x[3], 50.0 * pow(2, x[3] / 32.0));
+
+	if (length >= 5)
+		out_printf(out, "    Desired content min luminance: %d (%.3f cd/m^2)\n",
+				  x[4], (50.0 * pow(2, x[2] / 32.0)) * pow(x[4] / 255.0, 2) / 100.0);
+}
+
+static void text_cta_hdr_dyn_metadata_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	while (length >= 3) {
+		int type_len = x[0];
+		int type = x[1] | (x[2] << 8);
+
+		if (length < type_len + 1)
+			return;
+		out_printf(out, "    HDR Dynamic Metadata Type %d\n", type);
+		switch (type) {
+		case 1:
+		case 2:
+		case 4:
+			if (type_len > 2)
+				out_printf(out, "      Version: %d\n", x[3] & 0xf);
+			break;
+		default:
+			break;
+		}
+		length -= type_len + 1;
+		x += type_len + 1;
+	}
+}
+
+static void text_cta_ifdb(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int len_hdr = x[0] >> 5;
+
+	if (length < 2)
+		return;
+	out_printf(out, "    VSIFs: %d\n", x[1]);
+	if (length < len_hdr + 2)
+		return;
+	length -= len_hdr + 2;
+	x += len_hdr + 2;
+	while (length > 0) {
+		int payload_len = x[0] >> 5;
+
+		if ((x[0] & 0x1f) == 1 && length >= 4) {
+			out_printf(out, "    InfoFrame Type Code %d IEEE OUI: %02x%02x%02x\n",
+					  x[0] & 0x1f, x[3], x[2], x[1]);
+			x += 4;
+			length -= 4;
+		} else {
+			out_printf(out, "    InfoFrame Type Code %d\n", x[0] & 0x1f);
+			x++;
+			length--;
+		}
+		/* a payload running past the block ends the list */
+		if (length < payload_len)
+			break;
+		x += payload_len;
+		length -= payload_len;
+	}
+}
+
+static void text_cta_hdmi_audio_block(struct text_out *out, const unsigned char *x, unsigned int length)
+{
+	int num_descs;
+
+	if (length < 2)
+		return;
+	if (x[0] & 3)
+		out_printf(out, "    Max Stream Count: %d\n", (x[0] & 3) + 1);
+	if (x[0] & 4)
+		out_printf(out, "    Supports MS NonMixed\n");
+
+	num_descs = x[1] & 7;
+	if (num_descs == 0)
+		return;
+	length -= 2;
+	x += 2;
+	while (length >= 4) {
+		if (length > 4) {
+			int format = x[0] & 0xf;
+
+			out_printf(out, "    %s, max channels %d\n", audio_format(format),
+					  (x[1] & 0x1f)+1);
+			out_printf(out, "      Supported sample rates (kHz):%s%s%s%s%s%s%s\n",
+					  (x[2] & 0x40) ? " 192" : "",
+					  (x[2] & 0x20) ? " 176.4" : "",
+					  (x[2] & 0x10) ? " 96" : "",
+					  (x[2] & 0x08) ? " 88.2" : "",
+					  (x[2] & 0x04) ? " 48" : "",
+					  (x[2] & 0x02) ? " 44.1" : "",
+					  (x[2] & 0x01) ? " 32" : "");
+			if (format == 1)
+				out_printf(out, "      Supported sample sizes (bits):%s%s%s\n",
+						  (x[3] & 0x04) ? " 24" : "",
+						  (x[3] & 0x02) ? " 20" : "",
+						  (x[3] & 0x01) ? " 16" : "");
+		} else {
+			uint32_t sad = ((x[2] << 16) | (x[1] << 8) | x[0]);
+			int i;
+
+			switch (x[3] >> 4) {
+			case 1:
+				out_printf(out, "    Speaker Allocation for 10.2 channels:\n");
+				break;
+			case 2:
+				out_printf(out, "    Speaker Allocation for 22.2 channels:\n");
+				break;
+			case 3:
+				out_printf(out, "    Speaker Allocation for 30.2 channels:\n");
+				break;
+			default:
+				out_printf(out, "    Unknown Speaker Allocation (%d)\n", x[3] >> 4);
+				return;
+			}
+
+			for (i = 0; i < ARRAY_SIZE(speaker_map); i++) {
+				if ((sad >> i) & 1)
+					out_printf(out, "      %s\n", speaker_map[i]);
+			}
+		}
+		length -= 4;
+		x += 4;
+	}
+}
+
+static void text_cta_block(struct text_out *out, const unsigned char *x)
+{
+	unsigned int length = x[0] & 0x1f;
+	unsigned int oui;
+
+	switch ((x[0] & 0xe0) >> 5) {
+	case 0x01:
+		out_printf(out, "  Audio Data Block\n");
+		text_cta_audio_block(out, x + 1, length);
+		break;
+	case 0x02:
+		out_printf(out, "  Video Data Block\n");
+		text_cta_video_block(out, x + 1, length);
+		break;
+	case 0x03:
+		oui = (x[3] << 16) + (x[2] << 8) + x[1];
+		out_printf(out, "  Vendor-Specific Data Block, OUI %06x", oui);
+		if (oui == EDID_OUI_HDMI) {
+			text_cta_hdmi_block(out, x + 1, length);
+			return;
+		}
+		if (oui == EDID_OUI_HDMI_FORUM) {
+			out_printf(out, " (HDMI Forum)\n");
+			text_cta_hf_scdb(out, x + 4, length - 3);
+		} else {
+			out_printf(out, "\n");
+		}
+		break;
+	case 0x04:
+		out_printf(out, "  Speaker Allocation Data Block\n");
+		text_cta_sadb(out, x + 1, length);
+		break;
+	case 0x05:
+		out_printf(out, "  VESA DTC Data Block\n");
+		break;
+	case 0x07:
+		out_printf(out, "  Extended tag: ");
+		switch (x[1]) {
+		case 0x00:
+			out_printf(out, "Video Capability Data Block\n");
+			text_cta_vcdb(out, x + 2, length - 1);
+			break;
+		case 0x01:
+			oui = (x[4] << 16) + (x[3] << 8) + x[2];
+			out_printf(out, "Vendor-Specific Video Data Block, OUI %06x", oui);
+			if (oui == EDID_OUI_HDR10PLUS) {
+				out_printf(out, " (HDR10+)\n");
+				text_cta_hdr10plus(out, x + 5, length - 4);
+			} else {
+				out_printf(out, "\n");
+			}
+			break;
+		case 0x02:
+			out_printf(out, "VESA Video Display Device Data Block\n");
+			break;
+		case 0x03:
+			out_printf(out, "VESA Video Timing Block Extension\n");
+			break;
+		case 0x04:
+			out_printf(out, "Reserved for HDMI Video Data Block\n");
+			break;
+		case 0x05:
+			out_printf(out, "Colorimetry Data Block\n");
+			text_cta_colorimetry_block(out, x + 2, length - 1);
+			break;
+		case 0x06:
+			out_printf(out, "HDR Static Metadata Data Block\n");
+			text_cta_hdr_static_metadata_block(out, x + 2, length - 1);
+			break;
+		case 0x07:
+			out_printf(out, "HDR Dynamic Metadata Data Block\n");
+			text_cta_hdr_dyn_metadata_block(out, x + 2, length - 1);
+			break;
+		case 0x0d:
+			out_printf(out, "Video Format Preference Data Block\n");
+			text_cta_vfpdb(out, x + 2, length - 1);
+			break;
+		case 0x0e:
+			out_printf(out, "YCbCr 4:2:0 Video Data Block\n");
+			text_cta_y420vdb(out, x + 2, length - 1);
+			break;
+		case 0x0f:
+			out_printf(out, "YCbCr 4:2:0 Capability Map Data Block\n");
+			text_cta_y420cmdb(out, x + 2, length - 1);
+			break;
+		case 0x10:
+			out_printf(out, "Reserved for CTA Miscellaneous Audio Fields\n");
+			break;
+		case 0x11:
+			out_printf(out, "Vendor-Specific Audio Data Block\n");
+			break;
+		case 0x12:
+			out_printf(out, "HDMI Audio Data Block\n");
+			text_cta_hdmi_audio_block(out, x + 2, length - 1);
+			break;
+		case 0x13:
+			out_printf(out, "Room Configuration Data Block\n");
+			text_cta_rcdb(out, x + 2, length - 1);
+			break;
+		case 0x14:
+			out_printf(out, "Speaker Location Data Block\n");
+			text_cta_sldb(out, x + 2, length - 1);
+			break;
+		case 0x20:
+			out_printf(out, "InfoFrame Data Block\n");
+			text_cta_ifdb(out, x + 2, length - 1);
+			break;
+		case 0x78:
+			out_printf(out, "HDMI Forum EDID Extension Override Data Block\n");
+			text_cta_hf_eeodb(out, x + 2, length - 1);
+			break;
+		case 0x79:
+			out_printf(out, "HDMI Forum Sink Capability Data Block\n");
+			if (x[2] || x[3])
+				out_printf(out, "  Non-zero SCDB reserved fields!\n");
+			text_cta_hf_scdb(out, x + 4, length - 3);
+			break;
+		default:
+			if (x[1] >= 6 && x[1] <= 12)
+				out_printf(out, "Reserved for video-related blocks (%02x)\n", x[1]);
+			else if (x[1] >= 19 && x[1] <= 31)
+				out_printf(out, "Reserved for audio-related blocks (%02x)\n", x[1]);
+			else
+				out_printf(out, "Reserved (%02x)\n", x[1]);
+			break;
+		}
+		break;
+	default: {
+		int tag = (*x & 0xe0) >> 5;
+		int length = *x & 0x1f;
+		out_printf(out, "  Unknown tag %d, length %d (raw %02x)\n", tag, length, *x);
+		break;
+	}
+	}
+}
+
+static void text_cta(struct text_out *out, const unsigned char *x)
+{
+	int version = x[1];
+	int offset = x[2];
+	const unsigned char *detailed;
+
+	if (version >= 1 && offset >= 4) {
+		if (version < 3)
+			out_printf(out, "%d 8-byte timing descriptors\n\n", (offset - 4) / 8);
+
+		if (version >= 2) {
+			if (x[3] & 0x80)
+				out_printf(out, "Underscans PC formats by default\n");
+			if (x[3] & 0x40)
+				out_printf(out, "Basic audio support\n");
+			if (x[3] & 0x20)
+				out_printf(out, "Supports YCbCr 4:4:4\n");
+			if (x[3] & 0x10)
+				out_printf(out, "Supports YCbCr 4:2:2\n");
+			out_printf(out, "%d native detailed modes\n\n", x[3] & 0x0f);
+		}
+		if (version == 3) {
+			int i;
+
+			out_printf(out, "%d bytes of CTA data\n", offset - 4);
+			for (i = 4; i < offset; i += (x[i] & 0x1f) + 1)
+				text_cta_block(out, x + i);
+			out_printf(out, "\n");
+		}
+
+		for (detailed = x + offset; detailed + 18 < x + 127; detailed += 18)
+			if (detailed[0])
+				text_detailed_block(out, detailed);
+	}
+
+	text_checksum(out, x, EDID_PAGE_SIZE);
+}
+
+static void text_displayid_detailed_timing(struct text_out *out, const unsigned char *x)
+{
+	int ha, hbl, hso, hspw;
+	int va, vbl, vso, vspw;
+	char phsync, pvsync, *stereo;
+	int pix_clock;
+	char *aspect;
+
+	switch (x[3] & 0xf) {
+	case 0:
+		aspect = "1:1";
+		break;
+	case 1:
+		aspect = "5:4";
+		break;
+	case 2:
+		aspect = "4:3";
+		break;
+	case 3:
+		aspect = "15:9";
+		break;
+	case 4:
+		aspect = "16:9";
+		break;
+	case 5:
+		aspect = "16:10";
+		break;
+	case 6:
+		aspect = "64:27";
+		break;
+	case 7:
+		aspect = "256:135";
+		break;
+	default:
+		aspect = "undefined";
+		break;
+	}
+	switch ((x[3] >> 5) & 0x3) {
+	case 0:
+		stereo = ", no 3D stereo";
+		break;
+	case 1:
+		stereo = ", 3D stereo";
+		break;
+	case 2:
+		stereo = ", 3D stereo depends on user action";
+		break;
+	case 3:
+		stereo = ", reserved";
+		break;
+	}
+	out_printf(out, "  Aspect %s%s%s\n", aspect, x[3] & 0x80 ? ", preferred" : "", stereo);
+	pix_clock = x[0] + (x[1] << 8) + (x[2] << 16);
+	ha = x[4] | (x[5] << 8);
+	hbl = x[6] | (x[7] << 8);
+	hso = x[8] | ((x[9] & 0x7f) << 8);
+	phsync = ((x[9] >> 7) & 0x1) ? '+' : '-';
+	hspw = x[10] | (x[11] << 8);
+	va = x[12] | (x[13] << 8);
+	vbl = x[14] | (x[15] << 8);
+	vso = x[16] | ((x[17] & 0x7f) << 8);
+	vspw = x[18] | (x[19] << 8);
+	pvsync = ((x[17] >> 7) & 0x1 ) ? '+' : '-';
+
+	out_printf(out, "  Detailed mode: Clock %.3f MHz, %d mm x %d mm\n"
+			  "                 %4d %4d %4d %4d\n"
+			  "                 %4d %4d %4d %4d\n"
+			  "                 %chsync %cvsync\n",
+			  (float)pix_clock/100.0, 0, 0,
+			  ha, ha + hso, ha + hso + hspw, ha + hbl,
+			  va, va + vso, va + vso + vspw, va + vbl,
+			  phsync, pvsync
+		  );
+}
+
+static void text_displayid(struct text_out *out, const unsigned char *x)
+{
+	const unsigned char *orig = x;
+	int version = x[1];
+	int length = x[2];
+	int ext_count = x[4];
+	const char *name;
+	int i;
+
+	out_printf(out, "Length %d, version %u.%u, extension count %d\n",
+			  length, version >> 4, version & 0xf, ext_count);
+
+	int offset = 5;
+	while (length > 0) {
+		int tag = x[offset];
+		int len = x[offset + 2];
+
+		if (len == 0)
+			break;
+		switch (tag) {
+		case 3:
+			out_printf(out, "%s\n", displayid_block_name(tag));
+			for (i = 0; i < len / 20; i++)
+				text_displayid_detailed_timing(out, &x[offset + 3 + (i * 20)]);
+			break;
+		case 7:
+			out_printf(out, "%s\n", displayid_block_name(tag));
+			for (i = 0; i < min(len, 10) * 8; i++) {
+				if (x[offset + 3 + i / 8] & (1 << (i % 8)))
+					text_db_timing(out, dmt_timing(i + 1));
+			}
+			break;
+		case 0x12: {
+			int capabilities = x[offset + 3];
+			int num_v_tile = (x[offset + 4] & 0xf) | (x[offset + 6] & 0x30);
+			int num_h_tile = (x[offset + 4] >> 4) | ((x[offset + 6] >> 2) & 0x30);
+			int tile_v_location = (x[offset + 5] & 0xf) | ((x[offset + 6] & 0x3) << 4);
+			int tile_h_location = (x[offset + 5] >> 4) | (((x[offset + 6] >> 2) & 0x3) << 4);
+			int tile_width = x[offset + 7] | (x[offset + 8] << 8);
+			int tile_height = x[offset + 9] | (x[offset + 10] << 8);
+			int pix_mult = x[offset + 11];
+
+			out_printf(out, "%s\n", displayid_block_name(tag));
+			out_printf(out, "  Capabilities: 0x%08x\n", capabilities);
+			out_printf(out, "  Num horizontal tiles: %d Num vertical tiles: %d\n", num_h_tile + 1, num_v_tile + 1);
+			out_printf(out, "  Tile location: %d, %d\n", tile_h_location, tile_v_location);
+			out_printf(out, "  Tile resolution: %dx%d\n", tile_width + 1, tile_height + 1);
+			if (capabilities & 0x40) {
+				if (pix_mult) {
+					out_printf(out, "  Top bevel size: %d pixels\n",
+							  pix_mult * x[offset + 12] / 10);
+					out_printf(out, "  Bottom bevel size: %d pixels\n",
+							  pix_mult * x[offset + 13] / 10);
+					out_printf(out, "  Right bevel size: %d pixels\n",
+							  pix_mult * x[offset + 14] / 10);
+					out_printf(out, "  Left bevel size: %d pixels\n",
+							  pix_mult * x[offset + 15] / 10);
+				}
+				out_printf(out, "  Tile resolution: %dx%d\n", tile_width + 1, tile_height + 1);
+			}
+			break;
+		}
+		default:
+			name = displayid_block_name(tag);
+			if (name)
+				out_printf(out, "%s\n", name);
+			else
+				out_printf(out, "Unknown DisplayID Data Block 0x%x\n", tag);
+			break;
+		}
+		length -= len + 3;
+		offset += len + 3;
+	}
+
+	/* DisplayID length field is number of following bytes
+	 * but checksum is calculated over the entire structure
+	 * (excluding DisplayID-in-EDID magic byte)
+	 */
+	text_checksum(out, orig+1, orig[2] + 5);
+}
+
+/* generic extension code */
+
+static void text_extension_version(struct text_out *out, const unsigned char *x)
+{
+	out_printf(out, "Extension version: %d\n", x[1]);
+}
+
+static void text_extension(struct text_out *out, const unsigned char *x)
+{
+	out_printf(out, "\n");
+
+	switch(x[0]) {
+	case 0x02:
+		out_printf(out, "CTA Extension Block\n");
+		text_extension_version(out, x);
+		text_cta(out, x);
+		break;
+	case 0x10: out_printf(out, "VTB Extension Block\n"); break;
+	case 0x40: out_printf(out, "DI Extension Block\n"); break;
+	case 0x50: out_printf(out, "LS Extension Block\n"); break;
+	case 0x60: out_printf(out, "DPVL Extension Block\n"); break;
+	case 0x70: out_printf(out, "DisplayID Extension Block\n");
+		   text_displayid(out, x);
+		   break;
+	case 0xF0: out_printf(out, "Block map\n"); break;
+	case 0xFF: out_printf(out, "Manufacturer-specific Extension Block\n");
+	default:
+		   out_printf(out, "Unknown Extension Block\n");
+		   break;
+	}
+}
+
+static void text_subsection(struct text_out *out, char *name, const unsigned char *edid, int start,
+						       int end)
+{
+	int i;
+
+	out_printf(out, "%s:", name);
+	for (i = strlen(name); i < 15; i++)
+		out_printf(out, " ");
+	for (i = start; i <= end; i++)
+		out_printf(out, " %02x", edid[i]);
+	out_printf(out, "\n");
+}
+
+static void text_breakdown(struct text_out *out, const unsigned char *edid)
+{
+	out_printf(out, "Extracted contents:\n");
+	text_subsection(out, "header", edid, 0, 7);
+	text_subsection(out, "serial number", edid, 8, 17);
+	text_subsection(out, "version", edid,18, 19);
+	text_subsection(out, "basic params", edid, 20, 24);
+	text_subsection(out, "chroma info", edid, 25, 34);
+	text_subsection(out, "established", edid, 35, 37);
+	text_subsection(out, "standard", edid, 38, 53);
+	text_subsection(out, "descriptor 1", edid, 54, 71);
+	text_subsection(out, "descriptor 2", edid, 72, 89);
+	text_subsection(out, "descriptor 3", edid, 90, 107);
+	text_subsection(out, "descriptor 4", edid, 108, 125);
+	text_subsection(out, "extensions", edid, 126, 126);
+	text_subsection(out, "checksum", edid, 127, 127);
+	out_printf(out, "\n");
+}
+
+
+static void text_base(struct text_out *out, const unsigned char *edid)
+{
+	const struct edid_base *base = &out->info->base;
+	int analog, i;
+	unsigned col_x, col_y;
+
+	out_printf(out, "EDID version: %hd.%hd\n", edid[0x12], edid[0x13]);
+	if (edid[0x12] == 1 && edid[0x13] > 4)
+		out_printf(out, "Claims > 1.4, assuming 1.4 conformance\n");
+
+	out_printf(out, "Manufacturer: %s Model %x Serial Number %u\n",
+			base->manufacturer, base->product, base->serial);
+
+	if (base->valid_year) {
+		if (edid[0x10] == 0xff)
+			out_printf(out, "Model year %hd\n", edid[0x11] + 1990);
+		else if (edid[0x10])
+			out_printf(out, "Made in week %hd of %hd\n", edid[0x10], edid[0x11] + 1990);
+		else
+			out_printf(out, "Made in year %hd\n", edid[0x11] + 1990);
+	}
+
+	/* display section */
+
+	if (edid[0x14] & 0x80) {
+		analog = 0;
+		out_printf(out, "Digital display\n");
+		if (out->minor >= 4) {
+			if ((edid[0x14] & 0x70) == 0x00)
+				out_printf(out, "Color depth is undefined\n");
+			else if ((edid[0x14] & 0x70) != 0x70)
+				out_printf(out, "%d bits per primary color channel\n",
+						((edid[0x14] & 0x70) >> 3) + 4);
+
+			switch (edid[0x14] & 0x0f) {
+			case 0x00: out_printf(out, "Digital interface is not defined\n"); break;
+			case 0x01: out_printf(out, "DVI interface\n"); break;
+			case 0x02: out_printf(out, "HDMI-a interface\n"); break;
+			case 0x03: out_printf(out, "HDMI-b interface\n"); break;
+			case 0x04: out_printf(out, "MDDI interface\n"); break;
+			case 0x05: out_printf(out, "DisplayPort interface\n"); break;
+			}
+		} else if (out->minor >= 2 && (edid[0x14] & 0x01)) {
+			out_printf(out, "DFP 1.x compatible TMDS\n");
+		}
+	} else {
+		analog = 1;
+		int voltage = (edid[0x14] & 0x60) >> 5;
+		int sync = (edid[0x14] & 0x0F);
+		out_printf(out, "Analog display, Input voltage level: %s V\n",
+				voltage == 3 ? "0.7/0.7" :
+				voltage == 2 ? "1.0/0.4" :
+				voltage == 1 ? "0.714/0.286" :
+				"0.7/0.3");
+
+		if (out->minor >= 4) {
+			if (edid[0x14] & 0x10)
+				out_printf(out, "Blank-to-black setup/pedestal\n");
+			else
+				out_printf(out, "Blank level equals black level\n");
+		} else if (edid[0x14] & 0x10) {
+			/*
+			 * XXX this is just the X text.  1.3 says "if set, display expects
+			 * a blank-to-black setup or pedestal per appropriate Signal
+			 * Level Standard".  Whatever _that_ means.
+			 */
+			out_printf(out, "Configurable signal levels\n");
+		}
+
+		out_printf(out, "Sync: %s%s%s%s\n", sync & 0x08 ? "Separate " : "",
+				sync & 0x04 ? "Composite " : "",
+				sync & 0x02 ? "SyncOnGreen " : "",
+				sync & 0x01 ? "Serration " : "");
+	}
+
+	if (edid[0x15] && edid[0x16])
+		out_printf(out, "Maximum image size: %d cm x %d cm\n", edid[0x15], edid[0x16]);
+	else if (out->minor >= 4 && (edid[0x15] || edid[0x16])) {
+		if (edid[0x15])
+			out_printf(out, "Aspect ratio is %f (landscape)\n", 100.0/(edid[0x16] + 99));
+		else
+			out_printf(out, "Aspect ratio is %f (portrait)\n", 100.0/(edid[0x15] + 99));
+	} else {
+		/* Either or both can be zero for 1.3 and before */
+		out_printf(out, "Image size is variable\n");
+	}
+
+	if (edid[0x17] == 0xff) {
+		if (out->minor >= 4)
+			out_printf(out, "Gamma is defined in an extension block\n");
+		else
+			/* XXX Technically 1.3 doesn't say this... */
+			out_printf(out, "Gamma: 1.0\n");
+	} else out_printf(out, "Gamma: %.2f\n", ((edid[0x17] + 100.0) / 100.0));
+
+	if (edid[0x18] & 0xE0) {
+		out_printf(out, "DPMS levels:");
+		if (edid[0x18] & 0x80) out_printf(out, " Standby");
+		if (edid[0x18] & 0x40) out_printf(out, " Suspend");
+		if (edid[0x18] & 0x20) out_printf(out, " Off");
+		out_printf(out, "\n");
+	}
+
+	if (analog || out->minor < 4) {
+		switch (edid[0x18] & 0x18) {
+		case 0x00: out_printf(out, "Monochrome or grayscale display\n"); break;
+		case 0x08: out_printf(out, "RGB color display\n"); break;
+		case 0x10: out_printf(out, "Non-RGB color display\n"); break;
+		case 0x18: out_printf(out, "Undefined display color type\n");
+		}
+	} else {
+		out_printf(out, "Supported color formats: RGB 4:4:4");
+		if (edid[0x18] & 0x08)
+			out_printf(out, ", YCrCb 4:4:4");
+		if (edid[0x18] & 0x10)
+			out_printf(out, ", YCrCb 4:2:2");
+		out_printf(out, "\n");
+	}
+
+	if (edid[0x18] & 0x04)
+		out_printf(out, "Default (sRGB) color space is primary color space\n");
+	if (edid[0x18] & 0x02) {
+		if (out->minor >= 4)
+			out_printf(out, "First detailed timing includes the native pixel format and preferred refresh rate\n");
+		else
+			out_printf(out, "First detailed timing is preferred timing\n");
+	}
+
+	if (edid[0x18] & 0x01) {
+		if (out->minor >= 4)
+			out_printf(out, "Display is continuous frequency\n");
+		else
+			out_printf(out, "Supports GTF timings within operating range\n");
+	}
+
+	out_printf(out, "Display x,y Chromaticity:\n");
+	col_x = (edid[0x1b] << 2) | (edid[0x19] >> 6);
+	col_y = (edid[0x1c] << 2) | ((edid[0x19] >> 4) & 3);
+	out_printf(out, "  Red:   0.%04u, 0.%04u\n",
+			(col_x * 10000) / 1024, (col_y * 10000) / 1024);
+	col_x = (edid[0x1d] << 2) | ((edid[0x19] >> 2) & 3);
+	col_y = (edid[0x1e] << 2) | (edid[0x19] & 3);
+	out_printf(out, "  Green: 0.%04u, 0.%04u\n",
+			(col_x * 10000) / 1024, (col_y * 10000) / 1024);
+	col_x = (edid[0x1f] << 2) | (edid[0x1a] >> 6);
+	col_y = (edid[0x20] << 2) | ((edid[0x1a] >> 4) & 3);
+	out_printf(out, "  Blue:  0.%04u, 0.%04u\n",
+			(col_x * 10000) / 1024, (col_y * 10000) / 1024);
+	col_x = (edid[0x21] << 2) | ((edid[0x1a] >> 2) & 3);
+	col_y = (edid[0x22] << 2) | (edid[0x1a] & 3);
+	out_printf(out, "  White: 0.%04u, 0.%04u\n",
+			(col_x * 10000) / 1024, (col_y * 10000) / 1024);
+
+	out_printf(out, "Established timings supported:\n");
+	for (i = 0; i < 17; i++) {
+		if (edid[0x23 + i / 8] & (1 << (7 - i % 8)))
+			text_db_timing(out, &timing_db[established_timings[i]]);
+	}
+
+	out_printf(out, "Standard timings supported:\n");
+	for (i = 0; i < 8; i++)
+		text_standard_timing(out, edid + 0x26 + i * 2);
+
+	for (i = 0; i < 4; i++)
+		text_detailed_block(out, edid + 0x36 + i * 18);
+
+	if (edid[0x7e])
+		out_printf(out, "Has %d extension blocks\n", edid[0x7e]);
+
+	text_checksum(out, edid, EDID_PAGE_SIZE);
+}
+
+static const struct check_rule *finding_rule(const struct edid_info *info,
+					     const struct edid_finding *f)
+{
+	unsigned version = edid_version_class(&info->base);
+	unsigned i;
+
+	for (i = 0; i < ARRAY_SIZE(check_rules); i++) {
+		const struct check_rule *rule = &check_rules[i];
+
+		if (rule->code == f->code && (rule->versions & version) &&
+		    !strcmp(check_groups[rule->group].block, f->block))
+			return rule;
+	}
+	return NULL;
+}
+
+/*
+ * The conformance report: the failed rules group by group, as run_checks()
+ * found them, then the warnings recorded while decoding.
+ */
+static void text_checks(struct text_out *out)
+{
+	const struct edid_info *info = out->info;
+	unsigned i = 0, j;
+
+	out_printf(out, "\n----------------\n\n");
+
+	while (i < info->num_findings) {
+		const struct check_rule *rule = NULL;
+		const struct check_group *group;
+		unsigned g, end;
+		int fatal = 0;
+
+		if (info->findings[i].code >= EDID_FINDING_SRGB_CHROMATICITY)
+			rule = finding_rule(info, &info->findings[i]);
+		if (!rule) {
+			i++;
+			continue;
+		}
+		g = rule->group;
+		group = &check_groups[g];
+		for (end = i; end < info->num_findings; end++) {
+			const struct check_rule *r = NULL;
+
+			if (info->findings[end].code >= EDID_FINDING_SRGB_CHROMATICITY)
+				r = finding_rule(info, &info->findings[end]);
+			if (!r || r->group != g)
+				break;
+			if (!(r->flags & (RULE_NOT_FATAL | RULE_WARNING)))
+				fatal = 1;
+		}
+
+		if (group->header && (fatal || (group->flags & GROUP_HEADER_ON_ISSUE)))
+			out_printf(out, group->header, out->minor);
+		for (; i < end; i++) {
+			const struct edid_finding *f = &info->findings[i];
+
+			rule = finding_rule(info, f);
+			out_printf(out, "%s", rule->flags & RULE_WARNING ?
+				   "Warning: " : group->prefix);
+			out_printf(out, rule->message, f->value);
+			if (rule->details)
+				rule->details(out);
+		}
+	}
+
+	for (j = 0; j < info->num_findings; j++)
+		if (info->findings[j].code < EDID_FINDING_SRGB_CHROMATICITY)
+			out_printf(out, "%s: %s\n", info->findings[j].block,
+				   info->findings[j].message);
+	if (info->truncated & EDID_INFO_TRUNC_FINDINGS)
+		out_printf(out, "...\n");
+	if (info->conformant == 1)
+		out_printf(out, "No issues found\n");
+}
+
+static void emit_text(FILE *f, const struct edid_info *info)
+{
+	struct text_out out = { .info = info };
+	unsigned i;
+
+	if (info->base.version == 1)
+		out.minor = min(info->base.revision, 4);
+	if ((info->flags & EDID_DECODE_EXTRACT) && info->buf)
+		text_breakdown(&out, info->buf);
+	if (info->size) {
+		text_base(&out, info->buf);
+		for (i = 1; i < info->num_blocks; i++) {
+			out_printf(&out, "\n----------------\n");
+			text_extension(&out, info->buf + i * EDID_PAGE_SIZE);
+		}
+		if (info->flags & EDID_DECODE_CHECK)
+			text_checks(&out);
+	}
+	if (out.len)
+		fwrite(out.buf, 1, out.len, f);
+	free(out.buf);
+}
+
+static void emit_timings(FILE *f, const struct edid_info *info)
+{
+	unsigned i;
+
+	for (i = 0; i < info->num_timings; i++) {
+		const struct edid_timing *t = &info->timings[i];
+		int interlaced = t->flags & EDID_TIMING_INTERLACED;
+		/* EDID detailed timings give the vertical values per field */
+		unsigned fields = interlaced && t->source != EDID_SRC_DISPLAYID ? 2 : 1;
+		unsigned hss = t->hact + t->hfp;
+		unsigned vss = t->vact + t->vfp;
+
+		fprintf(f, "Modeline \"%ux%u%s\" %u.%03u %u %u %u %u %u %u %u %u %chsync %cvsync%s\n",
+			t->hact, t->vact * fields, interlaced ? "i" : "",
+			t->pixclk_khz / 1000, t->pixclk_khz % 1000,
+			t->hact, hss, hss + t->hsync, hss + t->hsync + t->hbp,
+			t->vact * fields, vss * fields, (vss + t->vsync) * fields,
+			(vss + t->vsync + t->vbp) * fields,
+			t->flags & EDID_TIMING_PHSYNC ? '+' : '-',
+			t->flags & EDID_TIMING_PVSYNC ? '+' : '-',
+			interlaced ? " Interlace" : "");
+	}
+}
+
+static void emit_findings(FILE *f, const struct edid_info *info)
+{
+	unsigned i;
+
+	for (i = 0; i < info->num_findings; i++) {
+		const struct edid_finding *finding = &info->findings[i];
+
+		fprintf(f, "%s: %s: %s\n",
+			finding->severity == EDID_SEV_ERROR ? "error" : "warning",
+			finding->block, finding->message);
+	}
+}
+
+/*
+ * JSON writer. Output is collected in a fixed buffer that is written out
+ * whenever it fills up, so a document costs a handful of fwrite() calls
+ * and no allocations. Numbers are formatted by hand, which also keeps the
+ * output independent of the locale.
+ */
+struct json_writer {
+	FILE *f;
+	unsigned len;
+	unsigned depth;
+	uint64_t need_comma;	/* one bit per nesting level */
+	char buf[4096];
+};
+
+static void jw_flush(struct json_writer *w)
+{
+	fwrite(w->buf, 1, w->len, w->f);
+	w->len = 0;
+}
+
+static void jw_putc(struct json_writer *w, char c)
+{
+	if (w->len == sizeof(w->buf))
+		jw_flush(w);
+	w->buf[w->len++] = c;
+}
+
+static void jw_puts(struct json_writer *w, const char *s)
+{
+	while (*s)
+		jw_putc(w, *s++);
+}
+
+static void jw_string(struct json_writer *w, const char *s)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	jw_putc(w, '"');
+	for (; *s; s++) {
+		unsigned char c = *s;
+
+		if (c == '"' || c == '\\') {
+			jw_putc(w, '\\');
+			jw_putc(w, c);
+		} else if (c == '\n') {
+			jw_puts(w, "\\n");
+		} else if (c == '\t') {
+			jw_puts(w, "\\t");
+		} else if (c < 0x20 || c >= 0x7f) {
+			/* EDID strings are ASCII, anything else is garbage */
+			jw_puts(w, "\\u00");
+			jw_putc(w, hex[c >> 4]);
+			jw_putc(w, hex[c & 0xf]);
+		} else {
+			jw_putc(w, c);
+		}
+	}
+	jw_putc(w, '"');
+}
+
+static void jw_uint(struct json_writer *w, unsigned long long v)
+{
+	char tmp[24];
+	int i = 0;
+
+	do {
+		tmp[i++] = '0' + v % 10;
+		v /= 10;
+	} while (v);
+	while (i)
+		jw_putc(w, tmp[--i]);
+}
+
+/* v / 10^decimals, printed with exactly that many decimals */
+static void jw_fixed(struct json_writer *w, unsigned v, unsigned decimals)
+{
+	unsigned div = 1, i;
+
+	for (i = 0; i < decimals; i++)
+		div *= 10;
+	jw_uint(w, v / div);
+	jw_putc(w, '.');
+	for (v %= div; div > 1; div /= 10) {
+		jw_putc(w, '0' + v / (div / 10));
+		v %= div / 10;
+	}
+}
+
+static void jw_hex(struct json_writer *w, const uint8_t *x, unsigned len)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	jw_putc(w, '"');
+	while (len--) {
+		jw_putc(w, hex[*x >> 4]);
+		jw_putc(w, hex[*x++ & 0xf]);
+	}
+	jw_putc(w, '"');
+}
+
+/* start a value: a member named key of an object, or an array element */
+static void jw_key(struct json_writer *w, const char *key)
+{
+	uint64_t bit = 1ULL << w->depth;
+
+	if (w->need_comma & bit)
+		jw_putc(w, ',');
+	w->need_comma |= bit;
+	if (key) {
+		jw_string(w, key);
+		jw_putc(w, ':');
+	}
+}
+
+static void jw_open(struct json_writer *w, const char *key, char c)
+{
+	jw_key(w, key);
+	jw_putc(w, c);
+	w->depth++;
+	w->need_comma &= ~(1ULL << w->depth);
+}
+
+static void jw_close(struct json_writer *w, char c)
+{
+	w->depth--;
+	jw_putc(w, c);
+}
+
+static void jw_member_uint(struct json_writer *w, const char *key, unsigned long long v)
+{
+	jw_key(w, key);
+	jw_uint(w, v);
+}
+
+static void jw_member_bool(struct json_writer *w, const char *key, int v)
+{
+	jw_key(w, key);
+	jw_puts(w, v ? "true" : "false");
+}
+
+static void jw_member_string(struct json_writer *w, const char *key, const char *s)
+{
+	jw_key(w, key);
+	jw_string(w, s);
+}
+
+static void jw_member_fixed(struct json_writer *w, const char *key,
+			    unsigned v, unsigned decimals)
+{
+	jw_key(w, key);
+	jw_fixed(w, v, decimals);
+}
+
+static const char *cta_block_name(unsigned tag, unsigned ext_tag)
+{
+	switch (tag) {
+	case 0x01: return "Audio Data Block";
+	case 0x02: return "Video Data Block";
+	case 0x03: return "Vendor-Specific Data Block";
+	case 0x04: return "Speaker Allocation Data Block";
+	case 0x05: return "VESA DTC Data Block";
+	case 0x07: break;
+	default: return "Unknown";
+	}
+	switch (ext_tag) {
+	case 0x00: return "Video Capability Data Block";
+	case 0x01: return "Vendor-Specific Video Data Block";
+	case 0x02: return "VESA Video Display Device Data Block";
+	case 0x03: return "VESA Video Timing Block Extension";
+	case 0x04: return "Reserved for HDMI Video Data Block";
+	case 0x05: return "Colorimetry Data Block";
+	case 0x06: return "HDR Static Metadata Data Block";
+	case 0x07: return "HDR Dynamic Metadata Data Block";
+	case 0x0d: return "Video Format Preference Data Block";
+	case 0x0e: return "YCbCr 4:2:0 Video Data Block";
+	case 0x0f: return "YCbCr 4:2:0 Capability Map Data Block";
+	case 0x10: return "Reserved for CTA Miscellaneous Audio Fields";
+	case 0x11: return "Vendor-Specific Audio Data Block";
+	case 0x12: return "HDMI Audio Data Block";
+	case 0x13: return "Room Configuration Data Block";
+	case 0x14: return "Speaker Location Data Block";
+	case 0x20: return "InfoFrame Data Block";
+	case 0x78: return "HDMI Forum EDID Extension Override Data Block";
+	case 0x79: return "HDMI Forum Sink Capability Data Block";
+	default: return "Reserved";
+	}
+}
+
+static const char *extension_name(unsigned tag)
+{
+	switch (tag) {
+	case 0x02: return "CTA-861";
+	case 0x10: return "VTB";
+	case 0x40: return "DI";
+	case 0x50: return "LS";
+	case 0x60: return "DPVL";
+	case 0x70: return "DisplayID";
+	case 0xf0: return "Block map";
+	case 0xff: return "Manufacturer-specific";
+	default: return "Unknown";
+	}
+}
+
+static const char *timing_source_name[] = {
+	[EDID_SRC_BASE] = "base",
+	[EDID_SRC_CTA] = "cta",
+	[EDID_SRC_DISPLAYID] = "displayid",
+	[EDID_SRC_VIC] = "vic",
+	[EDID_SRC_CVT] = "cvt",
+	[EDID_SRC_GTF] = "gtf",
+	[EDID_SRC_DMT] = "dmt",
+};
+
+static void json_base(struct json_writer *w, const struct edid_info *info)
+{
+	static const char *primaries[] = { "red", "green", "blue", "white" };
+	const struct edid_base *base = &info->base;
+	const struct std_timing *t;
+	unsigned i;
+
+	jw_open(w, "base", '{');
+	jw_member_uint(w, "version", base->version);
+	jw_member_uint(w, "revision", base->revision);
+	jw_member_string(w, "manufacturer", base->manufacturer);
+	jw_member_uint(w, "product", base->product);
+	jw_member_uint(w, "serial", base->serial);
+	jw_member_uint(w, "week", base->week);
+	jw_member_uint(w, "year", base->year);
+	jw_member_bool(w, "digital", base->digital);
+	jw_member_uint(w, "input", base->input);
+	if (base->bpc)
+		jw_member_uint(w, "bpc", base->bpc);
+	jw_member_uint(w, "max_hsize_cm", base->max_hsize_cm);
+	jw_member_uint(w, "max_vsize_cm", base->max_vsize_cm);
+	if (base->gamma)
+		jw_member_fixed(w, "gamma", base->gamma, 2);
+	jw_member_uint(w, "features", base->features);
+	jw_open(w, "chromaticity", '{');
+	for (i = 0; i < 4; i++) {
+		jw_open(w, primaries[i], '[');
+		jw_key(w, NULL);
+		jw_fixed(w, base->chromaticity[2 * i] * 10000 / 1024, 4);
+		jw_key(w, NULL);
+		jw_fixed(w, base->chromaticity[2 * i + 1] * 10000 / 1024, 4);
+		jw_close(w, ']');
+	}
+	jw_close(w, '}');
+
+	jw_open(w, "established_timings", '[');
+	for (i = 0; i < ARRAY_SIZE(established_timings); i++) {
+		if (!(base->established[i / 8] & (1 << (7 - i % 8))))
+			continue;
+		t = &timing_db[established_timings[i]];
+		jw_open(w, NULL, '{');
+		jw_member_uint(w, "width", t->x);
+		jw_member_uint(w, "height", t->y);
+		jw_member_uint(w, "refresh", t->refresh);
+		jw_member_bool(w, "interlaced", t->interlaced);
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+
+	jw_open(w, "standard_timings", '[');
+	for (i = 0; i < info->num_std_timings; i++) {
+		const struct edid_std_timing *t = &info->std_timings[i];
+
+		jw_open(w, NULL, '{');
+		jw_member_uint(w, "width", t->hact);
+		jw_member_uint(w, "height", t->vact);
+		jw_member_uint(w, "refresh", t->refresh);
+		jw_member_uint(w, "ratio_w", t->ratio_w);
+		jw_member_uint(w, "ratio_h", t->ratio_h);
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+
+	if (base->name[0])
+		jw_member_string(w, "name", base->name);
+	if (base->serial_string[0])
+		jw_member_string(w, "serial_string", base->serial_string);
+	if (base->ascii_string[0])
+		jw_member_string(w, "ascii_string", base->ascii_string);
+	if (base->has_range_limits) {
+		const struct edid_range_limits *r = &base->range_limits;
+
+		jw_open(w, "range_limits", '{');
+		jw_member_uint(w, "min_vfreq_hz", r->min_vfreq_hz);
+		jw_member_uint(w, "max_vfreq_hz", r->max_vfreq_hz);
+		jw_member_uint(w, "min_hfreq_khz", r->min_hfreq_khz);
+		jw_member_uint(w, "max_hfreq_khz", r->max_hfreq_khz);
+		if (r->max_pixclk_mhz)
+			jw_member_uint(w, "max_pixclk_mhz", r->max_pixclk_mhz);
+		jw_member_uint(w, "type", r->type);
+		jw_close(w, '}');
+	}
+	jw_member_uint(w, "extension_count", base->num_extensions);
+	jw_close(w, '}');
+}
+
+static void json_timing(struct json_writer *w, const struct edid_timing *t)
+{
+	jw_member_string(w, "source", timing_source_name[t->source]);
+	jw_member_uint(w, "block", t->block);
+	jw_member_uint(w, "offset", t->offset);
+	jw_member_uint(w, "pixclk_khz", t->pixclk_khz);
+	jw_member_uint(w, "hactive", t->hact);
+	jw_member_uint(w, "hfront_porch", t->hfp);
+	jw_member_uint(w, "hsync", t->hsync);
+	jw_member_uint(w, "hback_porch", t->hbp);
+	jw_member_uint(w, "hborder", t->hborder);
+	jw_member_uint(w, "vactive", t->vact);
+	jw_member_uint(w, "vfront_porch", t->vfp);
+	jw_member_uint(w, "vsync", t->vsync);
+	jw_member_uint(w, "vback_porch", t->vbp);
+	jw_member_uint(w, "vborder", t->vborder);
+	jw_member_uint(w, "width_mm", t->hsize_mm);
+	jw_member_uint(w, "height_mm", t->vsize_mm);
+	jw_member_bool(w, "interlaced", t->flags & EDID_TIMING_INTERLACED);
+	jw_member_bool(w, "hsync_positive", t->flags & EDID_TIMING_PHSYNC);
+	jw_member_bool(w, "vsync_positive", t->flags & EDID_TIMING_PVSYNC);
+}
+
+static void json_timings(struct json_writer *w, const struct edid_info *info)
+{
+	unsigned i;
+
+	jw_open(w, "detailed_timings", '[');
+	for (i = 0; i < info->num_timings; i++) {
+		const struct edid_timing *t = &info->timings[i];
+
+		jw_open(w, NULL, '{');
+		json_timing(w, t);
+		jw_member_bool(w, "preferred", t->flags & EDID_TIMING_PREFERRED);
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+}
+
+static const char *mode_source_name[] = {
+	"established", "standard", "detailed", "cvt",
+	"cta_dtd", "cta_svd", "displayid", "displayid_dmt",
+};
+
+static void json_modes(struct json_writer *w, const struct edid_info *info)
+{
+	unsigned i, j;
+
+	jw_open(w, "modes", '[');
+	for (i = 0; i < info->num_modes; i++) {
+		const struct edid_mode *m = &info->modes[i];
+
+		jw_open(w, NULL, '{');
+		json_timing(w, &m->timing);
+		jw_member_fixed(w, "refresh_hz", m->refresh_mhz, 3);
+		if (m->vic)
+			jw_member_uint(w, "vic", m->vic);
+		jw_member_bool(w, "native", m->flags & EDID_MODE_NATIVE);
+		jw_member_bool(w, "preferred", m->flags & EDID_MODE_PREFERRED);
+		jw_member_bool(w, "ycbcr420", m->flags & EDID_MODE_YCBCR420);
+		jw_member_bool(w, "ycbcr420_only", m->flags & EDID_MODE_YCBCR420_ONLY);
+		jw_open(w, "sources", '[');
+		for (j = 0; j < ARRAY_SIZE(mode_source_name); j++)
+			if (m->sources & (1 << j)) {
+				jw_key(w, NULL);
+				jw_string(w, mode_source_name[j]);
+			}
+		jw_close(w, ']');
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+}
+
+static void json_cta(struct json_writer *w, const struct edid_info *info)
+{
+	const struct edid_cta_caps *cta = &info->cta;
+	unsigned i;
+
+	jw_open(w, "cta", '{');
+	jw_open(w, "data_blocks", '[');
+	for (i = 0; i < info->num_cta_blocks; i++) {
+		const struct edid_cta_block *b = &info->cta_blocks[i];
+
+		jw_open(w, NULL, '{');
+		jw_member_string(w, "name", cta_block_name(b->tag, b->ext_tag));
+		jw_member_uint(w, "block", b->block);
+		jw_member_uint(w, "offset", b->offset);
+		jw_member_uint(w, "length", b->length);
+		jw_member_uint(w, "tag", b->tag);
+		if (b->tag == 0x07)
+			jw_member_uint(w, "ext_tag", b->ext_tag);
+		if (b->oui)
+			jw_member_uint(w, "oui", b->oui);
+		jw_key(w, "payload");
+		jw_hex(w, info->buf + b->offset,
+		       min(b->length, info->size - b->offset));
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+
+	jw_open(w, "svds", '[');
+	for (i = 0; i < cta->num_svds; i++) {
+		const struct edid_svd *svd = &cta->svds[i];
+		const struct edid_vic_mode *mode = vic_to_mode(svd->vic);
+
+		jw_open(w, NULL, '{');
+		jw_member_uint(w, "vic", svd->vic);
+		if (mode)
+			jw_member_string(w, "mode", mode->name);
+		jw_member_bool(w, "native", svd->flags & EDID_SVD_NATIVE);
+		jw_member_bool(w, "ycbcr420", svd->flags & EDID_SVD_YCBCR420);
+		jw_member_bool(w, "ycbcr420_only", svd->flags & EDID_SVD_YCBCR420_ONLY);
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+
+	jw_open(w, "audio", '[');
+	for (i = 0; i < cta->num_sads; i++) {
+		const struct edid_sad *sad = &cta->sads[i];
+
+		jw_open(w, NULL, '{');
+		jw_member_string(w, "format", sad->format == 15 ?
+				 audio_ext_format(sad->ext_format) : audio_format(sad->format));
+		jw_member_uint(w, "format_code", sad->format);
+		if (sad->format == 15)
+			jw_member_uint(w, "ext_format_code", sad->ext_format);
+		if (sad->channels)
+			jw_member_uint(w, "max_channels", sad->channels);
+		jw_member_uint(w, "sample_rates", sad->rates);
+		jw_member_uint(w, "byte3", sad->byte3);
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+
+	jw_open(w, "speakers", '[');
+	for (i = 0; i < ARRAY_SIZE(speaker_map); i++)
+		if (cta->speakers & (1 << i)) {
+			jw_key(w, NULL);
+			jw_string(w, speaker_map[i]);
+		}
+	jw_close(w, ']');
+
+	jw_open(w, "colorimetry", '[');
+	for (i = 0; i < ARRAY_SIZE(colorimetry_map); i++)
+		if (cta->colorimetry & (1 << i)) {
+			jw_key(w, NULL);
+			jw_string(w, colorimetry_map[i]);
+		}
+	if (cta->colorimetry & 0x8000) {
+		jw_key(w, NULL);
+		jw_string(w, "DCI-P3");
+	}
+	if (cta->colorimetry & 0x4000) {
+		jw_key(w, NULL);
+		jw_string(w, "ICtCp");
+	}
+	jw_close(w, ']');
+	jw_member_uint(w, "vcdb", cta->vcdb);
+
+	if (cta->hdmi.present) {
+		const struct edid_hdmi_caps *hdmi = &cta->hdmi;
+
+		jw_open(w, "hdmi", '{');
+		jw_key(w, "physical_address");
+		jw_putc(w, '"');
+		for (i = 0; i < 4; i++) {
+			if (i)
+				jw_putc(w, '.');
+			jw_uint(w, (hdmi->phys_addr >> (12 - 4 * i)) & 0xf);
+		}
+		jw_putc(w, '"');
+		jw_member_uint(w, "flags", hdmi->flags);
+		if (hdmi->max_tmds_mhz)
+			jw_member_uint(w, "max_tmds_mhz", hdmi->max_tmds_mhz);
+		jw_open(w, "vics", '[');
+		for (i = 0; i < hdmi->num_vics; i++) {
+			jw_key(w, NULL);
+			jw_uint(w, hdmi->vics[i]);
+		}
+		jw_close(w, ']');
+		jw_close(w, '}');
+	}
+
+	if (cta->hf.present) {
+		const struct edid_hf_caps *hf = &cta->hf;
+
+		jw_open(w, "hdmi_forum", '{');
+		jw_member_uint(w, "version", hf->version);
+		if (hf->max_tmds_mhz)
+			jw_member_uint(w, "max_tmds_mhz", hf->max_tmds_mhz);
+		jw_member_uint(w, "max_frl_rate", hf->max_frl_rate);
+		jw_open(w, "flags", '[');
+		for (i = 0; i < ARRAY_SIZE(hf->flags); i++) {
+			jw_key(w, NULL);
+			jw_uint(w, hf->flags[i]);
+		}
+		jw_close(w, ']');
+		jw_member_uint(w, "vrr_min", hf->vrr_min);
+		jw_member_uint(w, "vrr_max", hf->vrr_max);
+		jw_member_uint(w, "dsc_flags", hf->dsc_flags);
+		jw_member_uint(w, "dsc_max_slices", hf->dsc_max_slices);
+		jw_member_uint(w, "dsc_max_frl_rate", hf->dsc_max_frl_rate);
+		jw_member_uint(w, "dsc_total_chunk_kbytes", hf->dsc_total_chunk_kbytes);
+		jw_close(w, '}');
+	}
+	jw_close(w, '}');
+}
+
+static void json_displayid(struct json_writer *w, const struct edid_info *info)
+{
+	unsigned i;
+
+	jw_open(w, "displayid", '{');
+	jw_open(w, "data_blocks", '[');
+	for (i = 0; i < info->num_displayid_blocks; i++) {
+		const struct edid_displayid_block *b = &info->displayid_blocks[i];
+
+		jw_open(w, NULL, '{');
+		jw_member_string(w, "name", displayid_block_name(b->tag) ?
+				 displayid_block_name(b->tag) : "Unknown");
+		jw_member_uint(w, "block", b->block);
+		jw_member_uint(w, "offset", b->offset);
+		jw_member_uint(w, "length", b->length);
+		jw_member_uint(w, "tag", b->tag);
+		jw_member_uint(w, "revision", b->revision);
+		jw_key(w, "payload");
+		/* a broken data block may claim more than the EDID holds */
+		jw_hex(w, info->buf + b->offset,
+		       min(b->length, info->size - b->offset));
+		jw_close(w, '}');
+	}
+	jw_close(w, ']');
+	jw_close(w, '}');
+}
+
+static void emit_json(FILE *f, const struct edid_info *info, const char *source)
+{
+	struct json_writer w;
+	unsigned i;
+
+	w.f = f;
+	w.len = 0;
+	w.depth = 0;
+	w.need_comma = 0;
+
+	jw_open(&w, NULL, '{');
+	if (source)
+		jw_member_string(&w, "source", source);
+	if (!info->size) {
+		jw_member_string(&w, "error", "no EDID found");
+		goto out;
+	}
+	jw_member_uint(&w, "size", info->size);
+	jw_member_uint(&w, "blocks", info->num_blocks);
+	if (info->truncated)
+		jw_member_uint(&w, "truncated", info->truncated);
+	json_base(&w, info);
+	json_timings(&w, info);
+
+	jw_open(&w, "extensions", '[');
+	for (i = 0; i < info->num_extensions; i++) {
+		jw_open(&w, NULL, '{');
+		jw_member_uint(&w, "block", i + 1);
+		jw_member_string(&w, "name", extension_name(info->extensions[i].tag));
+		jw_member_uint(&w, "tag", info->extensions[i].tag);
+		jw_member_uint(&w, "revision", info->extensions[i].revision);
+		if (info->extensions[i].tag == 0x02)
+			jw_member_uint(&w, "flags", info->extensions[i].flags);
+		jw_close(&w, '}');
+	}
+	jw_close(&w, ']');
+	json_cta(&w, info);
+	json_displayid(&w, info);
+	json_modes(&w, info);
+
+	jw_open(&w, "findings", '[');
+	for (i = 0; i < info->num_findings; i++) {
+		const struct edid_finding *finding = &info->findings[i];
+
+		jw_open(&w, NULL, '{');
+		jw_member_uint(&w, "code", finding->code);
+		jw_member_string(&w, "severity",
+				 finding->severity == EDID_SEV_ERROR ? "error" : "warning");
+		jw_member_string(&w, "block", finding->block);
+		if (finding->offset >= 0)
+			jw_member_uint(&w, "offset", finding->offset);
+		jw_member_string(&w, "message", finding->message);
+		jw_close(&w, '}');
+	}
+	jw_close(&w, ']');
+	if (info->conformant >= 0)
+		jw_member_bool(&w, "conformant", info->conformant);
+out:
+	jw_close(&w, '}');
+	jw_putc(&w, '\n');
+	jw_flush(&w);
+}
+
+static void emit_codes(FILE *f, const struct edid_info *info, const char *source)
+{
+	unsigned i;
+
+	if (source)
+		fprintf(f, "%s: ", source);
+	if (!info->size) {
+		fprintf(f, "error no EDID found\n");
+		return;
+	}
+	fprintf(f, "%s", info->conformant ? "pass" : "fail");
+	for (i = 0; i < info->num_findings; i++)
+		fprintf(f, " %c%u",
+			info->findings[i].severity == EDID_SEV_ERROR ? 'E' : 'W',
+			info->findings[i].code);
+	if (info->truncated & EDID_INFO_TRUNC_FINDINGS)
+		fprintf(f, " ...");
+	fprintf(f, "\n");
+}
+
+void edid_emit(FILE *f, const struct edid_info *info, enum edid_output output,
+	       const char *source)
+{
+	switch (output) {
+	case EDID_OUTPUT_TIMINGS:
+		if (info->size)
+			emit_timings(f, info);
+		break;
+	case EDID_OUTPUT_FINDINGS:
+		if (info->size)
+			emit_findings(f, info);
+		break;
+	case EDID_OUTPUT_JSON:
+		emit_json(f, info, source);
+		break;
+	case EDID_OUTPUT_CODES:
+		emit_codes(f, info, source);
+		break;
+	case EDID_OUTPUT_TEXT:
+		emit_text(f, info);
+		break;
+	}
+}
+
+/*
+ * Notes on panel extensions: (TODO, implement me in the code)
+ *
+ * EPI: http://www.epi-standard.org/fileadmin/spec/EPI_Specification1.0.pdf
+ * at offset 0x6c (fourth detailed block): (all other bits reserved)
+ * 0x6c: 00 00 00 0e 00
+ * 0x71: bit 6-5: data color mapping (00 conventional/fpdi/vesa, 01 openldi)
+ *       bit 4-3: pixels per clock (00 1, 01 2, 10 4, 11 reserved)
+ *       bit 2-0: bits per pixel (000 18, 001 24, 010 30, else reserved)
+ * 0x72: bit 5: FPSCLK polarity (0 normal 1 inverted)
+ *       bit 4: DE polarity (0 high active 1 low active)
+ *       bit 3-0: interface (0000 LVDS TFT
+ *                           0001 mono STN 4/8bit
+ *                           0010 color STN 8/16 bit
+ *                           0011 18 bit tft
+ *                           0100 24 bit tft
+ *                           0101 tmds
+ *                           else reserved)
+ * 0x73: bit 1: horizontal display mode (0 normal 1 right/left reverse)
+ *       bit 0: vertical display mode (0 normal 1 up/down reverse)
+ * 0x74: bit 7-4: total poweroff seq delay (0000 vga controller default
+ *                                          else time in 10ms (10ms to 150ms))
+ *       bit 3-0: total poweron seq delay (as above)
+ * 0x75: contrast power on/off seq delay, same as 0x74
+ * 0x76: bit 7: backlight control enable (1 means this field is valid)
+ *       bit 6: backlight enabled at boot (0 on 1 off)
+ *       bit 5-0: backlight brightness control steps (0..63)
+ * 0x77: bit 7: contrast control, same bit pattern as 0x76 except bit 6 resvd
+ * 0x78 - 0x7c: reserved
+ * 0x7d: bit 7-4: EPI descriptor major version (1)
+ *       bit 3-0: EPI descriptor minor version (0)
+ *
+ * ----
+ *
+ * SPWG: http://www.spwg.org/spwg_spec_version3.8_3-14-2007.pdf
+ *
+ * Since these are "dummy" blocks, terminate with 0a 20 20 20 ... as usual
+ *
+ * detailed descriptor 3:
+ * 0x5a - 0x5e: 00 00 00 fe 00
+ * 0x5f - 0x63: PC maker part number
+ * 0x64: LCD supplier revision #
+ * 0x65 - 0x6b: manufacturer part number
+ *
+ * detailed descriptor 4:
+ * 0x6c - 0x70: 00 00 00 fe 00
+ * 0x71 - 0x78: smbus nits values (whut)
+ * 0x79: number of lvds channels (1 or 2)
+ * 0x7A: panel self test (1 if present)
+ * and then dummy terminator
+ *
+ * SPWG also says something strange about the LSB of detailed descriptor 1:
+ * "LSB is set to "1" if panel is DE-timing only. H/V can be ignored."
+ */
@@ -0,0 +1,720 @@
+/*
+ * Copyright 2006-2012 Red Hat, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * on the rights to use, copy, modify, merge, publish, distribute, sub
+ * license, and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef LIBEDID_DECODE_H
+#define LIBEDID_DECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * libedid-decode: the EDID decoder behind edid-decode, usable from other
+ * programs. edid_decode() fills a struct edid_info with plain data and
+ * does not print anything. edid_emit() writes an already decoded struct
+ * edid_info in one of several formats, among them the human-readable
+ * report the edid-decode utility prints, so a single decode can feed
+ * several outputs. edid_decode_text() decodes and writes that report in
+ * one call.
+ *
+ * Both functions are reentrant: all decode state lives on the stack of
+ * the call, so any number of decodes may run concurrently.
+ *
+ * The arrays below have a fixed size. Entries that do not fit are
+ * dropped and the matching EDID_INFO_TRUNC_* bit is set in
+ * edid_info.truncated.
+ */
+
+enum {
+	EDID_INFO_MAX_TIMINGS = 128,
+	EDID_INFO_MAX_STD_TIMINGS = 64,
+	EDID_INFO_MAX_EXTENSIONS = 255,
+	EDID_INFO_MAX_CTA_BLOCKS = 256,
+	EDID_INFO_MAX_DISPLAYID_BLOCKS = 64,
+	EDID_INFO_MAX_SVDS = 128,
+	EDID_INFO_MAX_SADS = 32,
+	EDID_INFO_MAX_FINDINGS = 64,
+	EDID_INFO_MAX_MODES = 256,
+};
+
+/* edid_decode_text() flags */
+enum {
+	EDID_DECODE_CHECK = 1 << 0,	/* report conformance issues */
+	EDID_DECODE_EXTRACT = 1 << 1,	/* dump the fields of the base block */
+	/* with EDID_DECODE_CHECK, stop at the first issue that fails the EDID */
+	EDID_DECODE_CHECK_FIRST = 1 << 2,
+	/* record findings without formatting their message */
+	EDID_DECODE_QUIET = 1 << 3,
+};
+
+/* edid_info.truncated */
+enum {
+	EDID_INFO_TRUNC_TIMINGS = 1 << 0,
+	EDID_INFO_TRUNC_STD_TIMINGS = 1 << 1,
+	EDID_INFO_TRUNC_CTA_BLOCKS = 1 << 2,
+	EDID_INFO_TRUNC_DISPLAYID_BLOCKS = 1 << 3,
+	EDID_INFO_TRUNC_SVDS = 1 << 4,
+	EDID_INFO_TRUNC_SADS = 1 << 5,
+	EDID_INFO_TRUNC_FINDINGS = 1 << 6,
+	EDID_INFO_TRUNC_MODES = 1 << 7,
+};
+
+/* edid_timing.source */
+enum edid_timing_source {
+	EDID_SRC_BASE,		/* detailed timing descriptor in the base block */
+	EDID_SRC_CTA,		/* detailed timing descriptor in a CTA-861 block */
+	EDID_SRC_DISPLAYID,	/* DisplayID type 1 detailed timing */
+	EDID_SRC_VIC,		/* CTA-861 video format, see edid_vic_mode() */
+	EDID_SRC_CVT,		/* computed with a CVT formula */
+	EDID_SRC_GTF,		/* computed with the GTF formula */
+	EDID_SRC_DMT,		/* VESA DMT or other established timing */
+};
+
+/* edid_timing.flags */
+enum {
+	EDID_TIMING_INTERLACED = 1 << 0,
+	EDID_TIMING_PHSYNC = 1 << 1,
+	EDID_TIMING_PVSYNC = 1 << 2,
+	EDID_TIMING_PREFERRED = 1 << 3,
+};
+
+/* A detailed timing; porches and sync widths are in pixels/lines. */
+struct edid_timing {
+	uint32_t pixclk_khz;
+	uint16_t hact, hfp, hsync, hbp;
+	uint16_t vact, vfp, vsync, vbp;
+	uint16_t hborder, vborder;
+	uint16_t hsize_mm, vsize_mm;
+	uint8_t flags;
+	uint8_t source;		/* enum edid_timing_source */
+	uint8_t block;		/* EDID block containing the timing */
+	uint16_t offset;	/* offset of the descriptor in the EDID */
+};
+
+/* edid_calc_timing() formulas */
+enum edid_formula {
+	EDID_FORMULA_CVT,	/* CVT 1.2 */
+	EDID_FORMULA_CVT_RB,	/* CVT 1.2 reduced blanking */
+	EDID_FORMULA_CVT_RB2,	/* CVT 1.2 reduced blanking v2 */
+	EDID_FORMULA_GTF,	/* GTF with the default parameters */
+};
+
+/* A CTA-861 video format, as returned by edid_vic_mode() */
+struct edid_vic_mode {
+	const char *name;
+	uint16_t refresh;		/* nominal field rate in Hz */
+	uint16_t ratio_w, ratio_h;	/* picture aspect ratio */
+	uint32_t hor_freq_hz;
+	/* vertical values are per field for interlaced formats */
+	struct edid_timing timing;
+};
+
+/* edid_mode.sources */
+enum {
+	EDID_MODE_SRC_ESTABLISHED = 1 << 0,	/* established timings I, II or III */
+	EDID_MODE_SRC_STANDARD = 1 << 1,	/* standard timings */
+	EDID_MODE_SRC_DETAILED = 1 << 2,	/* detailed timings of the base block */
+	EDID_MODE_SRC_CVT = 1 << 3,		/* CVT 3-byte timing codes */
+	EDID_MODE_SRC_CTA_DTD = 1 << 4,		/* CTA-861 detailed timings */
+	EDID_MODE_SRC_CTA_SVD = 1 << 5,		/* CTA-861 short video descriptors */
+	EDID_MODE_SRC_DISPLAYID = 1 << 6,	/* DisplayID type 1 timings */
+	EDID_MODE_SRC_DISPLAYID_DMT = 1 << 7,	/* DisplayID VESA DMT timings */
+};
+
+/* edid_mode.flags */
+enum {
+	EDID_MODE_NATIVE = 1 << 0,
+	EDID_MODE_YCBCR420 = 1 << 1,		/* supports YCbCr 4:2:0 */
+	EDID_MODE_YCBCR420_ONLY = 1 << 2,	/* only listed as 4:2:0 capable */
+	EDID_MODE_PREFERRED = 1 << 3,
+};
+
+/*
+ * A mode the display supports. Modes listed in several places with the
+ * same timing are merged: sources has a bit for each of them, and
+ * timing.source, block and offset are those of the first one found.
+ */
+struct edid_mode {
+	struct edid_timing timing;
+	uint32_t refresh_mhz;	/* field rate in mHz */
+	uint16_t sources;	/* EDID_MODE_SRC_* */
+	uint8_t flags;		/* EDID_MODE_* */
+	uint8_t vic;		/* CTA-861 VIC, 0 if not listed in an SVD */
+};
+
+/* Standard timing from the base block or a 0xfa descriptor */
+struct edid_std_timing {
+	uint16_t hact, vact;
+	uint8_t refresh;
+	uint8_t ratio_w, ratio_h;
+};
+
+/* Display range limits descriptor (0xfd) */
+struct edid_range_limits {
+	uint16_t min_vfreq_hz, max_vfreq_hz;
+	uint16_t min_hfreq_khz, max_hfreq_khz;
+	uint16_t max_pixclk_mhz;	/* 0 if not given */
+	uint8_t type;			/* byte 10 of the descriptor */
+	/* only for CVT range limits (type 4) */
+	uint16_t pixclk_adjust_khz;	/* to subtract from max_pixclk_mhz */
+	uint16_t max_hact;		/* 0 if not limited */
+	uint8_t cvt_blanking;		/* byte 15: 0x10 reduced, 0x08 standard */
+};
+
+struct edid_base {
+	uint8_t version, revision;
+	char manufacturer[4];
+	uint16_t product;
+	uint32_t serial;
+	uint8_t week;			/* 0xff means year is a model year */
+	uint16_t year;
+	uint8_t valid_year;		/* week and year are plausible */
+	uint8_t input;			/* video input definition, byte 0x14 */
+	uint8_t digital;
+	uint8_t bpc;			/* bits per color, 0 if undefined */
+	uint8_t max_hsize_cm, max_vsize_cm;
+	uint16_t gamma;			/* (gamma * 100), 0 if in an extension */
+	uint8_t features;		/* feature support, byte 0x18 */
+	/* red, green, blue, white x/y chromaticity in 1/1024 units */
+	uint16_t chromaticity[8];
+	uint8_t established[3];		/* established timings bitmap */
+	char name[14];
+	char serial_string[14];
+	char ascii_string[14];
+	uint8_t has_range_limits;
+	struct edid_range_limits range_limits;
+	uint8_t num_extensions;
+};
+
+/* An extension block header */
+struct edid_extension {
+	uint8_t tag;
+	uint8_t revision;
+	uint8_t flags;		/* CTA-861: byte 3 (support and native DTDs) */
+};
+
+/* edid_cta_block.tag and ext_tag values used by the lookups below */
+enum {
+	EDID_CTA_TAG_VENDOR = 0x03,
+	EDID_CTA_TAG_EXTENDED = 0x07,
+	EDID_CTA_EXT_VENDOR_VIDEO = 0x01,	/* Vendor-Specific Video */
+	EDID_CTA_EXT_COLORIMETRY = 0x05,	/* Colorimetry */
+	EDID_CTA_EXT_HDR_STATIC = 0x06,		/* HDR Static Metadata */
+	EDID_CTA_EXT_HDR_DYNAMIC = 0x07,	/* HDR Dynamic Metadata */
+	EDID_CTA_EXT_HF_SCDB = 0x79,		/* HDMI Forum SCDB */
+};
+
+#define EDID_OUI_HDMI		0x000c03
+#define EDID_OUI_HDMI_FORUM	0xc45dd8
+#define EDID_OUI_HDR10PLUS	0x90848b
+
+/* A CTA-861 data block; its payload is at buf[offset .. offset + length) */
+struct edid_cta_block {
+	uint8_t block;		/* EDID block containing the data block */
+	uint8_t tag;
+	uint8_t ext_tag;	/* only valid for tag 7 */
+	uint32_t oui;		/* vendor-specific blocks, else 0 */
+	uint16_t offset;
+	uint8_t length;
+};
+
+/* A DisplayID data block; its payload is at buf[offset .. offset + length) */
+struct edid_displayid_block {
+	uint8_t block;		/* EDID block containing the data block */
+	uint8_t tag;
+	uint8_t revision;
+	uint16_t offset;
+	uint8_t length;
+};
+
+/* edid_svd.flags */
+enum {
+	EDID_SVD_NATIVE = 1 << 0,
+	EDID_SVD_YCBCR420 = 1 << 1,		/* also supports YCbCr 4:2:0 */
+	EDID_SVD_YCBCR420_ONLY = 1 << 2,	/* from the YCbCr 4:2:0 VDB */
+};
+
+/* Short Video Descriptor */
+struct edid_svd {
+	uint8_t vic;
+	uint8_t flags;
+};
+
+/* Short Audio Descriptor */
+struct edid_sad {
+	uint8_t format;		/* audio format code */
+	uint8_t ext_format;	/* extended audio format code if format is 15 */
+	uint8_t channels;	/* max channels, 0 for MPEG-H 3D Audio */
+	uint8_t rates;		/* sample rates, byte 2 of the SAD */
+	uint8_t byte3;		/* sample sizes, max bit rate or flags */
+};
+
+/* HDMI Vendor-Specific Data Block */
+struct edid_hdmi_caps {
+	uint8_t present;
+	uint16_t phys_addr;
+	uint8_t flags;		/* Supports_AI, DC_* and DVI_Dual bits */
+	uint16_t max_tmds_mhz;	/* 0 if not given */
+	uint8_t num_vics;
+	uint8_t vics[7];	/* HDMI VICs */
+};
+
+/* HDMI Forum Vendor-Specific Data Block or Sink Capability Data Block */
+struct edid_hf_caps {
+	uint8_t present;
+	uint8_t version;
+	uint16_t max_tmds_mhz;	/* 0 if not given */
+	uint8_t max_frl_rate;	/* Max_FRL_Rate field, 0 if FRL is unsupported */
+	/* SCDC, deep color 4:2:0, VRR and DSC bytes of the block as is */
+	uint8_t flags[3];
+	uint8_t vrr_min;
+	uint16_t vrr_max;
+	uint8_t dsc_flags;
+	uint8_t dsc_max_slices;
+	uint8_t dsc_max_frl_rate;
+	uint8_t dsc_total_chunk_kbytes;
+};
+
+/* edid_hdr_caps.eotfs */
+enum {
+	EDID_EOTF_SDR = 1 << 0,		/* traditional gamma, SDR luminance */
+	EDID_EOTF_HDR = 1 << 1,		/* traditional gamma, HDR luminance */
+	EDID_EOTF_PQ = 1 << 2,		/* SMPTE ST2084 */
+	EDID_EOTF_HLG = 1 << 3,		/* Hybrid Log-Gamma */
+};
+
+enum {
+	EDID_HDR_MAX_DYNAMIC = 8,
+};
+
+/*
+ * HDR Static and Dynamic Metadata, HDR10+ and Colorimetry Data Blocks.
+ * Luminance values are in cd/m^2, and 0 if not given.
+ */
+struct edid_hdr_caps {
+	uint8_t has_static;
+	uint8_t eotfs;
+	uint8_t static_metadata;	/* bit n: static metadata type n + 1 */
+	float max_luminance;
+	float max_frame_avg_luminance;
+	float min_luminance;
+	uint8_t num_dynamic;
+	struct {
+		uint16_t type;		/* HDR dynamic metadata type */
+		uint8_t version;	/* for types 1, 2 and 4, else 0 */
+	} dynamic[EDID_HDR_MAX_DYNAMIC];
+	uint8_t has_hdr10plus;
+	uint8_t hdr10plus_version;	/* Application Version */
+	uint8_t has_colorimetry;
+	uint16_t colorimetry;		/* byte 3 | byte 4 << 8 */
+};
+
+/* Capabilities collected from all CTA-861 blocks */
+struct edid_cta_caps {
+	unsigned num_svds;
+	struct edid_svd svds[EDID_INFO_MAX_SVDS];
+	unsigned num_sads;
+	struct edid_sad sads[EDID_INFO_MAX_SADS];
+	uint32_t speakers;	/* Speaker Allocation Data Block */
+	uint16_t colorimetry;	/* Colorimetry Data Block, byte 3 | byte 4 << 8 */
+	uint8_t vcdb;		/* Video Capability Data Block */
+	struct edid_hdmi_caps hdmi;
+	struct edid_hf_caps hf;
+	struct edid_hdr_caps hdr;
+};
+
+enum edid_severity {
+	EDID_SEV_WARNING,
+	EDID_SEV_ERROR,
+};
+
+/*
+ * edid_finding.code: identifies the issue independent of its message. The
+ * values are stable; new codes are only ever added at the end.
+ */
+enum edid_finding_code {
+	EDID_FINDING_OTHER,
+	/* warnings printed at the end of the decode */
+	EDID_FINDING_STRING_EMPTY,
+	EDID_FINDING_STRING_TRAILING_SPACE,
+	EDID_FINDING_STRING_NON_PRINTABLE,
+	EDID_FINDING_STRING_NON_SPACE_AFTER_NEWLINE,
+	EDID_FINDING_TILE_NO_BEVEL,
+	EDID_FINDING_INVALID_YEAR,
+	/* conformance issues */
+	EDID_FINDING_SRGB_CHROMATICITY,
+	EDID_FINDING_DIGITAL_DISPLAY_GARBAGE,
+	EDID_FINDING_MISSING_640X480P60,
+	EDID_FINDING_HF_VSDB_POSITION,
+	EDID_FINDING_DUPLICATE_SCDB,
+	EDID_FINDING_HDMI_VSDB_TMDS_RATE,
+	EDID_FINDING_HF_VSDB_TMDS_RATE,
+	EDID_FINDING_HF_EEODB,
+	EDID_FINDING_MISSING_NAME,
+	EDID_FINDING_MISSING_PREFERRED_TIMING,
+	EDID_FINDING_MISSING_RANGES,
+	EDID_FINDING_DESCRIPTOR_PAD,
+	EDID_FINDING_STRING_TERMINATION,
+	EDID_FINDING_NON_DETAILED_DESCRIPTOR,
+	EDID_FINDING_OUT_OF_RANGE,
+	EDID_FINDING_NONCONFORMANT_EXTENSION,
+	EDID_FINDING_CHECKSUM,
+	EDID_FINDING_CVT,
+	EDID_FINDING_BAD_YEAR,
+	EDID_FINDING_BAD_WEEK,
+	EDID_FINDING_SERIAL_NUMBER_AND_STRING,
+	EDID_FINDING_DETAILED_BLOCK_GARBAGE,
+	EDID_FINDING_DUMMY_BLOCK_GARBAGE,
+	EDID_FINDING_MANUFACTURER_NAME,
+	EDID_FINDING_DESCRIPTOR_ORDERING,
+	EDID_FINDING_RANGE_DESCRIPTOR_GARBAGE,
+	EDID_FINDING_MISSING_MAX_DOTCLOCK,
+	EDID_FINDING_INVALID_NAME,
+	EDID_FINDING_INVALID_ASCII_STRING,
+	EDID_FINDING_INVALID_SERIAL_STRING,
+	EDID_FINDING_TRAILING_SPACES,
+	EDID_FINDING_EMPTY_STRINGS,
+	EDID_FINDING_CVT_DOTCLOCK_CORRECTION,
+	EDID_FINDING_CVT_NO_PREFERRED_REFRESH,
+	EDID_FINDING_HDMI_VIC_NOT_IN_VSB,
+};
+
+/* the highest code; update it when adding one */
+#define EDID_FINDING_LAST	EDID_FINDING_HDMI_VIC_NOT_IN_VSB
+
+/* A conformance issue found by the decoder */
+struct edid_finding {
+	uint16_t code;		/* enum edid_finding_code */
+	uint8_t severity;	/* enum edid_severity */
+	const char *block;	/* part of the EDID the issue was found in */
+	int offset;		/* of the offending byte in the EDID, or -1 */
+	int value;		/* the value of a failed conformance rule */
+	char message[128];
+};
+
+struct edid_info {
+	const uint8_t *buf;	/* the buffer passed to edid_decode() */
+	unsigned size;		/* number of bytes decoded, 0 if not an EDID */
+	unsigned num_blocks;
+	int conformant;		/* 0 or 1 with EDID_DECODE_CHECK, else -1 */
+	unsigned truncated;
+	unsigned flags;		/* the EDID_DECODE_* flags of the decode */
+
+	struct edid_base base;
+
+	unsigned num_std_timings;
+	struct edid_std_timing std_timings[EDID_INFO_MAX_STD_TIMINGS];
+
+	unsigned num_timings;
+	struct edid_timing timings[EDID_INFO_MAX_TIMINGS];
+
+	/* extension[i] is EDID block i + 1 */
+	unsigned num_extensions;
+	struct edid_extension extensions[EDID_INFO_MAX_EXTENSIONS];
+
+	unsigned num_cta_blocks;
+	struct edid_cta_block cta_blocks[EDID_INFO_MAX_CTA_BLOCKS];
+
+	unsigned num_displayid_blocks;
+	struct edid_displayid_block displayid_blocks[EDID_INFO_MAX_DISPLAYID_BLOCKS];
+
+	struct edid_cta_caps cta;
+
+	/* all modes from all blocks, without duplicates, by pixel clock */
+	unsigned num_modes;
+	struct edid_mode modes[EDID_INFO_MAX_MODES];
+
+	/*
+	 * the range of the rates and the highest pixel clock of the
+	 * timings; a minimum above its maximum means no timing gave it
+	 */
+	unsigned min_vfreq_hz, max_vfreq_hz;
+	unsigned min_hfreq_hz, max_hfreq_hz;
+	unsigned max_pixclk_khz;
+
+	/*
+	 * warnings, and with EDID_DECODE_CHECK the conformance errors;
+	 * num_warnings and num_errors count all of them, even those that
+	 * did not fit in findings
+	 */
+	unsigned num_warnings, num_errors;
+	unsigned num_findings;
+	struct edid_finding findings[EDID_INFO_MAX_FINDINGS];
+};
+
+/*
+ * The identity and preferred timing of a display, as filled in by
+ * edid_summary() from the fields of the base block
+ */
+struct edid_summary {
+	char manufacturer[4];
+	uint16_t product;
+	uint32_t serial;
+	uint8_t week;			/* 0xff means year is a model year */
+	uint16_t year;
+	char name[14];			/* monitor name descriptor, or "" */
+	char serial_string[14];		/* serial number descriptor, or "" */
+	/*
+	 * the first detailed timing of the base block, or else of the first
+	 * CTA-861 extension; pixclk_khz is 0 if there is none
+	 */
+	struct edid_timing preferred;
+};
+
+/* Formats edid_emit() can write an edid_info in */
+enum edid_output {
+	EDID_OUTPUT_TIMINGS,	/* a modeline per detailed timing */
+	EDID_OUTPUT_FINDINGS,	/* a line per finding */
+	EDID_OUTPUT_JSON,	/* a single line JSON document */
+	/* a single line: the source, pass or fail, and the finding codes */
+	EDID_OUTPUT_CODES,
+	/*
+	 * the edid-decode report; the findings need their messages, so the
+	 * decode must not use EDID_DECODE_QUIET
+	 */
+	EDID_OUTPUT_TEXT,
+};
+
+/*
+ * Decode the len bytes of EDID at buf into *info. len is rounded down to
+ * whole 128 byte blocks. Returns 0 on success and -1 if buf does not
+ * hold an EDID.
+ */
+int edid_decode(const uint8_t *buf, size_t len, struct edid_info *info);
+
+/*
+ * As edid_decode(), but also write the decoded EDID to out in the
+ * EDID_OUTPUT_TEXT format. info and out may be NULL. With EDID_DECODE_CHECK, -2 is returned
+ * for an EDID that does not conform to the standards.
+ */
+int edid_decode_text(const uint8_t *buf, size_t len, struct edid_info *info,
+		     unsigned flags, FILE *out);
+
+/*
+ * As edid_decode_text() with EDID_DECODE_CHECK, but only check the
+ * conformance rules for the num_codes finding codes in codes. Rules
+ * that are not checked cannot make the EDID nonconformant. Warnings
+ * found while decoding are reported regardless.
+ */
+int edid_check(const uint8_t *buf, size_t len, struct edid_info *info,
+	       unsigned flags, FILE *out, const uint16_t *codes,
+	       unsigned num_codes);
+
+/*
+ * The video format with the given Video Identification Code, or NULL if
+ * the VIC is reserved. This is a lookup in a constant table.
+ */
+const struct edid_vic_mode *edid_vic_mode(unsigned vic);
+
+/*
+ * Compute the timing of a progressive width x height mode at refresh Hz
+ * with a CVT or GTF formula into *t. Recent results are cached, per
+ * thread. Returns 0 on success and -1 if the mode is out of range.
+ */
+int edid_calc_timing(unsigned width, unsigned height, unsigned refresh,
+		     enum edid_formula formula, struct edid_timing *t);
+
+/* edid_supports() flags */
+enum {
+	EDID_SUPPORTS_INTERLACED = 1 << 0,
+	EDID_SUPPORTS_YCBCR420 = 1 << 1,	/* in YCbCr 4:2:0 */
+};
+
+/* edid_supports() results */
+enum {
+	EDID_SUPPORTS_NONE,
+	EDID_SUPPORTS_MODE,	/* one of the modes of the EDID */
+	EDID_SUPPORTS_RANGE,	/* within the continuous frequency range limits */
+};
+
+/*
+ * The modes and the continuous frequency range limits of a decoded EDID,
+ * as indexed by edid_mode_index()
+ */
+struct edid_mode_index {
+	const struct edid_info *info;
+	/* info->modes hashed on size, refresh rate and interlacing */
+	uint64_t keys[2 * EDID_INFO_MAX_MODES];
+	uint16_t slots[2 * EDID_INFO_MAX_MODES];	/* index in modes + 1, or 0 */
+	/* the formulas of the range limits, in order of preference */
+	unsigned num_formulas;		/* 0 without continuous frequencies */
+	uint8_t formulas[2];		/* enum edid_formula */
+	uint16_t min_vfreq_hz, max_vfreq_hz;
+	uint32_t min_hfreq_hz, max_hfreq_hz;
+	uint32_t max_pixclk_khz;	/* 0 if not limited */
+	uint16_t max_hact;		/* 0 if not limited */
+};
+
+/*
+ * Index the modes and range limits of *info for edid_supports(). info
+ * must stay valid while idx is used. Returns 0 on success and -1 if
+ * info does not hold a decoded EDID.
+ */
+int edid_mode_index(const struct edid_info *info, struct edid_mode_index *idx);
+
+/*
+ * Tell if the display supports a width x height mode at refresh Hz, the
+ * field rate for interlaced modes, with the EDID_SUPPORTS_* flags. A mode
+ * is supported if it is one of the modes of the EDID with a refresh rate
+ * within 0.5 Hz, or else if the display has continuous frequencies and
+ * the timing computed with its range limits formula is within the range
+ * limits. Only progressive RGB modes can be supported through the range
+ * limits. If t is not NULL the timing is stored there. Returns one of
+ * EDID_SUPPORTS_*.
+ */
+int edid_supports(const struct edid_mode_index *idx, unsigned width,
+		  unsigned height, unsigned refresh, unsigned flags,
+		  struct edid_timing *t);
+
+/* edid_source_caps.formats and edid_link_mode.format */
+enum {
+	EDID_FORMAT_RGB = 1 << 0,
+	EDID_FORMAT_YCBCR444 = 1 << 1,
+	EDID_FORMAT_YCBCR422 = 1 << 2,
+	EDID_FORMAT_YCBCR420 = 1 << 3,
+};
+
+/* What the source side of the link can send, for edid_negotiate() */
+struct edid_source_caps {
+	uint16_t max_tmds_mhz;		/* TMDS character rate, 0 without TMDS */
+	uint8_t max_frl_rate;		/* as Max_FRL_Rate, 0 without FRL */
+	uint8_t dsc;			/* can send DSC 1.2a over FRL */
+	uint8_t formats;		/* EDID_FORMAT_* */
+	uint8_t max_bpc;		/* 8, 10, 12 or 16 */
+	uint32_t max_pixclk_khz;	/* 0 if not limited */
+};
+
+/* edid_link_mode.link */
+enum edid_link {
+	EDID_LINK_NONE,		/* not an HDMI sink: only pixel clocks checked */
+	EDID_LINK_TMDS,
+	EDID_LINK_FRL,
+};
+
+/* A mode as edid_negotiate() would send it */
+struct edid_link_mode {
+	const struct edid_mode *mode;	/* in edid_info.modes */
+	uint8_t format;			/* one EDID_FORMAT_* bit */
+	uint8_t bpc;
+	uint8_t link;			/* enum edid_link */
+	uint8_t frl_rate;		/* as Max_FRL_Rate, 0 for TMDS */
+	uint8_t dsc;			/* compressed with DSC */
+	uint32_t tmds_khz;		/* TMDS character rate, 0 if not TMDS */
+	/*
+	 * the link bandwidth the mode needs: TMDS bits for TMDS, else the
+	 * (compressed) video data rate
+	 */
+	uint32_t bandwidth_mbps;
+};
+
+/*
+ * Find out how each mode of *info can best be sent by a source with the
+ * capabilities *src, within the limits of the display: its HDMI and HDMI
+ * Forum TMDS, FRL and DSC capabilities, its deep color and YCbCr formats
+ * and the maximum pixel clock of its range limits. For each mode the
+ * format with the least chroma subsampling, and then the highest bpc,
+ * that fits is picked; DSC is only used if no uncompressed format fits.
+ * Up to max_modes of the modes that can be sent are stored in modes,
+ * best first: by resolution, refresh rate, bpc and chroma subsampling.
+ * Returns the number of modes stored.
+ */
+unsigned edid_negotiate(const struct edid_info *info,
+			const struct edid_source_caps *src,
+			struct edid_link_mode *modes, unsigned max_modes);
+
+/*
+ * Fill *sum from the len bytes of EDID at buf without decoding the rest:
+ * only the identity fields and the descriptors of the base block are
+ * read, and the start of the first extension if the base block has no
+ * detailed timing. The EDID is not checked, not even its checksum.
+ * Returns 0 on success and -1 if buf does not hold an EDID.
+ */
+int edid_summary(const uint8_t *buf, size_t len, struct edid_summary *sum);
+
+/*
+ * An index of the data blocks of all CTA-861 extensions, as built by
+ * edid_cta_index(). The payload of blocks[i] is at
+ * buf[blocks[i].offset .. blocks[i].offset + blocks[i].length).
+ */
+struct edid_cta_index {
+	const uint8_t *buf;
+	unsigned num_blocks;
+	int truncated;		/* more than EDID_INFO_MAX_CTA_BLOCKS blocks */
+	struct edid_cta_block blocks[EDID_INFO_MAX_CTA_BLOCKS];
+};
+
+/*
+ * Index the CTA-861 data blocks of the len bytes of EDID at buf in one
+ * pass over their headers, without decoding any payload or checking
+ * the EDID. Data blocks that overrun their data block collection are
+ * left out. Returns 0 on success and -1 if buf does not hold an EDID.
+ */
+int edid_cta_index(const uint8_t *buf, size_t len, struct edid_cta_index *idx);
+
+/*
+ * Return the first of the num_blocks data blocks with the given tag, or
+ * NULL. ext_tag is only compared for extended tag blocks (tag 7), and
+ * oui only if it is not 0. Works on edid_cta_index.blocks as well as on
+ * edid_info.cta_blocks.
+ */
+const struct edid_cta_block *
+edid_cta_find(const struct edid_cta_block *blocks, unsigned num_blocks,
+	      unsigned tag, unsigned ext_tag, uint32_t oui);
+
+/* The HDR Static Metadata Data Block, or NULL */
+const struct edid_cta_block *
+edid_cta_find_hdr_static(const struct edid_cta_index *idx);
+
+/*
+ * The HDMI Forum Sink Capability Data Block, or else the HDMI Forum
+ * Vendor-Specific Data Block that carries the same fields, or NULL
+ */
+const struct edid_cta_block *
+edid_cta_find_hf_scdb(const struct edid_cta_index *idx);
+
+/*
+ * Fill *caps from the HDR Static Metadata, HDR Dynamic Metadata, HDR10+
+ * and Colorimetry Data Blocks of the len bytes of EDID at buf. Only the
+ * headers of the CTA-861 data blocks and the payloads of these blocks
+ * are read; the EDID is not checked. The full decode fills the same
+ * struct in edid_info.cta.hdr. Returns 0 on success and -1 if buf does
+ * not hold an EDID.
+ */
+int edid_hdr_probe(const uint8_t *buf, size_t len, struct edid_hdr_caps *caps);
+
+/*
+ * Write a decoded EDID to f in the given format. source names the input the EDID came from and may be NULL. info->buf
+ * must still be valid. An info that failed to decode is written as an
+ * error document in the JSON format, and not at all in the others.
+ */
+void edid_emit(FILE *f, const struct edid_info *info, enum edid_output output,
+	       const char *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif